@@ -0,0 +1,166 @@
+// Times the FIFO queue's range operations against pushing and popping one element at a time, for transfers shaped
+// like the ones the emulator makes: a CD-ROM sector through the data FIFO, MDEC output blocks read back in DMA-sized
+// chunks, and CD audio frames read by the SPU in mixing-sized blocks.
+
+#include "common/fifo_queue.h"
+#include "common/timer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+template<typename Callback>
+double TimePerIteration(u32 iterations, const Callback& callback)
+{
+  Common::Timer timer;
+  for (u32 i = 0; i < iterations; i++)
+    callback();
+
+  return timer.GetTimeNanoseconds() / static_cast<double>(iterations);
+}
+
+// Folds part of each output buffer into a checksum which is printed at the end, so the copies can't be optimized away.
+u32 s_checksum = 0;
+
+template<typename T>
+void Consume(const T* data, u32 count)
+{
+  for (u32 i = 0; i < count; i++)
+    s_checksum += static_cast<u32>(data[i]);
+}
+
+void BenchmarkCDROMSector()
+{
+  static constexpr u32 SECTOR_SIZE = 2340;
+  static constexpr u32 ITERATIONS = 20000;
+
+  static HeapFIFOQueue<u8, SECTOR_SIZE> fifo;
+  std::vector<u8> sector(SECTOR_SIZE);
+  std::vector<u8> out(SECTOR_SIZE);
+  for (u32 i = 0; i < SECTOR_SIZE; i++)
+    sector[i] = static_cast<u8>(i);
+
+  const double element_ns = TimePerIteration(ITERATIONS, [&]() {
+    for (u32 i = 0; i < SECTOR_SIZE; i++)
+      fifo.Push(sector[i]);
+    for (u32 i = 0; i < SECTOR_SIZE; i++)
+      out[i] = fifo.Pop();
+    Consume(out.data(), 1);
+  });
+  const double range_ns = TimePerIteration(ITERATIONS, [&]() {
+    fifo.PushRange(sector.data(), SECTOR_SIZE);
+    fifo.PopRange(out.data(), SECTOR_SIZE);
+    Consume(out.data(), 1);
+  });
+
+  std::printf("CD-ROM sector (%u bytes): %.0f ns element-wise, %.0f ns with ranges\n", SECTOR_SIZE, element_ns,
+              range_ns);
+}
+
+void BenchmarkMDECOutput()
+{
+  static constexpr u32 BLOCK_WORDS = 96;
+  static constexpr u32 DMA_WORDS = 32;
+  static constexpr u32 ITERATIONS = 200000;
+
+  // The queue starts part-way through so that reads wrap around the end of the buffer.
+  static InlineFIFOQueue<u32, 192> fifo;
+  u32 block[BLOCK_WORDS];
+  u32 out[DMA_WORDS];
+  for (u32 i = 0; i < BLOCK_WORDS; i++)
+    block[i] = i;
+  fifo.PushRange(block, 64);
+  fifo.Remove(64);
+
+  const double element_ns = TimePerIteration(ITERATIONS, [&]() {
+    for (u32 i = 0; i < BLOCK_WORDS; i++)
+      fifo.Push(block[i]);
+    for (u32 chunk = 0; chunk < BLOCK_WORDS / DMA_WORDS; chunk++)
+    {
+      for (u32 i = 0; i < DMA_WORDS; i++)
+        out[i] = fifo.Pop();
+      Consume(out, 1);
+    }
+  });
+  const double range_ns = TimePerIteration(ITERATIONS, [&]() {
+    fifo.PushRange(block, BLOCK_WORDS);
+    for (u32 chunk = 0; chunk < BLOCK_WORDS / DMA_WORDS; chunk++)
+    {
+      fifo.PopRange(out, DMA_WORDS);
+      Consume(out, 1);
+    }
+  });
+
+  std::printf("MDEC block (%u words) in %u-word DMA reads: %.0f ns element-wise, %.0f ns with ranges\n", BLOCK_WORDS,
+              DMA_WORDS, element_ns, range_ns);
+}
+
+void BenchmarkCDAudio()
+{
+  static constexpr u32 SECTOR_SAMPLES = 1176;
+  static constexpr u32 BLOCK_FRAMES = 32;
+  static constexpr u32 ITERATIONS = 20000;
+
+  static InlineFIFOQueue<s16, 44100 * 2> fifo;
+  std::vector<s16> sector(SECTOR_SAMPLES);
+  s16 left[BLOCK_FRAMES];
+  s16 right[BLOCK_FRAMES];
+  for (u32 i = 0; i < SECTOR_SAMPLES; i++)
+    sector[i] = static_cast<s16>(i);
+
+  const double element_ns = TimePerIteration(ITERATIONS, [&]() {
+    for (u32 i = 0; i < SECTOR_SAMPLES; i++)
+      fifo.Push(sector[i]);
+    while (!fifo.IsEmpty())
+    {
+      const u32 frames = std::min<u32>(BLOCK_FRAMES, fifo.GetSize() / 2);
+      for (u32 i = 0; i < frames; i++)
+      {
+        left[i] = fifo.Pop();
+        right[i] = fifo.Pop();
+      }
+      Consume(left, 1);
+      Consume(right, 1);
+    }
+  });
+  const double range_ns = TimePerIteration(ITERATIONS, [&]() {
+    fifo.PushRange(sector.data(), SECTOR_SAMPLES);
+    while (!fifo.IsEmpty())
+    {
+      const u32 frames = std::min<u32>(BLOCK_FRAMES, fifo.GetSize() / 2);
+      const s16* span0;
+      const s16* span1;
+      u32 span0_size, span1_size;
+      fifo.PeekSpans(frames * 2, &span0, &span0_size, &span1, &span1_size);
+      for (u32 i = 0; i < span0_size; i += 2)
+      {
+        left[i / 2] = span0[i];
+        right[i / 2] = span0[i + 1];
+      }
+      for (u32 i = 0; i < span1_size; i += 2)
+      {
+        left[(span0_size + i) / 2] = span1[i];
+        right[(span0_size + i) / 2] = span1[i + 1];
+      }
+      fifo.Remove(frames * 2);
+      Consume(left, 1);
+      Consume(right, 1);
+    }
+  });
+
+  std::printf("CD audio sector (%u samples) in %u-frame blocks: %.0f ns element-wise, %.0f ns with spans\n",
+              SECTOR_SAMPLES, BLOCK_FRAMES, element_ns, range_ns);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  BenchmarkCDROMSector();
+  BenchmarkMDECOutput();
+  BenchmarkCDAudio();
+  std::printf("Checksum: %u\n", s_checksum);
+  return EXIT_SUCCESS;
+}
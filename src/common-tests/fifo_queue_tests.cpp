@@ -0,0 +1,160 @@
+// Checks the FIFO queue against std::deque with a random mix of range pushes and pops, peeks, in-place pushes through
+// the back pointer, and pushes from another queue. The capacity isn't a power of two, and the transfers are random
+// lengths, so the head and tail wrap around the end of the buffer at every possible offset.
+
+#include "common/fifo_queue.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr u32 CAPACITY = 1000;
+constexpr u32 OTHER_CAPACITY = 37;
+constexpr u32 NUM_OPERATIONS = 200000;
+
+bool Fail(u32 operation, const char* message)
+{
+  std::fprintf(stderr, "Operation %u: %s\n", operation, message);
+  return false;
+}
+
+bool Run()
+{
+  std::mt19937 rng(1);
+  InlineFIFOQueue<u16, CAPACITY> queue;
+  std::deque<u16> expected;
+  std::vector<u16> buffer;
+  u16 next_value = 0;
+
+  for (u32 operation = 0; operation < NUM_OPERATIONS; operation++)
+  {
+    switch (rng() % 6)
+    {
+      case 0:
+      {
+        const u32 count = rng() % (queue.GetSpace() + 1);
+        buffer.resize(count);
+        for (u16& value : buffer)
+        {
+          value = next_value++;
+          expected.push_back(value);
+        }
+        queue.PushRange(buffer.data(), count);
+      }
+      break;
+
+      case 1:
+      {
+        const u32 count = rng() % (queue.GetSize() + 1);
+        buffer.resize(count);
+        queue.PopRange(buffer.data(), count);
+        for (u32 i = 0; i < count; i++)
+        {
+          if (buffer[i] != expected.front())
+            return Fail(operation, "PopRange() returned the wrong value");
+
+          expected.pop_front();
+        }
+      }
+      break;
+
+      case 2:
+      {
+        const u32 count = rng() % (queue.GetSize() + 1);
+        buffer.resize(count);
+        queue.PeekRange(buffer.data(), count);
+        if (!std::equal(buffer.begin(), buffer.end(), expected.begin()))
+          return Fail(operation, "PeekRange() returned the wrong value");
+
+        const u16* span0;
+        const u16* span1;
+        u32 span0_size, span1_size;
+        queue.PeekSpans(count, &span0, &span0_size, &span1, &span1_size);
+        if ((span0_size + span1_size) != count || (span1_size > 0 && span0_size != queue.GetContiguousSize()) ||
+            !std::equal(span0, span0 + span0_size, expected.begin()) ||
+            !std::equal(span1, span1 + span1_size, expected.begin() + span0_size))
+        {
+          return Fail(operation, "PeekSpans() returned the wrong spans");
+        }
+
+        if (count > 0 && queue.Peek(count - 1) != expected[count - 1])
+          return Fail(operation, "Peek() returned the wrong value");
+      }
+      break;
+
+      case 3:
+      {
+        const u32 count = rng() % (queue.GetContiguousSpace() + 1);
+        u16* back = queue.GetBackPointer();
+        for (u32 i = 0; i < count; i++)
+        {
+          back[i] = next_value;
+          expected.push_back(next_value++);
+        }
+        queue.CommitPush(count);
+      }
+      break;
+
+      case 4:
+      {
+        InlineFIFOQueue<u16, OTHER_CAPACITY> other_queue;
+        const u32 count = rng() % (OTHER_CAPACITY + 1);
+        for (u32 i = 0; i < count; i++)
+          other_queue.Push(static_cast<u16>(next_value + i));
+
+        const u32 moved = std::min(count, queue.GetSpace());
+        queue.PushFromQueue(&other_queue);
+        for (u32 i = 0; i < moved; i++)
+          expected.push_back(next_value++);
+        next_value += count - moved;
+
+        if (other_queue.GetSize() != (count - moved))
+          return Fail(operation, "PushFromQueue() moved the wrong number of elements");
+      }
+      break;
+
+      case 5:
+      {
+        const u32 count = rng() % (queue.GetSize() + 1);
+        for (u32 i = 0; i < count; i++)
+        {
+          if (queue.Peek() != expected.front() || queue.Pop() != expected.front())
+            return Fail(operation, "Pop() returned the wrong value");
+
+          expected.pop_front();
+        }
+      }
+      break;
+    }
+
+    if (queue.GetSize() != expected.size() || queue.GetSpace() != (CAPACITY - expected.size()) ||
+        queue.IsEmpty() != expected.empty() || queue.IsFull() != (expected.size() == CAPACITY))
+    {
+      return Fail(operation, "size doesn't match");
+    }
+
+    if (queue.GetContiguousSpace() > queue.GetSpace() || (queue.IsFull() && queue.GetContiguousSpace() != 0) ||
+        queue.GetContiguousSize() > queue.GetSize() || (!queue.IsEmpty() && queue.GetContiguousSize() == 0))
+    {
+      return Fail(operation, "contiguous size or space is out of range");
+    }
+  }
+
+  return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  if (!Run())
+  {
+    std::fprintf(stderr, "FAILED\n");
+    return EXIT_FAILURE;
+  }
+
+  std::printf("FIFO queue matches std::deque for %u operations\n", NUM_OPERATIONS);
+  return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #include "cd_image.h"
 #include "assert.h"
 #include "log.h"
+#include <algorithm>
 #include <array>
 Log_SetChannel(CDImage);
 
@@ -14,7 +15,7 @@ u32 CDImage::GetBytesPerSector(TrackMode mode)
   return sizes[static_cast<u32>(mode)];
 }
 
-std::unique_ptr<CDImage> CDImage::Open(const char* filename)
+std::unique_ptr<CDImage> CDImage::Open(const char* filename, const OpenOptions& options)
 {
   const char* extension = std::strrchr(filename, '.');
   if (!extension)
@@ -34,7 +35,7 @@ std::unique_ptr<CDImage> CDImage::Open(const char* filename)
   else if (CASE_COMPARE(extension, ".bin") == 0 || CASE_COMPARE(extension, ".img") == 0)
     return OpenBinImage(filename);
   else if (CASE_COMPARE(extension, ".chd") == 0)
-    return OpenCHDImage(filename);
+    return OpenCHDImage(filename, options);
 
 #undef CASE_COMPARE
 
@@ -54,6 +55,26 @@ CDImage::Position CDImage::GetTrackStartMSFPosition(u8 track) const
   return Position::FromLBA(m_tracks[track - 1].start_lba);
 }
 
+bool CDImage::GetTrackDumpRange(u8 track, LBA* start_lba, u32* sector_count) const
+{
+  bool found = false;
+  LBA start = 0;
+  LBA end = 0;
+  for (const Index& index : m_indices)
+  {
+    if (index.track_number != track || index.file_sector_size == 0 || (index.is_pregap && track == 1))
+      continue;
+
+    start = found ? std::min(start, index.start_lba_on_disc) : index.start_lba_on_disc;
+    end = found ? std::max(end, index.start_lba_on_disc + index.length) : (index.start_lba_on_disc + index.length);
+    found = true;
+  }
+
+  *start_lba = start;
+  *sector_count = end - start;
+  return found;
+}
+
 bool CDImage::Seek(LBA lba)
 {
   const Index* new_index;
@@ -178,6 +199,36 @@ bool CDImage::ReadRawSector(void* buffer)
   return true;
 }
 
+const u8* CDImage::ReadRawSectorPointer(void* buffer)
+{
+  static constexpr std::array<u8, RAW_SECTOR_SIZE> silence = {};
+
+  if (m_position_in_index == m_current_index->length)
+  {
+    if (!Seek(m_position_on_disc))
+      return nullptr;
+  }
+
+  const u8* sector_ptr = nullptr;
+  if (m_current_index->file_sector_size == RAW_SECTOR_SIZE)
+    sector_ptr = GetSectorPointerFromIndex(*m_current_index, m_position_in_index);
+  else if (m_current_index->file_sector_size == 0)
+    sector_ptr = silence.data(); // implicit pregap
+
+  if (!sector_ptr)
+    return ReadRawSector(buffer) ? static_cast<const u8*>(buffer) : nullptr;
+
+  m_position_on_disc++;
+  m_position_in_index++;
+  m_position_in_track++;
+  return sector_ptr;
+}
+
+bool CDImage::HasSectorPointers() const
+{
+  return false;
+}
+
 bool CDImage::ReadSubChannelQ(SubChannelQ* subq)
 {
   // handle case where we're at the end of the track/index
@@ -189,6 +240,23 @@ bool CDImage::ReadSubChannelQ(SubChannelQ* subq)
   return true;
 }
 
+void CDImage::SetReadSpeed(u32 sectors_per_second) {}
+
+const u8* CDImage::GetSectorPointerFromIndex(const Index& index, LBA lba_in_index)
+{
+  return nullptr;
+}
+
+void CDImage::CopyLayout(const CDImage& image)
+{
+  m_filename = image.m_filename;
+  m_lba_count = image.m_lba_count;
+
+  // The control fields aren't assignable, so copy-construct rather than copy-assign.
+  m_tracks = std::vector<Track>(image.m_tracks);
+  m_indices = std::vector<Index>(image.m_indices);
+}
+
 const CDImage::Index* CDImage::GetIndexForDiscPosition(LBA pos)
 {
   for (const Index& index : m_indices)
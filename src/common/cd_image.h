@@ -155,11 +155,28 @@ public:
   // Helper functions.
   static u32 GetBytesPerSector(TrackMode mode);
 
+  // Options for opening a disc image, which only CHD images use at the moment.
+  struct OpenOptions
+  {
+    // Number of decompressed hunks cached.
+    u32 chd_cache_hunk_count = 16;
+
+    // Number of threads decompressing hunks ahead of the reader. Zero disables decompressing ahead.
+    u32 chd_decompression_thread_count = 1;
+  };
+
   // Opening disc image.
-  static std::unique_ptr<CDImage> Open(const char* filename);
+  static std::unique_ptr<CDImage> Open(const char* filename, const OpenOptions& options);
   static std::unique_ptr<CDImage> OpenBinImage(const char* filename);
   static std::unique_ptr<CDImage> OpenCueSheetImage(const char* filename);
-  static std::unique_ptr<CDImage> OpenCHDImage(const char* filename);
+  static std::unique_ptr<CDImage> OpenCHDImage(const char* filename, const OpenOptions& options);
+
+  // Wraps an image so that sectors are read ahead of the drive on a worker thread. Images which can already return
+  // every sector without copying are returned as-is.
+  static std::unique_ptr<CDImage> CreatePrefetchImage(std::unique_ptr<CDImage> image);
+
+  // Wraps an image so that the whole disc is loaded into memory on a worker thread, optionally compressed.
+  static std::unique_ptr<CDImage> CreatePreloadImage(std::unique_ptr<CDImage> image, bool compress);
 
   // Accessors.
   const std::string& GetFileName() const { return m_filename; }
@@ -174,6 +191,10 @@ public:
   LBA GetTrackStartPosition(u8 track) const;
   Position GetTrackStartMSFPosition(u8 track) const;
 
+  // Gets the sectors which make up a track as it is laid out in a dumped track file. This includes the pregap for all
+  // tracks except the first, when it's present in the image.
+  bool GetTrackDumpRange(u8 track, LBA* start_lba, u32* sector_count) const;
+
   // Seek to data LBA.
   bool Seek(LBA lba);
 
@@ -192,9 +213,20 @@ public:
   // Read a single raw sector from the current LBA.
   bool ReadRawSector(void* buffer);
 
+  // Read a single raw sector from the current LBA without copying it, if the image holds it in memory. Otherwise it
+  // is read into buffer. Returns a pointer to the sector, or nullptr on failure, which is valid until the next read.
+  const u8* ReadRawSectorPointer(void* buffer);
+
+  // Returns true if ReadRawSectorPointer() never has to copy, e.g. because the image files are memory-mapped. Doesn't
+  // touch any sectors, so it can be called without disturbing read-ahead.
+  virtual bool HasSectorPointers() const;
+
   // Reads sub-channel Q for the current LBA.
   virtual bool ReadSubChannelQ(SubChannelQ* subq);
 
+  // Tells images which read ahead how quickly the drive is reading sectors.
+  virtual void SetReadSpeed(u32 sectors_per_second);
+
 protected:
   struct Track
   {
@@ -224,6 +256,12 @@ protected:
   // Reads a single sector from an index.
   virtual bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) = 0;
 
+  // Returns a pointer to a sector in an index if it's held in memory, otherwise nullptr.
+  virtual const u8* GetSectorPointerFromIndex(const Index& index, LBA lba_in_index);
+
+  /// Copies the track and index layout from another image, for images which wrap another.
+  void CopyLayout(const CDImage& image);
+
   const Index* GetIndexForDiscPosition(LBA pos);
   const Index* GetIndexForTrackPosition(u32 track_number, LBA track_pos);
 
@@ -2,6 +2,8 @@
 #include "cd_subchannel_replacement.h"
 #include "file_system.h"
 #include "log.h"
+#include "memory_mapped_file.h"
+#include <cstring>
 Log_SetChannel(CDImageBin);
 
 class CDImageBin : public CDImage
@@ -13,11 +15,15 @@ public:
   bool Open(const char* filename);
 
   bool ReadSubChannelQ(SubChannelQ* subq) override;
+  bool HasSectorPointers() const override;
 
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+  const u8* GetSectorPointerFromIndex(const Index& index, LBA lba_in_index) override;
 
 private:
+  // Sectors are read straight from the mapping when the file can be mapped, otherwise with stdio.
+  std::unique_ptr<MemoryMappedFile> m_mapping;
   std::FILE* m_fp = nullptr;
   u64 m_file_position = 0;
 
@@ -46,19 +52,31 @@ CDImageBin::~CDImageBin()
 bool CDImageBin::Open(const char* filename)
 {
   m_filename = filename;
-  m_fp = FileSystem::OpenCFile(filename, "rb");
-  if (!m_fp)
+  m_mapping = MemoryMappedFile::Open(filename);
+  if (!m_mapping)
   {
-    Log_ErrorPrintf("Failed to open binfile '%s'", filename);
-    return false;
+    m_fp = FileSystem::OpenCFile(filename, "rb");
+    if (!m_fp)
+    {
+      Log_ErrorPrintf("Failed to open binfile '%s'", filename);
+      return false;
+    }
   }
 
   const u32 track_sector_size = RAW_SECTOR_SIZE;
 
   // determine the length from the file
-  std::fseek(m_fp, 0, SEEK_END);
-  const u32 file_size = static_cast<u32>(std::ftell(m_fp));
-  std::fseek(m_fp, 0, SEEK_SET);
+  u32 file_size;
+  if (m_mapping)
+  {
+    file_size = static_cast<u32>(m_mapping->GetSize());
+  }
+  else
+  {
+    std::fseek(m_fp, 0, SEEK_END);
+    file_size = static_cast<u32>(std::ftell(m_fp));
+    std::fseek(m_fp, 0, SEEK_SET);
+  }
 
   m_lba_count = file_size / track_sector_size;
 
@@ -113,6 +131,16 @@ bool CDImageBin::ReadSubChannelQ(SubChannelQ* subq)
 
 bool CDImageBin::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
 {
+  if (m_mapping)
+  {
+    const u8* sector_ptr = GetSectorPointerFromIndex(index, lba_in_index);
+    if (!sector_ptr)
+      return false;
+
+    std::memcpy(buffer, sector_ptr, index.file_sector_size);
+    return true;
+  }
+
   const u64 file_position = index.file_offset + (static_cast<u64>(lba_in_index) * index.file_sector_size);
   if (m_file_position != file_position)
   {
@@ -132,6 +160,37 @@ bool CDImageBin::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
   return true;
 }
 
+const u8* CDImageBin::GetSectorPointerFromIndex(const Index& index, LBA lba_in_index)
+{
+  if (!m_mapping)
+    return nullptr;
+
+  const u64 file_position = index.file_offset + (static_cast<u64>(lba_in_index) * index.file_sector_size);
+  if ((file_position + index.file_sector_size) > m_mapping->GetSize())
+    return nullptr;
+
+  m_mapping->AdviseRead(file_position, index.file_sector_size);
+  return m_mapping->GetData() + file_position;
+}
+
+bool CDImageBin::HasSectorPointers() const
+{
+  if (!m_mapping)
+    return false;
+
+  for (const Index& index : m_indices)
+  {
+    if (index.file_sector_size == 0 || index.length == 0)
+      continue;
+
+    const u64 end_position = index.file_offset + (static_cast<u64>(index.length) * index.file_sector_size);
+    if (index.file_sector_size != RAW_SECTOR_SIZE || end_position > m_mapping->GetSize())
+      return false;
+  }
+
+  return true;
+}
+
 std::unique_ptr<CDImage> CDImage::OpenBinImage(const char* filename)
 {
   std::unique_ptr<CDImageBin> image = std::make_unique<CDImageBin>();
@@ -9,11 +9,16 @@
 #include "file_system.h"
 #include "libchdr/chd.h"
 #include "log.h"
+#include "timer.h"
 #include <algorithm>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <thread>
 Log_SetChannel(CDImageCHD);
 
 static std::optional<CDImage::TrackMode> ParseTrackModeString(const char* str)
@@ -44,7 +49,7 @@ public:
   CDImageCHD();
   ~CDImageCHD() override;
 
-  bool Open(const char* filename);
+  bool Open(const char* filename, const OpenOptions& options);
 
   bool ReadSubChannelQ(SubChannelQ* subq) override;
 
@@ -55,16 +60,62 @@ private:
   enum : u32
   {
     CHD_SECTOR_DATA_SIZE = 2352 + 96,
+    INVALID_HUNK_INDEX = static_cast<u32>(-1),
+
+    // Hunks decompressed ahead of the current one, per decompression thread.
+    PREFETCH_HUNKS_PER_THREAD = 2,
+  };
+
+  enum class HunkState : u8
+  {
+    Empty,
+    Pending,
+    Ready
+  };
+
+  struct CachedHunk
+  {
+    u32 hunk_index = INVALID_HUNK_INDEX;
+    HunkState state = HunkState::Empty;
+    u64 last_used = 0;
+    std::vector<u8> data;
   };
 
-  bool ReadHunk(u32 hunk_index);
+  // Returns the decompressed hunk, reading it now if it isn't cached. Only called from one thread at a time, which
+  // is also the only thread which evicts hunks, so the returned hunk stays valid until the next call.
+  const CachedHunk* GetHunk(u32 hunk_index);
+  CachedHunk* FindCachedHunk(u32 hunk_index);
+  CachedHunk* AllocateCachedHunk(u32 hunk_index);
+  void QueuePrefetch(u32 hunk_index);
+
+  void StartDecompressionThreads(const char* filename, u32 thread_count);
+  void StopDecompressionThreads();
+  void DecompressionThreadEntryPoint(chd_file* chd);
 
   chd_file* m_chd = nullptr;
   u32 m_hunk_size = 0;
   u32 m_sectors_per_hunk = 0;
-
-  std::vector<u8> m_hunk_buffer;
-  u32 m_current_hunk_index = static_cast<u32>(-1);
+  u32 m_hunk_count = 0;
+
+  // LRU cache of decompressed hunks. Pending hunks are owned by a decompression thread until they're ready.
+  std::vector<CachedHunk> m_cache;
+  u64 m_cache_counter = 0;
+  u32 m_last_hunk_index = INVALID_HUNK_INDEX;
+  u32 m_prefetch_hunk_count = 0;
+
+  // Each decompression thread has its own handle, since libchdr's aren't thread-safe.
+  std::vector<std::thread> m_decompression_threads;
+  std::vector<chd_file*> m_decompression_chds;
+  std::deque<CachedHunk*> m_decompression_queue;
+  std::mutex m_cache_mutex;
+  std::condition_variable m_queue_cv;
+  std::condition_variable m_hunk_ready_cv;
+  bool m_decompression_threads_shutdown = false;
+
+  u32 m_hit_count = 0;
+  u32 m_miss_count = 0;
+  u32 m_decompressed_hunk_count = 0;
+  double m_decompression_time = 0.0;
 
   CDSubChannelReplacement m_sbi;
 };
@@ -73,11 +124,21 @@ CDImageCHD::CDImageCHD() = default;
 
 CDImageCHD::~CDImageCHD()
 {
+  StopDecompressionThreads();
+
+  if (m_decompressed_hunk_count > 0)
+  {
+    const u32 lookup_count = m_hit_count + m_miss_count;
+    Log_InfoPrintf("CHD cache: %u lookups, %.1f%% hit rate, %u hunks decompressed, %.3f ms per sector",
+                   lookup_count, (lookup_count > 0) ? (100.0 * m_hit_count / lookup_count) : 0.0,
+                   m_decompressed_hunk_count, m_decompression_time / (m_decompressed_hunk_count * m_sectors_per_hunk));
+  }
+
   if (m_chd)
     chd_close(m_chd);
 }
 
-bool CDImageCHD::Open(const char* filename)
+bool CDImageCHD::Open(const char* filename, const OpenOptions& options)
 {
   chd_error err = chd_open(filename, CHD_OPEN_READ, nullptr, &m_chd);
   if (err != CHDERR_NONE)
@@ -95,7 +156,7 @@ bool CDImageCHD::Open(const char* filename)
   }
 
   m_sectors_per_hunk = m_hunk_size / CHD_SECTOR_DATA_SIZE;
-  m_hunk_buffer.resize(m_hunk_size);
+  m_hunk_count = header->totalhunks;
   m_filename = filename;
 
   u32 disc_lba = 0;
@@ -229,6 +290,16 @@ bool CDImageCHD::Open(const char* filename)
 
   m_sbi.LoadSBI(FileSystem::ReplaceExtension(filename, "sbi").c_str());
 
+  // Hunks waiting for a decompression thread can't be evicted, so make sure there's always room for the current hunk.
+  const u32 thread_count = options.chd_decompression_thread_count;
+  m_prefetch_hunk_count = thread_count * PREFETCH_HUNKS_PER_THREAD;
+  m_cache.resize(std::max(std::max<u32>(options.chd_cache_hunk_count, 1), m_prefetch_hunk_count + thread_count + 2));
+  for (CachedHunk& hunk : m_cache)
+    hunk.data.resize(m_hunk_size);
+
+  if (m_prefetch_hunk_count > 0)
+    StartDecompressionThreads(filename, thread_count);
+
   return Seek(1, Position{0, 0, 0});
 }
 
@@ -289,38 +360,227 @@ bool CDImageCHD::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_i
   const u32 hunk_offset = static_cast<u32>((disc_frame % m_sectors_per_hunk) * CHD_SECTOR_DATA_SIZE);
   DebugAssert((m_hunk_size - hunk_offset) >= CHD_SECTOR_DATA_SIZE);
 
-  if (m_current_hunk_index != hunk_index && !ReadHunk(hunk_index))
+  const CachedHunk* hunk = GetHunk(hunk_index);
+  if (!hunk)
     return false;
 
   // Audio data is in big-endian, so we have to swap it for little endian hosts...
   if (index.mode == TrackMode::Audio)
-    CopyAndSwap(buffer, &m_hunk_buffer[hunk_offset], RAW_SECTOR_SIZE);
+    CopyAndSwap(buffer, &hunk->data[hunk_offset], RAW_SECTOR_SIZE);
   else
-    std::memcpy(buffer, &m_hunk_buffer[hunk_offset], RAW_SECTOR_SIZE);
+    std::memcpy(buffer, &hunk->data[hunk_offset], RAW_SECTOR_SIZE);
 
   return true;
 }
 
-bool CDImageCHD::ReadHunk(u32 hunk_index)
+const CDImageCHD::CachedHunk* CDImageCHD::GetHunk(u32 hunk_index)
 {
-  const chd_error err = chd_read(m_chd, hunk_index, m_hunk_buffer.data());
-  if (err != CHDERR_NONE)
+  std::unique_lock<std::mutex> lock(m_cache_mutex);
+
+  CachedHunk* hunk = FindCachedHunk(hunk_index);
+  if (hunk && hunk->state == HunkState::Pending)
   {
-    Log_ErrorPrintf("chd_read(%u) failed: %s", hunk_index, chd_error_string(err));
+    // If no thread has started on it yet, it's quicker to do it here. Otherwise wait for the thread to finish.
+    auto iter = std::find(m_decompression_queue.begin(), m_decompression_queue.end(), hunk);
+    if (iter != m_decompression_queue.end())
+    {
+      m_decompression_queue.erase(iter);
+      hunk->hunk_index = INVALID_HUNK_INDEX;
+      hunk->state = HunkState::Empty;
+    }
+    else
+    {
+      m_hunk_ready_cv.wait(lock, [hunk]() { return hunk->state != HunkState::Pending; });
+    }
+  }
 
-    // data might have been partially written
-    m_current_hunk_index = static_cast<u32>(-1);
-    return false;
+  if (hunk && hunk->state == HunkState::Ready)
+  {
+    m_hit_count++;
   }
+  else
+  {
+    // Not cached, or the prefetch failed, so decompress it on this thread. Nothing else touches hunks which aren't
+    // queued, so the lock isn't needed while decompressing.
+    m_miss_count++;
+    hunk = AllocateCachedHunk(hunk_index);
+
+    lock.unlock();
+    Common::Timer timer;
+    const chd_error err = chd_read(m_chd, hunk_index, hunk->data.data());
+    const double decompression_time = timer.GetTimeMilliseconds();
+    lock.lock();
+
+    if (err != CHDERR_NONE)
+    {
+      Log_ErrorPrintf("chd_read(%u) failed: %s", hunk_index, chd_error_string(err));
 
-  m_current_hunk_index = hunk_index;
-  return true;
+      // data might have been partially written
+      hunk->hunk_index = INVALID_HUNK_INDEX;
+      hunk->state = HunkState::Empty;
+      return nullptr;
+    }
+
+    hunk->state = HunkState::Ready;
+    m_decompressed_hunk_count++;
+    m_decompression_time += decompression_time;
+  }
+
+  hunk->last_used = ++m_cache_counter;
+
+  // Only look ahead when moving to a new hunk, rather than for every sector.
+  if (hunk_index != m_last_hunk_index)
+  {
+    m_last_hunk_index = hunk_index;
+    QueuePrefetch(hunk_index);
+  }
+
+  return hunk;
+}
+
+CDImageCHD::CachedHunk* CDImageCHD::FindCachedHunk(u32 hunk_index)
+{
+  for (CachedHunk& hunk : m_cache)
+  {
+    if (hunk.hunk_index == hunk_index && hunk.state != HunkState::Empty)
+      return &hunk;
+  }
+
+  return nullptr;
+}
+
+CDImageCHD::CachedHunk* CDImageCHD::AllocateCachedHunk(u32 hunk_index)
+{
+  // Evict the least recently used hunk which isn't waiting for a decompression thread.
+  CachedHunk* lru_hunk = nullptr;
+  for (CachedHunk& hunk : m_cache)
+  {
+    if (hunk.state == HunkState::Empty)
+    {
+      lru_hunk = &hunk;
+      break;
+    }
+
+    if (hunk.state == HunkState::Ready && (!lru_hunk || hunk.last_used < lru_hunk->last_used))
+      lru_hunk = &hunk;
+  }
+
+  Assert(lru_hunk);
+  lru_hunk->hunk_index = hunk_index;
+  lru_hunk->state = HunkState::Empty;
+  lru_hunk->last_used = ++m_cache_counter;
+  return lru_hunk;
+}
+
+void CDImageCHD::QueuePrefetch(u32 hunk_index)
+{
+  // Anything which hasn't been started yet is for an old position, and may not be needed any more.
+  for (CachedHunk* hunk : m_decompression_queue)
+  {
+    hunk->hunk_index = INVALID_HUNK_INDEX;
+    hunk->state = HunkState::Empty;
+  }
+  m_decompression_queue.clear();
+
+  bool queued = false;
+  for (u32 i = 1; i <= m_prefetch_hunk_count; i++)
+  {
+    const u32 prefetch_hunk_index = hunk_index + i;
+    if (prefetch_hunk_index >= m_hunk_count)
+      break;
+
+    if (FindCachedHunk(prefetch_hunk_index))
+      continue;
+
+    CachedHunk* hunk = AllocateCachedHunk(prefetch_hunk_index);
+    hunk->state = HunkState::Pending;
+    m_decompression_queue.push_back(hunk);
+    queued = true;
+  }
+
+  if (queued)
+    m_queue_cv.notify_all();
+}
+
+void CDImageCHD::StartDecompressionThreads(const char* filename, u32 thread_count)
+{
+  for (u32 i = 0; i < thread_count; i++)
+  {
+    chd_file* chd;
+    const chd_error err = chd_open(filename, CHD_OPEN_READ, nullptr, &chd);
+    if (err != CHDERR_NONE)
+    {
+      Log_ErrorPrintf("Failed to open CHD '%s' for decompression thread: %s", filename, chd_error_string(err));
+      break;
+    }
+
+    m_decompression_chds.push_back(chd);
+    m_decompression_threads.emplace_back(&CDImageCHD::DecompressionThreadEntryPoint, this, chd);
+  }
+
+  // Without any threads, prefetched hunks would never become ready.
+  if (m_decompression_threads.empty())
+    m_prefetch_hunk_count = 0;
+}
+
+void CDImageCHD::StopDecompressionThreads()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_cache_mutex);
+    m_decompression_threads_shutdown = true;
+    m_queue_cv.notify_all();
+  }
+
+  for (std::thread& thread : m_decompression_threads)
+    thread.join();
+  m_decompression_threads.clear();
+
+  for (chd_file* chd : m_decompression_chds)
+    chd_close(chd);
+  m_decompression_chds.clear();
+}
+
+void CDImageCHD::DecompressionThreadEntryPoint(chd_file* chd)
+{
+  std::unique_lock<std::mutex> lock(m_cache_mutex);
+  for (;;)
+  {
+    m_queue_cv.wait(lock, [this]() { return m_decompression_threads_shutdown || !m_decompression_queue.empty(); });
+    if (m_decompression_threads_shutdown)
+      break;
+
+    CachedHunk* hunk = m_decompression_queue.front();
+    m_decompression_queue.pop_front();
+
+    lock.unlock();
+    Common::Timer timer;
+    const chd_error err = chd_read(chd, hunk->hunk_index, hunk->data.data());
+    const double decompression_time = timer.GetTimeMilliseconds();
+    lock.lock();
+
+    if (err == CHDERR_NONE)
+    {
+      hunk->state = HunkState::Ready;
+      m_decompressed_hunk_count++;
+      m_decompression_time += decompression_time;
+    }
+    else
+    {
+      // Leave it for the reader to retry, and report.
+      Log_WarningPrintf("Failed to decompress hunk %u ahead of the reader: %s", hunk->hunk_index,
+                        chd_error_string(err));
+      hunk->hunk_index = INVALID_HUNK_INDEX;
+      hunk->state = HunkState::Empty;
+    }
+
+    m_hunk_ready_cv.notify_all();
+  }
 }
 
-std::unique_ptr<CDImage> CDImage::OpenCHDImage(const char* filename)
+std::unique_ptr<CDImage> CDImage::OpenCHDImage(const char* filename, const OpenOptions& options)
 {
   std::unique_ptr<CDImageCHD> image = std::make_unique<CDImageCHD>();
-  if (!image->Open(filename))
+  if (!image->Open(filename, options))
     return {};
 
   return image;
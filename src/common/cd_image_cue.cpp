@@ -3,11 +3,17 @@
 #include "cd_subchannel_replacement.h"
 #include "file_system.h"
 #include "log.h"
+#include "memory_mapped_file.h"
 #include <algorithm>
+#include <cstring>
 #include <libcue/libcue.h>
 #include <map>
+#include <mutex>
 Log_SetChannel(CDImageCueSheet);
 
+// libcue's parser keeps its state in globals, so only one cuesheet can be parsed at a time.
+static std::mutex s_cue_parse_mutex;
+
 class CDImageCueSheet : public CDImage
 {
 public:
@@ -17,9 +23,11 @@ public:
   bool OpenAndParse(const char* filename);
 
   bool ReadSubChannelQ(SubChannelQ* subq) override;
+  bool HasSectorPointers() const override;
 
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+  const u8* GetSectorPointerFromIndex(const Index& index, LBA lba_in_index) override;
 
 private:
   Cd* m_cd = nullptr;
@@ -29,6 +37,9 @@ private:
     std::string filename;
     std::FILE* file;
     u64 file_position;
+
+    // Sectors are read straight from the mapping when the file can be mapped, otherwise with stdio.
+    std::unique_ptr<MemoryMappedFile> mapping;
   };
 
   std::vector<TrackFile> m_files;
@@ -39,7 +50,10 @@ CDImageCueSheet::CDImageCueSheet() = default;
 
 CDImageCueSheet::~CDImageCueSheet()
 {
-  std::for_each(m_files.begin(), m_files.end(), [](TrackFile& t) { std::fclose(t.file); });
+  std::for_each(m_files.begin(), m_files.end(), [](TrackFile& t) {
+    if (t.file)
+      std::fclose(t.file);
+  });
   cd_delete(m_cd);
 }
 
@@ -52,7 +66,10 @@ bool CDImageCueSheet::OpenAndParse(const char* filename)
     return false;
   }
 
-  m_cd = cue_parse_file(cue_fp);
+  {
+    std::lock_guard<std::mutex> guard(s_cue_parse_mutex);
+    m_cd = cue_parse_file(cue_fp);
+  }
   std::fclose(cue_fp);
   if (!m_cd)
   {
@@ -88,15 +105,20 @@ bool CDImageCueSheet::OpenAndParse(const char* filename)
     if (track_file_index == m_files.size())
     {
       std::string track_full_filename = basepath + track_filename;
-      std::FILE* track_fp = FileSystem::OpenCFile(track_full_filename.c_str(), "rb");
-      if (!track_fp)
+      std::unique_ptr<MemoryMappedFile> track_mapping = MemoryMappedFile::Open(track_full_filename.c_str());
+      std::FILE* track_fp = nullptr;
+      if (!track_mapping)
       {
-        Log_ErrorPrintf("Failed to open track filename '%s' (from '%s' and '%s')", track_full_filename.c_str(),
-                        track_filename.c_str(), filename);
-        return false;
+        track_fp = FileSystem::OpenCFile(track_full_filename.c_str(), "rb");
+        if (!track_fp)
+        {
+          Log_ErrorPrintf("Failed to open track filename '%s' (from '%s' and '%s')", track_full_filename.c_str(),
+                          track_filename.c_str(), filename);
+          return false;
+        }
       }
 
-      m_files.push_back(TrackFile{std::move(track_filename), track_fp, 0});
+      m_files.push_back(TrackFile{std::move(track_filename), track_fp, 0, std::move(track_mapping)});
     }
 
     // data type determines the sector size
@@ -113,9 +135,18 @@ bool CDImageCueSheet::OpenAndParse(const char* filename)
     // determine the length from the file
     if (track_length < 0)
     {
-      std::fseek(m_files[track_file_index].file, 0, SEEK_END);
-      long file_size = std::ftell(m_files[track_file_index].file);
-      std::fseek(m_files[track_file_index].file, 0, SEEK_SET);
+      const TrackFile& tf = m_files[track_file_index];
+      long file_size;
+      if (tf.mapping)
+      {
+        file_size = static_cast<long>(tf.mapping->GetSize());
+      }
+      else
+      {
+        std::fseek(tf.file, 0, SEEK_END);
+        file_size = std::ftell(tf.file);
+        std::fseek(tf.file, 0, SEEK_SET);
+      }
 
       file_size /= track_sector_size;
       Assert(track_start < file_size);
@@ -226,6 +257,16 @@ bool CDImageCueSheet::ReadSectorFromIndex(void* buffer, const Index& index, LBA
   DebugAssert(index.file_index < m_files.size());
 
   TrackFile& tf = m_files[index.file_index];
+  if (tf.mapping)
+  {
+    const u8* sector_ptr = GetSectorPointerFromIndex(index, lba_in_index);
+    if (!sector_ptr)
+      return false;
+
+    std::memcpy(buffer, sector_ptr, index.file_sector_size);
+    return true;
+  }
+
   const u64 file_position = index.file_offset + (static_cast<u64>(lba_in_index) * index.file_sector_size);
   if (tf.file_position != file_position)
   {
@@ -245,6 +286,39 @@ bool CDImageCueSheet::ReadSectorFromIndex(void* buffer, const Index& index, LBA
   return true;
 }
 
+const u8* CDImageCueSheet::GetSectorPointerFromIndex(const Index& index, LBA lba_in_index)
+{
+  DebugAssert(index.file_index < m_files.size());
+
+  MemoryMappedFile* mapping = m_files[index.file_index].mapping.get();
+  if (!mapping)
+    return nullptr;
+
+  const u64 file_position = index.file_offset + (static_cast<u64>(lba_in_index) * index.file_sector_size);
+  if ((file_position + index.file_sector_size) > mapping->GetSize())
+    return nullptr;
+
+  mapping->AdviseRead(file_position, index.file_sector_size);
+  return mapping->GetData() + file_position;
+}
+
+bool CDImageCueSheet::HasSectorPointers() const
+{
+  for (const Index& index : m_indices)
+  {
+    if (index.file_sector_size == 0 || index.length == 0)
+      continue;
+
+    DebugAssert(index.file_index < m_files.size());
+    const MemoryMappedFile* mapping = m_files[index.file_index].mapping.get();
+    const u64 end_position = index.file_offset + (static_cast<u64>(index.length) * index.file_sector_size);
+    if (!mapping || index.file_sector_size != RAW_SECTOR_SIZE || end_position > mapping->GetSize())
+      return false;
+  }
+
+  return true;
+}
+
 std::unique_ptr<CDImage> CDImage::OpenCueSheetImage(const char* filename)
 {
   std::unique_ptr<CDImageCueSheet> image = std::make_unique<CDImageCueSheet>();
@@ -0,0 +1,194 @@
+#include "cd_image.h"
+#include "log.h"
+#include "timer.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+Log_SetChannel(CDImagePrefetch);
+
+// Wraps another image, reading sectors on a worker thread ahead of the drive so that the emulation thread doesn't
+// have to wait for the disk (or decompression) when the sectors are read.
+class CDImagePrefetch : public CDImage
+{
+public:
+  CDImagePrefetch(std::unique_ptr<CDImage> image);
+  ~CDImagePrefetch() override;
+
+  bool ReadSubChannelQ(SubChannelQ* subq) override;
+  void SetReadSpeed(u32 sectors_per_second) override;
+
+protected:
+  bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+
+private:
+  enum : u32
+  {
+    READ_AHEAD_SECONDS = 2,
+    MAX_SECTORS_PER_SECOND = 150,
+    NUM_SLOTS = READ_AHEAD_SECONDS * MAX_SECTORS_PER_SECOND,
+    INVALID_LBA = UINT32_C(0xFFFFFFFF)
+  };
+
+  struct Slot
+  {
+    LBA lba = INVALID_LBA;
+    bool okay = false;
+    SubChannelQ subq = {};
+    std::array<u8, RAW_SECTOR_SIZE> data;
+  };
+
+  bool GetSector(LBA lba, void* buffer, SubChannelQ* subq);
+  void ThreadEntryPoint();
+
+  // Only accessed by the worker thread once it's started.
+  std::unique_ptr<CDImage> m_image;
+  LBA m_end_lba = 0;
+
+  std::vector<Slot> m_slots;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_wake_cv;
+  std::condition_variable m_sector_cv;
+
+  // Window of sectors which the worker keeps loaded, starting at the drive's current position.
+  LBA m_read_lba = 0;
+  u32 m_read_ahead_count = READ_AHEAD_SECONDS * 75;
+  bool m_shutdown = false;
+
+  u32 m_hit_count = 0;
+  u32 m_miss_count = 0;
+  double m_miss_wait_time = 0.0;
+};
+
+CDImagePrefetch::CDImagePrefetch(std::unique_ptr<CDImage> image) : m_image(std::move(image)), m_slots(NUM_SLOTS)
+{
+  CopyLayout(*m_image);
+  for (const Index& index : m_indices)
+    m_end_lba = std::max(m_end_lba, index.start_lba_on_disc + index.length);
+
+  Seek(m_image->GetPositionOnDisc());
+  m_read_lba = m_position_on_disc;
+  m_thread = std::thread(&CDImagePrefetch::ThreadEntryPoint, this);
+}
+
+CDImagePrefetch::~CDImagePrefetch()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_shutdown = true;
+    m_wake_cv.notify_one();
+  }
+
+  m_thread.join();
+
+  Log_InfoPrintf("%u sector reads from '%s', %u missed the prefetch buffer (%.2f ms waiting)",
+                 m_hit_count + m_miss_count, m_filename.c_str(), m_miss_count, m_miss_wait_time);
+}
+
+bool CDImagePrefetch::ReadSubChannelQ(SubChannelQ* subq)
+{
+  // Sub-channel Q comes from the wrapped image, since it may have replacement data.
+  return GetSector(m_position_on_disc, nullptr, subq);
+}
+
+void CDImagePrefetch::SetReadSpeed(u32 sectors_per_second)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_read_ahead_count = std::clamp<u32>(sectors_per_second * READ_AHEAD_SECONDS, 1, NUM_SLOTS);
+  m_wake_cv.notify_one();
+}
+
+bool CDImagePrefetch::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
+{
+  return GetSector(index.start_lba_on_disc + lba_in_index, buffer, nullptr);
+}
+
+bool CDImagePrefetch::GetSector(LBA lba, void* buffer, SubChannelQ* subq)
+{
+  // The worker never loads past the end of the disc, so don't wait for it.
+  if (lba >= m_end_lba)
+    return false;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_read_lba != lba)
+  {
+    m_read_lba = lba;
+    m_wake_cv.notify_one();
+  }
+
+  const Slot& slot = m_slots[lba % NUM_SLOTS];
+  if (slot.lba == lba)
+  {
+    m_hit_count++;
+  }
+  else
+  {
+    // Either we seeked, or the worker couldn't keep up.
+    Common::Timer timer;
+    m_sector_cv.wait(lock, [&slot, lba]() { return slot.lba == lba; });
+
+    const double wait_time = timer.GetTimeMilliseconds();
+    m_miss_count++;
+    m_miss_wait_time += wait_time;
+    Log_DevPrintf("Prefetch miss for LBA %u, waited %.2f ms", lba, wait_time);
+  }
+
+  if (!slot.okay)
+    return false;
+
+  if (buffer)
+    std::copy(slot.data.begin(), slot.data.end(), static_cast<u8*>(buffer));
+  if (subq)
+    *subq = slot.subq;
+
+  return true;
+}
+
+void CDImagePrefetch::ThreadEntryPoint()
+{
+  std::array<u8, RAW_SECTOR_SIZE> data;
+  SubChannelQ subq = {};
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_shutdown)
+  {
+    // Find the first sector in the window which isn't loaded yet.
+    const LBA end_lba = std::min(m_read_lba + m_read_ahead_count, m_end_lba);
+    LBA lba = m_read_lba;
+    while (lba < end_lba && m_slots[lba % NUM_SLOTS].lba == lba)
+      lba++;
+
+    if (lba >= end_lba)
+    {
+      m_wake_cv.wait(lock);
+      continue;
+    }
+
+    lock.unlock();
+    const bool okay = m_image->Seek(lba) && m_image->ReadSubChannelQ(&subq) && m_image->ReadRawSector(data.data());
+    lock.lock();
+
+    Slot& slot = m_slots[lba % NUM_SLOTS];
+    slot.lba = lba;
+    slot.okay = okay;
+    slot.subq = subq;
+    slot.data = data;
+    m_sector_cv.notify_one();
+  }
+}
+
+std::unique_ptr<CDImage> CDImage::CreatePrefetchImage(std::unique_ptr<CDImage> image)
+{
+  // The emulation thread would copy out of the prefetch buffer instead of reading straight from the mapping, and the
+  // OS already reads mapped files ahead.
+  if (image->HasSectorPointers())
+  {
+    Log_InfoPrintf("Not reading ahead from '%s', since it is memory-mapped", image->GetFileName().c_str());
+    return image;
+  }
+
+  return std::make_unique<CDImagePrefetch>(std::move(image));
+}
@@ -0,0 +1,275 @@
+#include "cd_image.h"
+#include "log.h"
+#include "timer.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+Log_SetChannel(CDImagePreload);
+
+// Wraps another image, loading the whole disc into memory on a worker thread. Reads only wait for the disk when the
+// worker hasn't got to the sector yet, in which case it skips ahead to load it next.
+class CDImagePreload : public CDImage
+{
+public:
+  CDImagePreload(std::unique_ptr<CDImage> image, bool compress);
+  ~CDImagePreload() override;
+
+  bool ReadSubChannelQ(SubChannelQ* subq) override;
+
+protected:
+  bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+  const u8* GetSectorPointerFromIndex(const Index& index, LBA lba_in_index) override;
+
+private:
+  enum : u32
+  {
+    // Sectors are compressed in blocks of this many, since single sectors don't compress as well.
+    BLOCK_SECTORS = 16,
+    BLOCK_SIZE = BLOCK_SECTORS * RAW_SECTOR_SIZE,
+    INVALID_BLOCK = UINT32_C(0xFFFFFFFF)
+  };
+
+  struct Block
+  {
+    bool loaded = false;
+    bool compressed = false;
+    u32 failed_mask = 0;
+    std::array<SubChannelQ, BLOCK_SECTORS> subq;
+    std::vector<u8> data;
+  };
+
+  const u8* GetSector(LBA lba);
+  const Block& WaitForBlock(u32 block_index);
+  void LoadBlock(u32 block_index, Block* block, std::vector<u8>* buffer);
+  void ThreadEntryPoint();
+
+  // Only accessed by the worker thread once it's started.
+  std::unique_ptr<CDImage> m_image;
+  LBA m_end_lba = 0;
+  bool m_compress;
+
+  // Blocks are never modified once they're loaded, so they can be read without the lock.
+  std::vector<Block> m_blocks;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_block_cv;
+  u32 m_next_block = 0;
+  bool m_shutdown = false;
+
+  // Last block which was decompressed, only accessed by the reading thread.
+  std::vector<u8> m_decompressed_data;
+  u32 m_decompressed_block = INVALID_BLOCK;
+
+  u32 m_read_count = 0;
+  u32 m_wait_count = 0;
+  double m_wait_time = 0.0;
+  double m_max_wait_time = 0.0;
+  u32 m_decompress_count = 0;
+  double m_decompress_time = 0.0;
+};
+
+CDImagePreload::CDImagePreload(std::unique_ptr<CDImage> image, bool compress)
+  : m_image(std::move(image)), m_compress(compress)
+{
+  CopyLayout(*m_image);
+  for (const Index& index : m_indices)
+    m_end_lba = std::max(m_end_lba, index.start_lba_on_disc + index.length);
+
+  m_blocks.resize((m_end_lba + BLOCK_SECTORS - 1) / BLOCK_SECTORS);
+  m_decompressed_data.resize(BLOCK_SIZE);
+
+  Seek(m_image->GetPositionOnDisc());
+  m_next_block = m_position_on_disc / BLOCK_SECTORS;
+  m_thread = std::thread(&CDImagePreload::ThreadEntryPoint, this);
+}
+
+CDImagePreload::~CDImagePreload()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_shutdown = true;
+  }
+
+  m_thread.join();
+
+  Log_InfoPrintf("%u sector reads from '%s', %u waited for loading (%.2f ms total, %.2f ms max), %.3f ms average "
+                 "decompression",
+                 m_read_count, m_filename.c_str(), m_wait_count, m_wait_time, m_max_wait_time,
+                 (m_decompress_count > 0) ? (m_decompress_time / static_cast<double>(m_decompress_count)) : 0.0);
+}
+
+bool CDImagePreload::ReadSubChannelQ(SubChannelQ* subq)
+{
+  // Sub-channel Q comes from the wrapped image, since it may have replacement data.
+  if (m_position_on_disc >= m_end_lba)
+    return false;
+
+  const Block& block = WaitForBlock(m_position_on_disc / BLOCK_SECTORS);
+  const u32 sector_in_block = m_position_on_disc % BLOCK_SECTORS;
+  if (block.failed_mask & (1u << sector_in_block))
+    return false;
+
+  *subq = block.subq[sector_in_block];
+  return true;
+}
+
+bool CDImagePreload::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
+{
+  const u8* sector_ptr = GetSector(index.start_lba_on_disc + lba_in_index);
+  if (!sector_ptr)
+    return false;
+
+  std::memcpy(buffer, sector_ptr, RAW_SECTOR_SIZE);
+  return true;
+}
+
+const u8* CDImagePreload::GetSectorPointerFromIndex(const Index& index, LBA lba_in_index)
+{
+  return GetSector(index.start_lba_on_disc + lba_in_index);
+}
+
+const u8* CDImagePreload::GetSector(LBA lba)
+{
+  if (lba >= m_end_lba)
+    return nullptr;
+
+  m_read_count++;
+
+  const u32 block_index = lba / BLOCK_SECTORS;
+  const u32 sector_in_block = lba % BLOCK_SECTORS;
+  const Block& block = WaitForBlock(block_index);
+  if (block.failed_mask & (1u << sector_in_block))
+    return nullptr;
+
+  if (!block.compressed)
+    return block.data.data() + (sector_in_block * RAW_SECTOR_SIZE);
+
+  if (m_decompressed_block != block_index)
+  {
+    Common::Timer timer;
+    uLongf decompressed_size = static_cast<uLongf>(m_decompressed_data.size());
+    if (uncompress(m_decompressed_data.data(), &decompressed_size, block.data.data(),
+                   static_cast<uLong>(block.data.size())) != Z_OK)
+    {
+      Log_ErrorPrintf("Failed to decompress block %u", block_index);
+      m_decompressed_block = INVALID_BLOCK;
+      return nullptr;
+    }
+
+    m_decompressed_block = block_index;
+    m_decompress_count++;
+    m_decompress_time += timer.GetTimeMilliseconds();
+  }
+
+  return m_decompressed_data.data() + (sector_in_block * RAW_SECTOR_SIZE);
+}
+
+const CDImagePreload::Block& CDImagePreload::WaitForBlock(u32 block_index)
+{
+  const Block& block = m_blocks[block_index];
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (block.loaded)
+    return block;
+
+  // Have the worker load this block next, and carry on from there.
+  Common::Timer timer;
+  m_next_block = block_index;
+  m_block_cv.notify_all();
+  m_block_cv.wait(lock, [&block]() { return block.loaded; });
+
+  const double wait_time = timer.GetTimeMilliseconds();
+  m_wait_count++;
+  m_wait_time += wait_time;
+  m_max_wait_time = std::max(m_max_wait_time, wait_time);
+  Log_DevPrintf("Waited %.2f ms for block %u to load", wait_time, block_index);
+  return block;
+}
+
+void CDImagePreload::LoadBlock(u32 block_index, Block* block, std::vector<u8>* buffer)
+{
+  const LBA start_lba = block_index * BLOCK_SECTORS;
+  const u32 sector_count = std::min<u32>(m_end_lba - start_lba, BLOCK_SECTORS);
+  const u32 block_size = sector_count * RAW_SECTOR_SIZE;
+
+  bool seek_needed = true;
+  for (u32 i = 0; i < sector_count; i++)
+  {
+    if ((seek_needed && !m_image->Seek(start_lba + i)) || !m_image->ReadSubChannelQ(&block->subq[i]) ||
+        !m_image->ReadRawSector(buffer->data() + (i * RAW_SECTOR_SIZE)))
+    {
+      block->failed_mask |= (1u << i);
+      seek_needed = true;
+      continue;
+    }
+
+    seek_needed = false;
+  }
+
+  if (m_compress)
+  {
+    std::vector<u8> compressed_data(compressBound(static_cast<uLong>(block_size)));
+    uLongf compressed_size = static_cast<uLongf>(compressed_data.size());
+    if (compress2(compressed_data.data(), &compressed_size, buffer->data(), static_cast<uLong>(block_size),
+                  Z_BEST_SPEED) == Z_OK &&
+        compressed_size < block_size)
+    {
+      compressed_data.resize(compressed_size);
+      compressed_data.shrink_to_fit();
+      block->data = std::move(compressed_data);
+      block->compressed = true;
+      return;
+    }
+  }
+
+  block->data.assign(buffer->begin(), buffer->begin() + block_size);
+}
+
+void CDImagePreload::ThreadEntryPoint()
+{
+  Common::Timer timer;
+  std::vector<u8> buffer(BLOCK_SIZE);
+  const u32 block_count = static_cast<u32>(m_blocks.size());
+  u64 memory_used = 0;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (u32 blocks_loaded = 0; blocks_loaded < block_count && !m_shutdown; blocks_loaded++)
+  {
+    // Blocks are loaded in order from the last read, wrapping around to fill in any we skipped.
+    u32 block_index = m_next_block % block_count;
+    while (m_blocks[block_index].loaded)
+      block_index = (block_index + 1) % block_count;
+    m_next_block = block_index + 1;
+
+    lock.unlock();
+    Block block;
+    LoadBlock(block_index, &block, &buffer);
+    memory_used += block.data.size() + sizeof(Block);
+    lock.lock();
+
+    block.loaded = true;
+    m_blocks[block_index] = std::move(block);
+    m_block_cv.notify_all();
+  }
+
+  if (m_shutdown)
+    return;
+
+  const u64 uncompressed_size = static_cast<u64>(m_end_lba) * RAW_SECTOR_SIZE;
+  Log_InfoPrintf("Loaded '%s' into memory in %.2f seconds, using %.2f MB (%.1f%% of %.2f MB)", m_filename.c_str(),
+                 timer.GetTimeSeconds(), static_cast<double>(memory_used) / 1048576.0,
+                 (static_cast<double>(memory_used) * 100.0) / static_cast<double>(uncompressed_size),
+                 static_cast<double>(uncompressed_size) / 1048576.0);
+
+  // The wrapped image is no longer needed, so close its files.
+  m_image.reset();
+}
+
+std::unique_ptr<CDImage> CDImage::CreatePreloadImage(std::unique_ptr<CDImage> image, bool compress)
+{
+  return std::make_unique<CDImagePreload>(std::move(image), compress);
+}
@@ -2,6 +2,7 @@
 #include "cd_image.h"
 #include <algorithm>
 #include <array>
+#include <cstring>
 
 namespace CDXA {
 static constexpr std::array<s32, 4> s_xa_adpcm_filter_table_pos = {{0, 60, 115, 98}};
@@ -26,11 +27,9 @@ static void DecodeXA_ADPCMChunk(const u8* chunk_ptr, s16* samples, s32* last_sam
     const s32 filter_pos = s_xa_adpcm_filter_table_pos[filter];
     const s32 filter_neg = s_xa_adpcm_filter_table_neg[filter];
 
-    s16* out_samples_ptr =
-      IS_STEREO ? &samples[(block / 2) * (WORDS_PER_BLOCK * 2) + (block % 2)] : &samples[block * WORDS_PER_BLOCK];
-    constexpr u32 out_samples_increment = IS_STEREO ? 2 : 1;
-
-    for (u32 word = 0; word < 28; word++)
+    // Unpack the block's samples first, since that part doesn't depend on the previous samples and vectorises.
+    std::array<s32, WORDS_PER_BLOCK> block_samples;
+    for (u32 word = 0; word < WORDS_PER_BLOCK; word++)
     {
       // NOTE: assumes LE
       u32 word_data;
@@ -38,19 +37,29 @@ static void DecodeXA_ADPCMChunk(const u8* chunk_ptr, s16* samples, s32* last_sam
 
       // extract nibble from block
       const u32 nibble = IS_8BIT ? ((word_data >> (block * 8)) & 0xFF) : ((word_data >> (block * 4)) & 0x0F);
-      const s16 sample = static_cast<s16>(Truncate16(nibble << 12)) >> shift;
+      block_samples[word] = static_cast<s16>(Truncate16(nibble << 12)) >> shift;
+    }
 
-      // mix in previous values
-      s32* prev = IS_STEREO ? &last_samples[(block & 1) * 2] : last_samples;
-      const s32 interp_sample = s32(sample) + ((prev[0] * filter_pos) + (prev[1] * filter_neg) + 32) / 64;
+    s16* out_samples_ptr =
+      IS_STEREO ? &samples[(block / 2) * (WORDS_PER_BLOCK * 2) + (block % 2)] : &samples[block * WORDS_PER_BLOCK];
+    constexpr u32 out_samples_increment = IS_STEREO ? 2 : 1;
 
-      // update previous values
-      prev[1] = prev[0];
-      prev[0] = interp_sample;
+    // mix in previous values, keeping them in registers for the block
+    s32* prev = IS_STEREO ? &last_samples[(block & 1) * 2] : last_samples;
+    s32 prev0 = prev[0];
+    s32 prev1 = prev[1];
+    for (u32 word = 0; word < WORDS_PER_BLOCK; word++)
+    {
+      const s32 interp_sample = block_samples[word] + ((prev0 * filter_pos) + (prev1 * filter_neg) + 32) / 64;
+      prev1 = prev0;
+      prev0 = interp_sample;
 
       *out_samples_ptr = static_cast<s16>(std::clamp<s32>(interp_sample, -0x8000, 0x7FFF));
       out_samples_ptr += out_samples_increment;
     }
+
+    prev[0] = prev0;
+    prev[1] = prev1;
   }
 }
 
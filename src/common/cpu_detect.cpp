@@ -0,0 +1,44 @@
+#include "cpu_detect.h"
+
+#if defined(CPU_X64)
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace CPUDetect {
+
+bool HostSupportsSSSE3()
+{
+#ifdef _MSC_VER
+  int regs[4];
+  __cpuid(regs, 1);
+  return (regs[2] & (1 << 9)) != 0;
+#else
+  return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+bool HostSupportsAVX2()
+{
+#ifdef _MSC_VER
+  int regs[4];
+  __cpuid(regs, 0);
+  if (regs[0] < 7)
+    return false;
+
+  // OS must save the YMM registers.
+  __cpuid(regs, 1);
+  if ((regs[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+    return false;
+
+  __cpuidex(regs, 7, 0);
+  return (regs[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+} // namespace CPUDetect
+
+#endif
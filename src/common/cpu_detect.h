@@ -29,3 +29,15 @@
 #error Unknown compiler.
 
 #endif
+
+#if defined(CPU_X64)
+
+namespace CPUDetect {
+
+// SSE2 is part of the x64 baseline, so only the extensions beyond it need checking.
+bool HostSupportsSSSE3();
+bool HostSupportsAVX2();
+
+} // namespace CPUDetect
+
+#endif
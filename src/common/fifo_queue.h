@@ -18,7 +18,10 @@ public:
   constexpr u32 GetCapacity() const { return CAPACITY; }
   u32 GetSize() const { return m_size; }
   u32 GetSpace() const { return CAPACITY - m_size; }
-  u32 GetContiguousSpace() const { return (m_tail >= m_head) ? (CAPACITY - m_tail) : (m_head - m_tail); }
+  u32 GetContiguousSpace() const
+  {
+    return (m_size == CAPACITY) ? 0 : ((m_tail >= m_head) ? (CAPACITY - m_tail) : (m_head - m_tail));
+  }
   u32 GetContiguousSize() const { return std::min<u32>(CAPACITY - m_head, m_size); }
   bool IsEmpty() const { return m_size == 0; }
   bool IsFull() const { return m_size == CAPACITY; }
@@ -88,17 +91,61 @@ public:
     }
   }
 
+  // Space for GetContiguousSpace() elements at the back of the queue, which can be filled in place and then added
+  // with CommitPush(), instead of going through a temporary buffer.
+  T* GetBackPointer() { return &m_ptr[m_tail]; }
+
+  template<class Y = T, std::enable_if_t<std::is_pod_v<Y>, int> = 0>
+  void CommitPush(u32 count)
+  {
+    Assert(count <= GetContiguousSpace());
+    m_tail = (m_tail + count) % CAPACITY;
+    m_size += count;
+  }
+
   const T& Peek() const { return m_ptr[m_head]; }
   const T& Peek(u32 offset) { return m_ptr[(m_head + offset) % CAPACITY]; }
 
+  // Returns the first count elements as at most two spans, since they may wrap around the end of the buffer.
+  // The second span is empty if they don't wrap.
+  void PeekSpans(u32 count, const T** span0, u32* span0_size, const T** span1, u32* span1_size) const
+  {
+    Assert(m_size >= count);
+    *span0 = &m_ptr[m_head];
+    *span0_size = std::min(CAPACITY - m_head, count);
+    *span1 = m_ptr;
+    *span1_size = count - *span0_size;
+  }
+
+  // Copies the first count elements without removing them.
+  template<class Y = T, std::enable_if_t<std::is_pod_v<Y>, int> = 0>
+  void PeekRange(T* out_data, u32 count) const
+  {
+    const T* span0;
+    const T* span1;
+    u32 span0_size, span1_size;
+    PeekSpans(count, &span0, &span0_size, &span1, &span1_size);
+    std::memcpy(out_data, span0, sizeof(T) * span0_size);
+    if (span1_size > 0)
+      std::memcpy(out_data + span0_size, span1, sizeof(T) * span1_size);
+  }
+
   void Remove(u32 count)
   {
     Assert(m_size >= count);
-    for (u32 i = 0; i < count; i++)
+    if constexpr (std::is_trivially_destructible_v<T>)
     {
-      m_ptr[m_head].~T();
-      m_head = (m_head + 1) % CAPACITY;
-      m_size--;
+      m_head = (m_head + count) % CAPACITY;
+      m_size -= count;
+    }
+    else
+    {
+      for (u32 i = 0; i < count; i++)
+      {
+        m_ptr[m_head].~T();
+        m_head = (m_head + 1) % CAPACITY;
+        m_size--;
+      }
     }
   }
 
@@ -121,6 +168,16 @@ public:
     return val;
   }
 
+  // faster version of PopRange for POD types which can be memcpy()ed
+  template<class Y = T, std::enable_if_t<std::is_pod_v<Y>, int> = 0>
+  void PopRange(T* out_data, u32 count)
+  {
+    PeekRange(out_data, count);
+    m_head = (m_head + count) % CAPACITY;
+    m_size -= count;
+  }
+
+  template<class Y = T, std::enable_if_t<!std::is_pod_v<Y>, int> = 0>
   void PopRange(T* out_data, u32 count)
   {
     Assert(m_size >= count);
@@ -137,10 +194,25 @@ public:
   template<u32 QUEUE_CAPACITY>
   void PushFromQueue(FIFOQueue<T, QUEUE_CAPACITY>* other_queue)
   {
-    while (!other_queue->IsEmpty() && !IsFull())
+    if constexpr (std::is_pod_v<T>)
+    {
+      const T* span0;
+      const T* span1;
+      u32 span0_size, span1_size;
+      const u32 count = std::min(other_queue->GetSize(), GetSpace());
+      other_queue->PeekSpans(count, &span0, &span0_size, &span1, &span1_size);
+      PushRange(span0, span0_size);
+      if (span1_size > 0)
+        PushRange(span1, span1_size);
+      other_queue->Remove(count);
+    }
+    else
     {
-      T& dest = PushAndGetReference();
-      dest = std::move(other_queue->Pop());
+      while (!other_queue->IsEmpty() && !IsFull())
+      {
+        T& dest = PushAndGetReference();
+        dest = std::move(other_queue->Pop());
+      }
     }
   }
 
@@ -1145,6 +1145,18 @@ static u32 RecursiveFindFiles(const char* OriginPath, const char* ParentPath, co
         continue;
     }
 
+    // size and modification time, so that callers can tell when files have changed
+    struct stat64 sysStatData;
+    if (fstatat64(dirfd(pDir), pDirEnt->d_name, &sysStatData, 0) == 0)
+    {
+      outData.ModificationTime.SetUnixTimestamp((Timestamp::UnixTimestampValue)sysStatData.st_mtime);
+      outData.Size = S_ISREG(sysStatData.st_mode) ? static_cast<u64>(sysStatData.st_size) : 0;
+    }
+    else
+    {
+      outData.Size = 0;
+    }
+
     // add file to list
     // TODO string formatter, clean this mess..
     if (!(Flags & FILESYSTEM_FIND_RELATIVE_PATHS))
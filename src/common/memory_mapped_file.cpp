@@ -0,0 +1,150 @@
+#include "memory_mapped_file.h"
+#include "log.h"
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+Log_SetChannel(MemoryMappedFile);
+
+#if defined(WIN32)
+#include "windows_headers.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MemoryMappedFile::MemoryMappedFile(u8* data, u64 size, void* mapping_handle)
+  : m_data(data), m_size(size), m_mapping_handle(mapping_handle)
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(WIN32)
+  UnmapViewOfFile(m_data);
+  CloseHandle(static_cast<HANDLE>(m_mapping_handle));
+#else
+  munmap(m_data, static_cast<size_t>(m_size));
+#endif
+}
+
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(const char* filename)
+{
+#if defined(WIN32)
+  // The file cache does its own read-ahead for sequential scans, since Vista doesn't have PrefetchVirtualMemory().
+  HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return {};
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 ||
+      static_cast<u64>(file_size.QuadPart) > std::numeric_limits<size_t>::max())
+  {
+    CloseHandle(file);
+    return {};
+  }
+
+  // The mapping keeps the file open.
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    Log_WarningPrintf("CreateFileMapping() for '%s' failed: %u", filename, GetLastError());
+    return {};
+  }
+
+  u8* data = static_cast<u8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!data)
+  {
+    Log_WarningPrintf("MapViewOfFile() for '%s' failed: %u", filename, GetLastError());
+    CloseHandle(mapping);
+    return {};
+  }
+
+  return std::unique_ptr<MemoryMappedFile>(
+    new MemoryMappedFile(data, static_cast<u64>(file_size.QuadPart), static_cast<void*>(mapping)));
+#else
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+    return {};
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0 ||
+      static_cast<u64>(st.st_size) > std::numeric_limits<size_t>::max())
+  {
+    close(fd);
+    return {};
+  }
+
+  // The mapping keeps the file open.
+  void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    Log_WarningPrintf("mmap() for '%s' failed: %d", filename, errno);
+    return {};
+  }
+
+  std::unique_ptr<MemoryMappedFile> ret(
+    new MemoryMappedFile(static_cast<u8*>(data), static_cast<u64>(st.st_size), nullptr));
+  ret->SetReadDirection(false);
+  return ret;
+#endif
+}
+
+void MemoryMappedFile::AdviseRead(u64 offset, u32 size)
+{
+  // A short step back means we're reading backwards. Anything else is either reading forwards, or a seek, after
+  // which we assume we'll be reading forwards.
+  const bool backwards = (offset < m_last_read_offset && (m_last_read_offset - offset) <= BACKWARDS_STEP_SIZE);
+  m_last_read_offset = offset;
+  if (backwards != m_reading_backwards)
+  {
+    m_reading_backwards = backwards;
+    SetReadDirection(backwards);
+  }
+
+  // Only hint again once we're halfway through the range we hinted last time, so the next range has time to load.
+  const u64 end = std::min(offset + size, m_size);
+  if (offset >= m_advised_start && end <= m_advised_end)
+  {
+    if (backwards ? (m_advised_start == 0 || (offset - m_advised_start) >= (READ_AHEAD_SIZE / 2)) :
+                    (m_advised_end == m_size || (m_advised_end - end) >= (READ_AHEAD_SIZE / 2)))
+    {
+      return;
+    }
+  }
+
+  if (backwards)
+  {
+    m_advised_start = (end > READ_AHEAD_SIZE) ? (end - READ_AHEAD_SIZE) : 0;
+    m_advised_end = end;
+  }
+  else
+  {
+    m_advised_start = offset;
+    m_advised_end = std::min(offset + READ_AHEAD_SIZE, m_size);
+  }
+
+  WillNeed(m_advised_start, m_advised_end - m_advised_start);
+}
+
+void MemoryMappedFile::SetReadDirection(bool backwards)
+{
+#if !defined(WIN32)
+  // The kernel's read-ahead only works forwards, so when reading backwards we rely on our own hints instead.
+  madvise(m_data, static_cast<size_t>(m_size), backwards ? MADV_RANDOM : MADV_SEQUENTIAL);
+#endif
+}
+
+void MemoryMappedFile::WillNeed(u64 offset, u64 size)
+{
+#if !defined(WIN32)
+  // madvise() needs a page-aligned address.
+  static const u64 page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 aligned_offset = offset & ~(page_size - 1);
+  madvise(m_data + aligned_offset, static_cast<size_t>(size + (offset - aligned_offset)), MADV_WILLNEED);
+#endif
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "types.h"
+#include <memory>
+
+/// Read-only view of a whole file mapped into the address space.
+class MemoryMappedFile
+{
+public:
+  ~MemoryMappedFile();
+
+  /// Maps the file, or returns nullptr if it can't be mapped (e.g. empty, or too large for the address space).
+  static std::unique_ptr<MemoryMappedFile> Open(const char* filename);
+
+  const u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+  /// Hints to the OS that the specified range is about to be read. Reads are expected to be mostly sequential,
+  /// in either direction, so the following (or preceding, when reading backwards) range is faulted in ahead of time.
+  void AdviseRead(u64 offset, u32 size);
+
+private:
+  enum : u32
+  {
+    READ_AHEAD_SIZE = 1024 * 1024,
+    BACKWARDS_STEP_SIZE = 64 * 1024
+  };
+
+  MemoryMappedFile(u8* data, u64 size, void* mapping_handle);
+
+  void SetReadDirection(bool backwards);
+  void WillNeed(u64 offset, u64 size);
+
+  u8* m_data;
+  u64 m_size;
+  void* m_mapping_handle;
+
+  // Range which has already been hinted, and the offset of the last read to work out the direction.
+  u64 m_advised_start = 0;
+  u64 m_advised_end = 0;
+  u64 m_last_read_offset = 0;
+  bool m_reading_backwards = false;
+};
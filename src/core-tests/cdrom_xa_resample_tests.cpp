@@ -0,0 +1,113 @@
+// Checks the XA-ADPCM resampler against the per-sample version, which it has to match bit for bit, in every mode:
+// mono and stereo, full and half sample rate, and 4-bit and 8-bit sectors. Each mode runs a stream of sectors so the
+// ring buffers and six-step counter carry over, from random starting states, with random volume matrices and samples
+// which include runs at the extremes to exercise the saturation.
+
+#include "common/cd_xa.h"
+#include "core/cdrom.h"
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+struct ResampleState
+{
+  std::array<std::array<s16, 32>, 2> ringbuf;
+  u8 p;
+  u8 sixstep;
+};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  static constexpr u32 NUM_SECTORS = 500;
+  static constexpr u32 MAX_OUTPUT_FRAMES = ((CDXA::XA_ADPCM_SAMPLES_PER_SECTOR_4BIT * 2 + 5) / 6) * 7;
+
+  std::mt19937 rng(1);
+  std::array<s16, CDXA::XA_ADPCM_SAMPLES_PER_SECTOR_4BIT> samples;
+  std::array<s16, MAX_OUTPUT_FRAMES * 2> frames;
+  std::array<s16, MAX_OUTPUT_FRAMES * 2> expected_frames;
+  u32 failures = 0;
+  for (u32 mode = 0; mode < 8; mode++)
+  {
+    const bool stereo = (mode & 1) != 0;
+    const bool half_sample_rate = (mode & 2) != 0;
+    const u32 samples_per_sector =
+      (mode & 4) ? CDXA::XA_ADPCM_SAMPLES_PER_SECTOR_8BIT : CDXA::XA_ADPCM_SAMPLES_PER_SECTOR_4BIT;
+    const u32 num_samples = samples_per_sector / (stereo ? 2 : 1);
+
+    ResampleState state;
+    for (auto& ringbuf : state.ringbuf)
+    {
+      for (s16& value : ringbuf)
+        value = static_cast<s16>(rng());
+    }
+    state.p = static_cast<u8>(rng() % 32);
+    state.sixstep = static_cast<u8>(rng() % 6 + 1);
+    ResampleState expected_state = state;
+
+    for (u32 sector = 0; sector < NUM_SECTORS && failures < 10; sector++)
+    {
+      std::array<std::array<u8, 2>, 2> volume_matrix;
+      for (auto& row : volume_matrix)
+      {
+        for (u8& volume : row)
+          volume = (sector % 4 == 0) ? 0xFF : static_cast<u8>(rng());
+      }
+
+      const bool extremes = (sector % 3) == 0;
+      for (u32 i = 0; i < samples_per_sector; i++)
+      {
+        if (extremes)
+          samples[i] = (rng() & 1) ? -0x8000 : 0x7FFF;
+        else
+          samples[i] = static_cast<s16>(rng());
+      }
+
+      const u32 expected_num_frames = CDROM::ResampleXAADPCMReference(
+        samples.data(), num_samples, stereo, half_sample_rate, expected_frames.data(), expected_state.ringbuf[0].data(),
+        expected_state.ringbuf[1].data(), &expected_state.p, &expected_state.sixstep, volume_matrix);
+      const u32 num_frames =
+        CDROM::ResampleXAADPCM(samples.data(), num_samples, stereo, half_sample_rate, frames.data(),
+                               state.ringbuf[0].data(), state.ringbuf[1].data(), &state.p, &state.sixstep, volume_matrix);
+
+      if (num_frames != expected_num_frames)
+      {
+        std::fprintf(stderr, "Mode %u, sector %u: %u frames, expected %u\n", mode, sector, num_frames,
+                     expected_num_frames);
+        failures++;
+        break;
+      }
+
+      for (u32 i = 0; i < num_frames * 2; i++)
+      {
+        if (frames[i] != expected_frames[i])
+        {
+          std::fprintf(stderr, "Mode %u, sector %u: frame %u channel %u is %d, expected %d\n", mode, sector, i / 2,
+                       i % 2, frames[i], expected_frames[i]);
+          failures++;
+          break;
+        }
+      }
+
+      // The right ring buffer isn't used for mono.
+      if (state.p != expected_state.p || state.sixstep != expected_state.sixstep ||
+          state.ringbuf[0] != expected_state.ringbuf[0] || (stereo && state.ringbuf[1] != expected_state.ringbuf[1]))
+      {
+        std::fprintf(stderr, "Mode %u, sector %u: resampler state doesn't match\n", mode, sector);
+        failures++;
+        break;
+      }
+    }
+  }
+
+  if (failures > 0)
+  {
+    std::fprintf(stderr, "FAILED\n");
+    return EXIT_FAILURE;
+  }
+
+  std::printf("Resampler matches the reference for %u sectors in each of the 8 modes\n", NUM_SECTORS);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,376 @@
+// Checks DMA transfers between RAM and the GPU, driving the channels through their registers the way a game does.
+// Blocks are sent to and read back from VRAM stepping both forwards and backwards, including ones which wrap around
+// the ends of RAM, ordering tables are cleared, and linked lists are walked: ones with commands split across nodes,
+// ones with more data than fits in a batch, and ones which loop back on themselves and have to be cut off.
+
+#include "common/log.h"
+#include "core/bus.h"
+#include "core/gpu_sw.h"
+#include "core/system.h"
+#include "test_host_interface.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+enum : u32
+{
+  ADDRESS_MASK = 0x1FFFFC,
+  END_OF_LIST = 0x00FFFFFF,
+
+  GP0 = 0x1F801810,
+  GP1 = 0x1F801814,
+  GPU_MADR = 0x1F8010A0,
+  GPU_BCR = 0x1F8010A4,
+  GPU_CHCR = 0x1F8010A8,
+  OTC_MADR = 0x1F8010E0,
+  OTC_BCR = 0x1F8010E4,
+  OTC_CHCR = 0x1F8010E8,
+  DPCR = 0x1F8010F0,
+
+  CHCR_FROM_RAM = 1 << 0,
+  CHCR_STEP_REVERSE = 1 << 1,
+  CHCR_SYNC_REQUEST = 1 << 9,
+  CHCR_SYNC_LINKED_LIST = 2 << 9,
+  CHCR_BUSY = 1 << 24,
+  CHCR_TRIGGER = 1 << 28,
+
+  GP1_DMA_TO_GP0 = 0x04000002,
+  GP1_DMA_FROM_GPUREAD = 0x04000003,
+
+  BLOCK_SIZE = 16,
+  RECT_WIDTH = 32,
+  RECT_HEIGHT = 8,
+  RECT_WORDS = (RECT_WIDTH * RECT_HEIGHT) / 2
+};
+
+class DMATester
+{
+public:
+  DMATester(System* system) : m_bus(system->GetBus()), m_gpu(static_cast<GPU_SW*>(system->GetGPU())), m_rng(42)
+  {
+    WriteIO(DPCR, ReadIO(DPCR) | UINT32_C(0x08888888));
+  }
+
+  u32 GetFailureCount() const { return m_failures; }
+
+  // Uploads a rectangle to VRAM from words stored at address, stepping forwards or backwards through RAM.
+  void WriteToGPU(u32 address, bool reverse)
+  {
+    const u32 x = Random(0, 1024 - RECT_WIDTH);
+    const u32 y = Random(0, 512 - RECT_HEIGHT);
+    const std::vector<u32> words = RandomWords(RECT_WORDS);
+    for (u32 i = 0; i < RECT_WORDS; i++)
+      WriteRAM(Step(address, i, reverse), words[i]);
+
+    WriteIO(GP1, GP1_DMA_TO_GP0);
+    WriteIO(GP0, UINT32_C(0xA0000000));
+    WriteIO(GP0, (y << 16) | x);
+    WriteIO(GP0, (RECT_HEIGHT << 16) | RECT_WIDTH);
+    WriteIO(GPU_MADR, address);
+    WriteIO(GPU_BCR, ((RECT_WORDS / BLOCK_SIZE) << 16) | BLOCK_SIZE);
+    WriteIO(GPU_CHCR, CHCR_BUSY | CHCR_SYNC_REQUEST | CHCR_FROM_RAM | (reverse ? CHCR_STEP_REVERSE : 0));
+
+    const char* name = reverse ? "Reverse write to GPU" : "Write to GPU";
+    CheckRect(name, x, y, RECT_WIDTH, RECT_HEIGHT, words);
+    CheckFinished(name, GPU_CHCR, GPU_MADR, Step(address, RECT_WORDS, reverse) & END_OF_LIST);
+  }
+
+  // Reads a rectangle back from VRAM into RAM at address, stepping forwards or backwards.
+  void ReadFromGPU(u32 address, bool reverse)
+  {
+    const u32 x = Random(0, 1024 - RECT_WIDTH);
+    const u32 y = Random(0, 512 - RECT_HEIGHT);
+    const std::vector<u32> words = RandomWords(RECT_WORDS);
+    WriteIO(GP1, GP1_DMA_TO_GP0);
+    WriteIO(GP0, UINT32_C(0xA0000000));
+    WriteIO(GP0, (y << 16) | x);
+    WriteIO(GP0, (RECT_HEIGHT << 16) | RECT_WIDTH);
+    for (u32 word : words)
+      WriteIO(GP0, word);
+
+    WriteIO(GP1, GP1_DMA_FROM_GPUREAD);
+    WriteIO(GP0, UINT32_C(0xC0000000));
+    WriteIO(GP0, (y << 16) | x);
+    WriteIO(GP0, (RECT_HEIGHT << 16) | RECT_WIDTH);
+    WriteIO(GPU_MADR, address);
+    WriteIO(GPU_BCR, ((RECT_WORDS / BLOCK_SIZE) << 16) | BLOCK_SIZE);
+    WriteIO(GPU_CHCR, CHCR_BUSY | CHCR_SYNC_REQUEST | (reverse ? CHCR_STEP_REVERSE : 0));
+
+    const char* name = reverse ? "Reverse read from GPU" : "Read from GPU";
+    for (u32 i = 0; i < RECT_WORDS; i++)
+    {
+      const u32 value = ReadRAM(Step(address, i, reverse));
+      if (value != words[i])
+      {
+        std::fprintf(stderr, "%s to 0x%06X: word %u is 0x%08X, expected 0x%08X\n", name, address, i, value, words[i]);
+        m_failures++;
+        break;
+      }
+    }
+
+    CheckFinished(name, GPU_CHCR, GPU_MADR, Step(address, RECT_WORDS, reverse) & END_OF_LIST);
+  }
+
+  // Clears an ordering table of word_count entries ending at address.
+  void ClearOrderingTable(u32 address, u32 word_count)
+  {
+    WriteIO(OTC_MADR, address);
+    WriteIO(OTC_BCR, word_count);
+    WriteIO(OTC_CHCR, CHCR_BUSY | CHCR_TRIGGER | CHCR_STEP_REVERSE);
+
+    for (u32 i = 0; i < word_count; i++)
+    {
+      const u32 entry_address = Step(address, i, true) & ADDRESS_MASK;
+      const u32 expected = (i == (word_count - 1)) ? END_OF_LIST : (Step(address, i + 1, true) & ADDRESS_MASK);
+      const u32 value = ReadRAM(entry_address);
+      if (value != expected)
+      {
+        std::fprintf(stderr, "Ordering table at 0x%06X: entry at 0x%06X is 0x%08X, expected 0x%08X\n", address,
+                     entry_address, value, expected);
+        m_failures++;
+        break;
+      }
+    }
+
+    CheckFinished("Ordering table clear", OTC_CHCR, OTC_MADR, address);
+  }
+
+  // Uploads a rectangle through a linked list, with its command and pixels split over nodes of random sizes. The
+  // first node's payload wraps around the end of RAM.
+  void LinkedList(u32 width, u32 height)
+  {
+    const u32 x = Random(0, 1024 - width);
+    const u32 y = Random(0, 512 - height);
+    const std::vector<u32> pixels = RandomWords((width * height) / 2);
+    std::vector<u32> stream = {UINT32_C(0xA0000000), (y << 16) | x, (height << 16) | width};
+    stream.insert(stream.end(), pixels.begin(), pixels.end());
+
+    u32 node_address = UINT32_C(0x1FFFF8);
+    u32 count = 4;
+    for (u32 position = 0; position < stream.size();)
+    {
+      // Nodes are laid out one after the other, with the odd gap and empty node.
+      const u32 gap = (Random(0, 3) == 0) ? 64 : 0;
+      const u32 next_address = (node_address + (sizeof(u32) * (count + 1)) + gap) & ADDRESS_MASK;
+      const bool last = (position + count) >= stream.size();
+      WriteNode(node_address, last ? END_OF_LIST : next_address, &stream[position], count);
+      position += count;
+      node_address = next_address;
+      count = std::min<u32>(Random(0, 3) == 0 ? 0 : Random(1, 24), static_cast<u32>(stream.size()) - position);
+    }
+
+    WriteIO(GP1, GP1_DMA_TO_GP0);
+    StartLinkedList(UINT32_C(0x1FFFF8));
+    CheckRect("Linked list", x, y, width, height, pixels);
+    CheckFinished("Linked list", GPU_CHCR, GPU_MADR, END_OF_LIST);
+  }
+
+  // A node which links to itself through a mirror of RAM. Its payload must only be sent once, and the channel has to be
+  // left pointing at the node.
+  void SelfLoop()
+  {
+    const u32 x = Random(0, 1020);
+    const u32 y = Random(0, 511);
+    const std::vector<u32> pixels = RandomWords(2);
+    const u32 command[] = {UINT32_C(0xA0000000), (y << 16) | x, (1 << 16) | 4};
+    WriteNode(0x1000, 0x1010, command, 3);
+    WriteNode(0x1010, 0x201010, &pixels[0], 1);
+
+    WriteIO(GP1, GP1_DMA_TO_GP0);
+    StartLinkedList(0x1000);
+    CheckFinished("Self-looping list", GPU_CHCR, GPU_MADR, 0x1010);
+
+    // If the looping node had been sent twice, this would start a new command instead of finishing the upload.
+    WriteIO(GP0, pixels[1]);
+    CheckRect("Self-looping list", x, y, 4, 1, pixels);
+  }
+
+  // A list whose last node links back into its middle, with a fill command in the loop.
+  void LongLoop(u32 tail_length, u32 loop_length)
+  {
+    static constexpr u32 BASE_ADDRESS = 0x20000;
+    static constexpr u32 NODE_SIZE = 16;
+
+    const u32 num_nodes = tail_length + loop_length;
+    const u32 fill_node = tail_length + (loop_length / 2);
+    const u32 fill[] = {UINT32_C(0x02FFFFFF), (256 << 16) | 512, (16 << 16) | 16};
+    for (u32 i = 0; i < num_nodes; i++)
+    {
+      const u32 next = (i == (num_nodes - 1)) ? tail_length : (i + 1);
+      WriteNode(BASE_ADDRESS + i * NODE_SIZE, BASE_ADDRESS + next * NODE_SIZE, fill, (i == fill_node) ? 3 : 0);
+    }
+
+    WriteIO(GP1, GP1_DMA_TO_GP0);
+    WriteIO(GP0, UINT32_C(0x02000000));
+    WriteIO(GP0, (256 << 16) | 512);
+    WriteIO(GP0, (16 << 16) | 16);
+    StartLinkedList(BASE_ADDRESS);
+
+    if (m_gpu->GetPixel(512, 256) != 0x7FFF || m_gpu->GetPixel(527, 271) != 0x7FFF)
+    {
+      std::fprintf(stderr, "Looping list of %u nodes: fill in the loop wasn't executed\n", loop_length);
+      m_failures++;
+    }
+
+    // The walk stops when the next node is the current one or the checkpoint, which starts at the head of the list and
+    // moves to the next node after 1, 2, 4... steps. MADR is left at that next node.
+    u32 node = 0;
+    u32 checkpoint = 0;
+    u32 checkpoint_interval = 1;
+    u32 steps_since_checkpoint = 0;
+    for (;;)
+    {
+      const u32 next = (node == (num_nodes - 1)) ? tail_length : (node + 1);
+      const bool looped = (next == node || next == checkpoint);
+      node = next;
+      if (looped)
+        break;
+
+      if (++steps_since_checkpoint == checkpoint_interval)
+      {
+        checkpoint = next;
+        checkpoint_interval *= 2;
+        steps_since_checkpoint = 0;
+      }
+    }
+
+    const u32 madr = ReadIO(GPU_MADR);
+    const u32 expected_madr = BASE_ADDRESS + node * NODE_SIZE;
+    if (madr != expected_madr)
+    {
+      std::fprintf(stderr, "Looping list of %u nodes: MADR is 0x%08X, expected 0x%08X\n", loop_length, madr,
+                   expected_madr);
+      m_failures++;
+    }
+
+    CheckFinished("Looping list", GPU_CHCR, GPU_MADR, madr);
+  }
+
+private:
+  u32 Random(u32 min, u32 max) { return min + static_cast<u32>(m_rng() % (max - min + 1)); }
+
+  std::vector<u32> RandomWords(u32 count)
+  {
+    std::vector<u32> words(count);
+    for (u32& word : words)
+      word = static_cast<u32>(m_rng());
+    return words;
+  }
+
+  static u32 Step(u32 address, u32 index, bool reverse)
+  {
+    return reverse ? (address - (index * sizeof(u32))) : (address + (index * sizeof(u32)));
+  }
+
+  u32 ReadIO(u32 address)
+  {
+    u32 value = 0;
+    m_bus->ReadWord(address, &value);
+    return value;
+  }
+
+  void WriteIO(u32 address, u32 value) { m_bus->WriteWord(address, value); }
+
+  u32 ReadRAM(u32 address) { return ReadIO(address & ADDRESS_MASK); }
+  void WriteRAM(u32 address, u32 value) { WriteIO(address & ADDRESS_MASK, value); }
+
+  void WriteNode(u32 address, u32 next_address, const u32* words, u32 count)
+  {
+    WriteRAM(address, (count << 24) | next_address);
+    for (u32 i = 0; i < count; i++)
+      WriteRAM(address + sizeof(u32) + (i * sizeof(u32)), words[i]);
+  }
+
+  void StartLinkedList(u32 address)
+  {
+    WriteIO(GPU_MADR, address);
+    WriteIO(GPU_BCR, 0);
+    WriteIO(GPU_CHCR, CHCR_BUSY | CHCR_SYNC_LINKED_LIST | CHCR_FROM_RAM);
+  }
+
+  void CheckRect(const char* name, u32 x, u32 y, u32 width, u32 height, const std::vector<u32>& words)
+  {
+    for (u32 i = 0; i < (width * height); i++)
+    {
+      const u16 expected = static_cast<u16>(words[i / 2] >> ((i % 2) * 16));
+      const u16 pixel = m_gpu->GetPixel(x + (i % width), y + (i / width));
+      if (pixel != expected)
+      {
+        std::fprintf(stderr, "%s: pixel %u of %ux%u at (%u,%u) is 0x%04X, expected 0x%04X\n", name, i, width, height, x,
+                     y, pixel, expected);
+        m_failures++;
+        return;
+      }
+    }
+  }
+
+  void CheckFinished(const char* name, u32 chcr_address, u32 madr_address, u32 expected_madr)
+  {
+    if (ReadIO(chcr_address) & CHCR_BUSY)
+    {
+      std::fprintf(stderr, "%s: channel is still busy\n", name);
+      m_failures++;
+    }
+
+    const u32 madr = ReadIO(madr_address);
+    if (madr != expected_madr)
+    {
+      std::fprintf(stderr, "%s: MADR is 0x%08X, expected 0x%08X\n", name, madr, expected_madr);
+      m_failures++;
+    }
+  }
+
+  Bus* m_bus;
+  GPU_SW* m_gpu;
+  std::mt19937 m_rng;
+  u32 m_failures = 0;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  Log::SetFilterLevel(LOGLEVEL_NONE);
+
+  TestHostInterface host_interface;
+  if (!host_interface.Boot())
+  {
+    std::fprintf(stderr, "Failed to boot system\n");
+    return EXIT_FAILURE;
+  }
+
+  DMATester tester(host_interface.GetSystem());
+
+  // Forwards past the end of RAM, backwards past the start, and both in the middle.
+  tester.WriteToGPU(0x1FFFC0, false);
+  tester.WriteToGPU(0x000040, true);
+  tester.WriteToGPU(0x100000, false);
+  tester.WriteToGPU(0x100400, true);
+  tester.ReadFromGPU(0x1FFFC0, false);
+  tester.ReadFromGPU(0x000040, true);
+  tester.ReadFromGPU(0x100000, false);
+  tester.ReadFromGPU(0x100400, true);
+
+  tester.ClearOrderingTable(0x000010, 10);
+  tester.ClearOrderingTable(0x180000, 0x10000);
+
+  tester.LinkedList(4, 2);
+  tester.LinkedList(64, 130);
+  tester.SelfLoop();
+  tester.LongLoop(10, 1);
+  tester.LongLoop(10, 2);
+  tester.LongLoop(10, 1000);
+
+  if (tester.GetFailureCount() > 0)
+  {
+    std::fprintf(stderr, "FAILED: %u errors\n", tester.GetFailureCount());
+    return EXIT_FAILURE;
+  }
+
+  std::printf("DMA transfers completed correctly\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,31 @@
+#include "test_host_interface.h"
+#include "common/audio_stream.h"
+#include "core/bios.h"
+#include "core/host_display.h"
+#include "core/system.h"
+
+TestHostInterface::TestHostInterface()
+{
+  m_display = HostDisplay::CreateNullDisplay();
+  m_audio_stream = AudioStream::CreateNullAudioStream();
+  m_audio_stream->Reconfigure(AUDIO_SAMPLE_RATE, AUDIO_CHANNELS);
+
+  m_settings.gpu_renderer = GPURenderer::Software;
+  m_settings.speed_limiter_enabled = false;
+  m_settings.controller_types.fill(ControllerType::None);
+  for (std::string& path : m_settings.memory_card_paths)
+    path.clear();
+}
+
+TestHostInterface::~TestHostInterface() = default;
+
+bool TestHostInterface::Boot()
+{
+  return CreateSystem() && BootSystem(nullptr, nullptr);
+}
+
+std::optional<std::vector<u8>> TestHostInterface::GetBIOSImage(ConsoleRegion region)
+{
+  // The CPU never runs, so the BIOS contents are irrelevant.
+  return std::vector<u8>(BIOS::BIOS_SIZE, 0);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "core/host_interface.h"
+
+class System;
+
+/// Host interface which boots a system with the software renderer and no display, audio, controllers or memory cards,
+/// so that tests can drive the hardware directly. The CPU never runs.
+class TestHostInterface final : public HostInterface
+{
+public:
+  TestHostInterface();
+  ~TestHostInterface() override;
+
+  bool Boot();
+
+  System* GetSystem() const { return m_system.get(); }
+
+  std::optional<std::vector<u8>> GetBIOSImage(ConsoleRegion region) override;
+};
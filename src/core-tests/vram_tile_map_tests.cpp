@@ -0,0 +1,304 @@
+// Checks VRAMTileMap against the software renderer. A model of the hardware renderers' CPU shadow copy of VRAM is
+// kept up to date only through the tile map, the same way GPU_HW does it: GPU-side fills and copies mark their
+// destination, CPU writes go straight into the shadow copy unless they cross an edge of VRAM, in which case they're
+// done as a full round trip, and reads copy back the dirty tiles in the transfer bounds. The area read must then match
+// GPU_SW's VRAM, and the tile map must agree with a brute-force record of which tiles were marked.
+
+#include "common/log.h"
+#include "core/gpu_sw.h"
+#include "core/system.h"
+#include "core/vram_tile_map.h"
+#include "test_host_interface.h"
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+class ShadowModel
+{
+public:
+  ShadowModel(GPU_SW* gpu) : m_gpu(gpu), m_shadow(VRAM_WIDTH * VRAM_HEIGHT)
+  {
+    // Nothing has been read back yet.
+    m_tiles.SetAll();
+    m_expected_tiles.fill(true);
+  }
+
+  u32 GetFailureCount() const { return m_failures; }
+
+  void Fill(u32 x, u32 y, u32 width, u32 height, u32 color)
+  {
+    // GPU_SW doesn't handle fills past the edge of VRAM, so they're kept inside it.
+    WriteGP0(UINT32_C(0x02000000) | color);
+    WriteGP0((y << 16) | x);
+    WriteGP0((height << 16) | width);
+    Mark(Common::Rectangle<u32>::FromExtents(x, y, width, height));
+    CheckTiles("fill");
+  }
+
+  void Write(u32 x, u32 y, u32 width, u32 height, const std::vector<u16>& pixels)
+  {
+    const bool oversized = (x + width) > VRAM_WIDTH || (y + height) > VRAM_HEIGHT;
+    if (oversized)
+      ReadBack(Common::Rectangle<u32>(0, 0, VRAM_WIDTH, VRAM_HEIGHT));
+
+    WriteGP0(UINT32_C(0xA0000000));
+    WriteGP0((y << 16) | x);
+    WriteGP0(((height & 0x1FF) << 16) | (width & 0x3FF));
+    for (u32 i = 0; i < pixels.size(); i += 2)
+      WriteGP0(ZeroExtend32(pixels[i]) | (((i + 1) < pixels.size()) ? (ZeroExtend32(pixels[i + 1]) << 16) : 0));
+
+    if (oversized)
+    {
+      CopyFromGPU(x, y, width, height);
+    }
+    else
+    {
+      // Uploads go straight into the shadow copy, so they don't dirty it.
+      for (u32 row = 0; row < height; row++)
+        std::copy_n(&pixels[row * width], width, &m_shadow[(y + row) * VRAM_WIDTH + x]);
+    }
+
+    CheckTiles("write");
+  }
+
+  void Copy(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height)
+  {
+    // The GPU doesn't handle copies past the edge of VRAM.
+    WriteGP0(UINT32_C(0x80000000));
+    WriteGP0((src_y << 16) | src_x);
+    WriteGP0((dst_y << 16) | dst_x);
+    WriteGP0(((height & 0x1FF) << 16) | (width & 0x3FF));
+    Mark(Common::Rectangle<u32>::FromExtents(dst_x, dst_y, width, height));
+    CheckTiles("copy");
+  }
+
+  void Read(u32 x, u32 y, u32 width, u32 height)
+  {
+    ReadBack(VRAMTileMap::GetTransferBounds(x, y, width, height));
+    CheckTiles("read");
+
+    u32 mismatches = 0;
+    for (u32 row = 0; row < height; row++)
+    {
+      for (u32 col = 0; col < width; col++)
+      {
+        const u32 px = (x + col) % VRAM_WIDTH;
+        const u32 py = (y + row) % VRAM_HEIGHT;
+        if (m_shadow[py * VRAM_WIDTH + px] != m_gpu->GetPixel(px, py))
+          mismatches++;
+      }
+    }
+
+    if (mismatches > 0)
+    {
+      std::fprintf(stderr, "Read of (%u,%u) %ux%u: %u pixels in the shadow copy are stale\n", x, y, width, height,
+                   mismatches);
+      m_failures++;
+    }
+  }
+
+private:
+  enum : u32
+  {
+    VRAM_WIDTH = VRAMTileMap::VRAM_WIDTH,
+    VRAM_HEIGHT = VRAMTileMap::VRAM_HEIGHT,
+    TILE_WIDTH = VRAMTileMap::TILE_WIDTH,
+    TILE_HEIGHT = VRAMTileMap::TILE_HEIGHT,
+    NUM_TILES_X = VRAMTileMap::NUM_TILES_X,
+    NUM_TILES_Y = VRAMTileMap::NUM_TILES_Y
+  };
+
+  void WriteGP0(u32 value) { m_gpu->WriteRegister(0x00, value); }
+
+  void Mark(const Common::Rectangle<u32>& rc)
+  {
+    m_tiles.Set(rc);
+    for (u32 ty = 0; ty < NUM_TILES_Y; ty++)
+    {
+      for (u32 tx = 0; tx < NUM_TILES_X; tx++)
+      {
+        if (rc.left < ((tx + 1) * TILE_WIDTH) && rc.right > (tx * TILE_WIDTH) && rc.top < ((ty + 1) * TILE_HEIGHT) &&
+            rc.bottom > (ty * TILE_HEIGHT))
+        {
+          m_expected_tiles[ty * NUM_TILES_X + tx] = true;
+        }
+      }
+    }
+  }
+
+  // Copies the dirty tiles in the area from the GPU, as the hardware renderers' ReadVRAM() does.
+  void ReadBack(const Common::Rectangle<u32>& rc)
+  {
+    std::array<bool, NUM_TILES_X * NUM_TILES_Y> consumed = {};
+    m_tiles.Consume(rc, [this, &consumed](const Common::Rectangle<u32>& tile_rc) {
+      if ((tile_rc.left % TILE_WIDTH) != 0 || (tile_rc.right % TILE_WIDTH) != 0 || (tile_rc.top % TILE_HEIGHT) != 0 ||
+          (tile_rc.bottom % TILE_HEIGHT) != 0 || tile_rc.right > VRAM_WIDTH || tile_rc.bottom > VRAM_HEIGHT)
+      {
+        std::fprintf(stderr, "Consumed area (%u,%u)-(%u,%u) isn't tile-aligned\n", tile_rc.left, tile_rc.top,
+                     tile_rc.right, tile_rc.bottom);
+        m_failures++;
+        return;
+      }
+
+      for (u32 ty = tile_rc.top / TILE_HEIGHT; ty < tile_rc.bottom / TILE_HEIGHT; ty++)
+      {
+        for (u32 tx = tile_rc.left / TILE_WIDTH; tx < tile_rc.right / TILE_WIDTH; tx++)
+        {
+          if (consumed[ty * NUM_TILES_X + tx] || !m_expected_tiles[ty * NUM_TILES_X + tx])
+          {
+            std::fprintf(stderr, "Tile (%u,%u) was consumed when it wasn't dirty\n", tx, ty);
+            m_failures++;
+          }
+
+          consumed[ty * NUM_TILES_X + tx] = true;
+          m_expected_tiles[ty * NUM_TILES_X + tx] = false;
+        }
+      }
+
+      for (u32 row = tile_rc.top; row < tile_rc.bottom; row++)
+      {
+        for (u32 col = tile_rc.left; col < tile_rc.right; col++)
+          m_shadow[row * VRAM_WIDTH + col] = m_gpu->GetPixel(col, row);
+      }
+    });
+
+    // Every dirty tile overlapping the area has to be consumed.
+    for (u32 ty = 0; ty < NUM_TILES_Y; ty++)
+    {
+      for (u32 tx = 0; tx < NUM_TILES_X; tx++)
+      {
+        if (m_expected_tiles[ty * NUM_TILES_X + tx] && rc.left < ((tx + 1) * TILE_WIDTH) &&
+            rc.right > (tx * TILE_WIDTH) && rc.top < ((ty + 1) * TILE_HEIGHT) && rc.bottom > (ty * TILE_HEIGHT))
+        {
+          std::fprintf(stderr, "Dirty tile (%u,%u) wasn't consumed\n", tx, ty);
+          m_failures++;
+        }
+      }
+    }
+  }
+
+  // The CPU half of a round trip, which leaves the area in the shadow copy current.
+  void CopyFromGPU(u32 x, u32 y, u32 width, u32 height)
+  {
+    for (u32 row = 0; row < height; row++)
+    {
+      for (u32 col = 0; col < width; col++)
+      {
+        const u32 px = (x + col) % VRAM_WIDTH;
+        const u32 py = (y + row) % VRAM_HEIGHT;
+        m_shadow[py * VRAM_WIDTH + px] = m_gpu->GetPixel(px, py);
+      }
+    }
+  }
+
+  void CheckTiles(const char* operation)
+  {
+    for (u32 ty = 0; ty < NUM_TILES_Y; ty++)
+    {
+      for (u32 tx = 0; tx < NUM_TILES_X; tx++)
+      {
+        const bool dirty = m_tiles.Intersects(
+          Common::Rectangle<u32>::FromExtents(tx * TILE_WIDTH, ty * TILE_HEIGHT, TILE_WIDTH, TILE_HEIGHT));
+        if (dirty != m_expected_tiles[ty * NUM_TILES_X + tx])
+        {
+          std::fprintf(stderr, "After %s, tile (%u,%u) is %s but should be %s\n", operation, tx, ty,
+                       dirty ? "dirty" : "clean", dirty ? "clean" : "dirty");
+          m_failures++;
+        }
+      }
+    }
+  }
+
+  GPU_SW* m_gpu;
+  std::vector<u16> m_shadow;
+  VRAMTileMap m_tiles;
+  std::array<bool, NUM_TILES_X * NUM_TILES_Y> m_expected_tiles;
+  u32 m_failures = 0;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  Log::SetFilterLevel(LOGLEVEL_NONE);
+
+  TestHostInterface host_interface;
+  if (!host_interface.Boot())
+  {
+    std::fprintf(stderr, "Failed to boot system\n");
+    return EXIT_FAILURE;
+  }
+
+  GPU_SW* gpu = static_cast<GPU_SW*>(host_interface.GetSystem()->GetGPU());
+  ShadowModel model(gpu);
+  std::mt19937 rng(1234);
+  const auto random = [&rng](u32 min, u32 max) { return min + static_cast<u32>(rng() % (max - min + 1)); };
+
+  // Rectangles which wrap around both edges.
+  std::vector<u16> pixels(64 * 48);
+  for (u16& pixel : pixels)
+    pixel = static_cast<u16>(rng());
+  model.Write(1000, 500, 64, 48, pixels);
+  model.Copy(960, 0, 900, 460, 64, 48);
+  model.Read(990, 480, 100, 64);
+  model.Read(0, 0, 1024, 512);
+
+  for (u32 i = 0; i < 3000; i++)
+  {
+    switch (random(0, 3))
+    {
+      case 0:
+      {
+        const u32 x = random(0, 63) * 16;
+        const u32 width = random(1, 64 - (x / 16)) * 16;
+        const u32 y = random(0, 511);
+        const u32 height = random(1, 512 - y);
+        model.Fill(x, y, std::min<u32>(width, 1008), height, static_cast<u32>(rng()) & 0xFFFFFF);
+      }
+      break;
+
+      case 1:
+      {
+        const u32 width = random(1, 96);
+        const u32 height = random(1, 96);
+        pixels.resize(width * height);
+        for (u16& pixel : pixels)
+          pixel = static_cast<u16>(rng());
+        model.Write(random(0, 1023), random(0, 511), width, height, pixels);
+      }
+      break;
+
+      case 2:
+      {
+        const u32 width = random(1, 200);
+        const u32 height = random(1, 150);
+        model.Copy(random(0, 1024 - width), random(0, 512 - height), random(0, 1024 - width), random(0, 512 - height),
+                   width, height);
+      }
+      break;
+
+      case 3:
+        model.Read(random(0, 1023), random(0, 511), random(1, 300), random(1, 200));
+        break;
+    }
+
+    if (model.GetFailureCount() > 0)
+      break;
+  }
+
+  if (model.GetFailureCount() == 0)
+    model.Read(0, 0, 1024, 512);
+
+  if (model.GetFailureCount() > 0)
+  {
+    std::fprintf(stderr, "FAILED: %u errors\n", model.GetFailureCount());
+    return EXIT_FAILURE;
+  }
+
+  std::printf("VRAM tile map matches the software renderer\n");
+  return EXIT_SUCCESS;
+}
@@ -166,18 +166,20 @@ TickCount Bus::WriteWords(PhysicalMemoryAddress address, const u32* words, u32 w
     return total_ticks;
   }
 
-  const u32 start_page = address / CPU_CODE_CACHE_PAGE_SIZE;
-  const u32 end_page = (address + word_count * sizeof(u32)) / CPU_CODE_CACHE_PAGE_SIZE;
-  for (u32 page = start_page; page <= end_page; page++)
-  {
-    if (m_ram_code_bits[page])
-      DoInvalidateCodeCache(page);
-  }
-
+  InvalidateCodeCacheRange(address, word_count * sizeof(u32));
   std::memcpy(&m_ram[address], words, sizeof(u32) * word_count);
   return static_cast<TickCount>(word_count + ((word_count + 15) / 16));
 }
 
+u32* Bus::GetRAMWordPointerForWrite(PhysicalMemoryAddress address, u32 word_count)
+{
+  if ((address + (word_count * sizeof(u32))) > (RAM_BASE + RAM_SIZE))
+    return nullptr;
+
+  InvalidateCodeCacheRange(address, word_count * sizeof(u32));
+  return reinterpret_cast<u32*>(&m_ram[address]);
+}
+
 void Bus::SetExpansionROM(std::vector<u8> data)
 {
   m_exp1_rom = std::move(data);
@@ -532,6 +534,20 @@ void Bus::DoInvalidateCodeCache(u32 page_index)
   m_cpu_code_cache->InvalidateBlocksWithPageIndex(page_index);
 }
 
+void Bus::InvalidateCodeCacheRange(PhysicalMemoryAddress address, u32 size)
+{
+  if (size == 0)
+    return;
+
+  const u32 start_page = address / CPU_CODE_CACHE_PAGE_SIZE;
+  const u32 end_page = (address + size - 1) / CPU_CODE_CACHE_PAGE_SIZE;
+  for (u32 page = start_page; page <= end_page; page++)
+  {
+    if (m_ram_code_bits[page])
+      DoInvalidateCodeCache(page);
+  }
+}
+
 u32 Bus::DoReadDMA(MemoryAccessSize size, u32 offset)
 {
   return FIXUP_WORD_READ_VALUE(offset, m_dma->ReadRegister(FIXUP_WORD_READ_OFFSET(offset)));
@@ -49,6 +49,19 @@ public:
   TickCount ReadWords(PhysicalMemoryAddress address, u32* words, u32 word_count);
   TickCount WriteWords(PhysicalMemoryAddress address, const u32* words, u32 word_count);
 
+  /// Returns a pointer to word_count words of RAM at address, or nullptr if the range is not contiguous in RAM.
+  ALWAYS_INLINE const u32* GetRAMWordPointer(PhysicalMemoryAddress address, u32 word_count) const
+  {
+    if ((address + (word_count * sizeof(u32))) > (RAM_BASE + RAM_SIZE))
+      return nullptr;
+
+    return reinterpret_cast<const u32*>(&m_ram[address]);
+  }
+
+  /// Returns a writable pointer to word_count words of RAM at address, or nullptr if the range is not contiguous in
+  /// RAM. Any code compiled from the range is invalidated, since the caller is about to overwrite it.
+  u32* GetRAMWordPointerForWrite(PhysicalMemoryAddress address, u32 word_count);
+
   void SetExpansionROM(std::vector<u8> data);
   void SetBIOS(const std::vector<u8>& image);
 
@@ -242,6 +255,7 @@ private:
   void DoWriteSPU(MemoryAccessSize size, u32 offset, u32 value);
 
   void DoInvalidateCodeCache(u32 page_index);
+  void InvalidateCodeCacheRange(PhysicalMemoryAddress address, u32 size);
 
   CPU::Core* m_cpu = nullptr;
   CPU::CodeCache* m_cpu_code_cache = nullptr;
@@ -262,7 +276,7 @@ private:
   std::array<TickCount, 3> m_spu_access_time = {};
 
   std::bitset<CPU_CODE_CACHE_PAGE_COUNT> m_ram_code_bits{};
-  std::array<u8, RAM_SIZE> m_ram{};   // 2MB RAM
+  alignas(16) std::array<u8, RAM_SIZE> m_ram{}; // 2MB RAM
   std::array<u8, BIOS_SIZE> m_bios{}; // 512K BIOS ROM
   std::vector<u8> m_exp1_rom;
 
@@ -1,5 +1,6 @@
 #include "cdrom.h"
 #include "common/cd_image.h"
+#include "common/cpu_detect.h"
 #include "common/log.h"
 #include "common/state_wrapper.h"
 #include "dma.h"
@@ -7,6 +8,11 @@
 #include "interrupt_controller.h"
 #include "spu.h"
 #include "system.h"
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#elif defined(CPU_AARCH64)
+#include <arm_neon.h>
+#endif
 Log_SetChannel(CDROM);
 
 CDROM::CDROM()
@@ -1019,6 +1025,7 @@ void CDROM::BeginReading(TickCount ticks_late)
   m_sector_buffer.clear();
 
   const TickCount ticks = GetTicksForRead();
+  m_media->SetReadSpeed(m_mode.double_speed ? 150 : 75);
   m_drive_state = DriveState::Reading;
   m_drive_event->SetInterval(ticks);
   m_drive_event->Schedule(ticks - ticks_late);
@@ -1057,6 +1064,7 @@ void CDROM::BeginPlaying(u8 track_bcd, TickCount ticks_late)
   m_sector_buffer.clear();
 
   const TickCount ticks = GetTicksForRead();
+  m_media->SetReadSpeed(m_mode.double_speed ? 150 : 75);
   m_drive_state = DriveState::Playing;
   m_drive_event->SetInterval(ticks);
   m_drive_event->Schedule(ticks - ticks_late);
@@ -1120,8 +1128,9 @@ void CDROM::DoSeekComplete(TickCount ticks_late)
     // check for data header for logical seeks
     if (logical)
     {
-      u8 raw_sector[CDImage::RAW_SECTOR_SIZE];
-      seek_okay &= m_media->ReadRawSector(raw_sector);
+      u8 raw_sector_buffer[CDImage::RAW_SECTOR_SIZE];
+      const u8* raw_sector = m_media->ReadRawSectorPointer(raw_sector_buffer);
+      seek_okay &= (raw_sector != nullptr);
       seek_okay &= m_media->Seek(m_media->GetPositionOnDisc() - 1);
       if (seek_okay)
       {
@@ -1258,8 +1267,10 @@ void CDROM::DoSectorRead()
     }
   }
 
-  u8 raw_sector[CDImage::RAW_SECTOR_SIZE];
-  if (!m_media->ReadRawSector(raw_sector))
+  // Mapped images give us the sector in place, so it's only copied if it's delivered to the CPU.
+  u8 raw_sector_buffer[CDImage::RAW_SECTOR_SIZE];
+  const u8* raw_sector = m_media->ReadRawSectorPointer(raw_sector_buffer);
+  if (!raw_sector)
     Panic("Sector read failed");
 
   if (subq.IsCRCValid())
@@ -1363,7 +1374,7 @@ void CDROM::ProcessDataSector(const u8* raw_sector, const CDImage::SubChannelQ&
   SetAsyncInterrupt(Interrupt::INT1);
 }
 
-static std::array<std::array<s16, 29>, 7> s_zigzag_table = {
+static constexpr std::array<std::array<s16, 29>, 7> s_zigzag_table = {
   {{0,      0x0,     0x0,     0x0,    0x0,     -0x0002, 0x000A,  -0x0022, 0x0041, -0x0054,
     0x0034, 0x0009,  -0x010A, 0x0400, -0x0A78, 0x234C,  0x6794,  -0x1780, 0x0BCD, -0x0623,
     0x0350, -0x016D, 0x006B,  0x000A, -0x0010, 0x0011,  -0x0008, 0x0003,  -0x0001},
@@ -1386,13 +1397,69 @@ static std::array<std::array<s16, 29>, 7> s_zigzag_table = {
     0x3C07,  0x53E0,  -0x16FA, 0x0AFA, -0x0548, 0x027B,  -0x00EB, 0x001A,  0x002B, -0x0023,
     0x0010,  -0x0008, 0x0002,  0x0,    0x0,     0x0,     0x0,     0x0,     0x0}}};
 
-static s16 ZigZagInterpolate(const s16* ringbuf, const s16* table, u8 p)
+// The resampler reads the last 32 samples. The first tap applies to the oldest sample, and the rest apply to the
+// newest sample and go back from there. Laying the taps out oldest-first means each output is a dot product with 32
+// consecutive samples.
+static constexpr u32 ZIGZAG_WINDOW_SIZE = 32;
+using ZigZagTaps = std::array<s16, ZIGZAG_WINDOW_SIZE>;
+
+static constexpr std::array<ZigZagTaps, 7> MakeZigZagTaps()
 {
-  s32 sum = 0;
-  for (u8 i = 0; i < 29; i++)
-    sum += (s32(ringbuf[(p - i) & 0x1F]) * s32(table[i])) / 0x8000;
+  std::array<ZigZagTaps, 7> taps = {};
+  for (u32 i = 0; i < 7; i++)
+  {
+    taps[i][0] = s_zigzag_table[i][0];
+    for (u32 j = 1; j < 29; j++)
+      taps[i][ZIGZAG_WINDOW_SIZE - j] = s_zigzag_table[i][j];
+  }
+
+  return taps;
+}
+
+alignas(16) static constexpr std::array<ZigZagTaps, 7> s_zigzag_taps = MakeZigZagTaps();
+
+static s16 ZigZagInterpolate(const s16* samples, const s16* taps)
+{
+  // Each product is divided (rounding towards zero) before summing, to match the hardware.
+#if defined(CPU_X64)
+  const __m128i round_mask = _mm_set1_epi32(0x7FFF);
+  __m128i sum = _mm_setzero_si128();
+  for (u32 i = 0; i < ZIGZAG_WINDOW_SIZE; i += 8)
+  {
+    const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&samples[i]));
+    const __m128i t = _mm_load_si128(reinterpret_cast<const __m128i*>(&taps[i]));
+    const __m128i lo = _mm_mullo_epi16(s, t);
+    const __m128i hi = _mm_mulhi_epi16(s, t);
+    const __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+    const __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+    sum = _mm_add_epi32(sum, _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), round_mask)), 15));
+    sum = _mm_add_epi32(sum, _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), round_mask)), 15));
+  }
+
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  const s32 result = _mm_cvtsi128_si32(sum);
+#elif defined(CPU_AARCH64)
+  const int32x4_t round_mask = vdupq_n_s32(0x7FFF);
+  int32x4_t sum = vdupq_n_s32(0);
+  for (u32 i = 0; i < ZIGZAG_WINDOW_SIZE; i += 8)
+  {
+    const int16x8_t s = vld1q_s16(&samples[i]);
+    const int16x8_t t = vld1q_s16(&taps[i]);
+    const int32x4_t p0 = vmull_s16(vget_low_s16(s), vget_low_s16(t));
+    const int32x4_t p1 = vmull_high_s16(s, t);
+    sum = vaddq_s32(sum, vshrq_n_s32(vaddq_s32(p0, vandq_s32(vshrq_n_s32(p0, 31), round_mask)), 15));
+    sum = vaddq_s32(sum, vshrq_n_s32(vaddq_s32(p1, vandq_s32(vshrq_n_s32(p1, 31), round_mask)), 15));
+  }
+
+  const s32 result = vaddvq_s32(sum);
+#else
+  s32 result = 0;
+  for (u32 i = 0; i < ZIGZAG_WINDOW_SIZE; i++)
+    result += (s32(samples[i]) * s32(taps[i])) / 0x8000;
+#endif
 
-  return static_cast<s16>(std::clamp<s32>(sum, -0x8000, 0x7FFF));
+  return static_cast<s16>(std::clamp<s32>(result, -0x8000, 0x7FFF));
 }
 
 static constexpr s32 ApplyVolume(s16 sample, u8 volume)
@@ -1405,45 +1472,135 @@ static constexpr s16 SaturateVolume(s32 volume)
   return static_cast<s16>(std::clamp<s32>(volume, -0x8000, 0x7FFF));
 }
 
+// Most input samples for one sector, mono at half rate, and the frames that produces.
+static constexpr u32 XA_RESAMPLE_MAX_INPUT_SAMPLES = CDXA::XA_ADPCM_SAMPLES_PER_SECTOR_4BIT * 2;
+static constexpr u32 XA_RESAMPLE_MAX_OUTPUT_FRAMES = ((XA_RESAMPLE_MAX_INPUT_SAMPLES + 5) / 6) * 7;
+
 template<bool STEREO, bool SAMPLE_RATE>
-static void ResampleXAADPCM(const s16* samples_in, u32 num_samples_in, SPU* spu, s16* left_ringbuf, s16* right_ringbuf,
-                            u8* p_ptr, u8* sixstep_ptr, const std::array<std::array<u8, 2>, 2>& volume_matrix)
+static u32 ResampleXAADPCMSector(const s16* samples_in, u32 num_samples_in, s16* frames_out, s16* left_ringbuf,
+                                 s16* right_ringbuf, u8* p_ptr, u8* sixstep_ptr,
+                                 const std::array<std::array<u8, 2>, 2>& volume_matrix)
 {
-  u8 p = *p_ptr;
-  u8 sixstep = *sixstep_ptr;
+  // Lay the history and the new samples out in order, so the samples for each output are contiguous.
+  constexpr u32 DUP = SAMPLE_RATE ? 2 : 1;
+  const u32 num_inputs = num_samples_in * DUP;
+  std::array<s16, ZIGZAG_WINDOW_SIZE + XA_RESAMPLE_MAX_INPUT_SAMPLES> left;
+  std::array<s16, STEREO ? (ZIGZAG_WINDOW_SIZE + XA_RESAMPLE_MAX_INPUT_SAMPLES) : 1> right;
+  const u8 p = *p_ptr;
+  for (u32 i = 0; i < ZIGZAG_WINDOW_SIZE; i++)
+  {
+    left[i] = left_ringbuf[(p + i) % ZIGZAG_WINDOW_SIZE];
+    if constexpr (STEREO)
+      right[i] = right_ringbuf[(p + i) % ZIGZAG_WINDOW_SIZE];
+  }
 
-  for (u32 in_sample_index = 0; in_sample_index < num_samples_in; in_sample_index++)
+  for (u32 i = 0; i < num_samples_in; i++)
   {
-    const s16 left = *(samples_in++);
-    const s16 right = STEREO ? *(samples_in++) : left;
+    for (u32 j = 0; j < DUP; j++)
+    {
+      left[ZIGZAG_WINDOW_SIZE + i * DUP + j] = samples_in[i * (STEREO ? 2 : 1)];
+      if constexpr (STEREO)
+        right[ZIGZAG_WINDOW_SIZE + i * DUP + j] = samples_in[i * 2 + 1];
+    }
+  }
 
-    if constexpr (!STEREO)
+  // Seven frames are output after every sixth input, using the 32 samples before that point.
+  const u8 sixstep = *sixstep_ptr;
+  u32 num_frames = 0;
+  for (u32 input = sixstep; input <= num_inputs; input += 6)
+  {
+    for (u32 j = 0; j < 7; j++)
     {
-      UNREFERENCED_VARIABLE(right);
+      const s16 left_interp = ZigZagInterpolate(&left[input], s_zigzag_taps[j].data());
+      const s16 right_interp = STEREO ? ZigZagInterpolate(&right[input], s_zigzag_taps[j].data()) : left_interp;
+
+      frames_out[0] = SaturateVolume(ApplyVolume(left_interp, volume_matrix[0][0]) +
+                                     ApplyVolume(right_interp, volume_matrix[1][0]));
+      frames_out[1] = SaturateVolume(ApplyVolume(left_interp, volume_matrix[1][0]) +
+                                     ApplyVolume(right_interp, volume_matrix[1][1]));
+      frames_out += 2;
     }
 
-    for (u32 sample_dup = 0; sample_dup < (SAMPLE_RATE ? 2 : 1); sample_dup++)
+    num_frames += 7;
+  }
+
+  // Keep the last 32 samples for the next sector.
+  const u8 new_p = static_cast<u8>((p + num_inputs) % ZIGZAG_WINDOW_SIZE);
+  for (u32 i = 0; i < ZIGZAG_WINDOW_SIZE; i++)
+  {
+    left_ringbuf[(new_p + i) % ZIGZAG_WINDOW_SIZE] = left[num_inputs + i];
+    if constexpr (STEREO)
+      right_ringbuf[(new_p + i) % ZIGZAG_WINDOW_SIZE] = right[num_inputs + i];
+  }
+
+  *p_ptr = new_p;
+  *sixstep_ptr = static_cast<u8>((((sixstep - 1) + 6 - (num_inputs % 6)) % 6) + 1);
+  return num_frames;
+}
+
+u32 CDROM::ResampleXAADPCM(const s16* samples_in, u32 num_samples_in, bool stereo, bool half_sample_rate,
+                           s16* frames_out, s16* left_ringbuf, s16* right_ringbuf, u8* p, u8* sixstep,
+                           const std::array<std::array<u8, 2>, 2>& volume_matrix)
+{
+  if (stereo)
+  {
+    return half_sample_rate ? ResampleXAADPCMSector<true, true>(samples_in, num_samples_in, frames_out, left_ringbuf,
+                                                                right_ringbuf, p, sixstep, volume_matrix) :
+                              ResampleXAADPCMSector<true, false>(samples_in, num_samples_in, frames_out, left_ringbuf,
+                                                                 right_ringbuf, p, sixstep, volume_matrix);
+  }
+  else
+  {
+    return half_sample_rate ? ResampleXAADPCMSector<false, true>(samples_in, num_samples_in, frames_out, left_ringbuf,
+                                                                 right_ringbuf, p, sixstep, volume_matrix) :
+                              ResampleXAADPCMSector<false, false>(samples_in, num_samples_in, frames_out, left_ringbuf,
+                                                                  right_ringbuf, p, sixstep, volume_matrix);
+  }
+}
+
+u32 CDROM::ResampleXAADPCMReference(const s16* samples_in, u32 num_samples_in, bool stereo, bool half_sample_rate,
+                                    s16* frames_out, s16* left_ringbuf, s16* right_ringbuf, u8* p_ptr, u8* sixstep_ptr,
+                                    const std::array<std::array<u8, 2>, 2>& volume_matrix)
+{
+  // Each sample goes into the ring buffers in turn, and the filter is applied to the ring buffer directly.
+  const auto interpolate = [](const s16* ringbuf, const s16* table, u8 p) {
+    s32 sum = 0;
+    for (u8 i = 0; i < XA_RESAMPLE_ZIGZAG_TABLE_SIZE; i++)
+      sum += (s32(ringbuf[(p - i) & 0x1F]) * s32(table[i])) / 0x8000;
+
+    return static_cast<s16>(std::clamp<s32>(sum, -0x8000, 0x7FFF));
+  };
+
+  u8 p = *p_ptr;
+  u8 sixstep = *sixstep_ptr;
+  u32 num_frames = 0;
+  for (u32 in_sample_index = 0; in_sample_index < num_samples_in; in_sample_index++)
+  {
+    const s16 left = *(samples_in++);
+    const s16 right = stereo ? *(samples_in++) : left;
+
+    for (u32 sample_dup = 0; sample_dup < (half_sample_rate ? 2u : 1u); sample_dup++)
     {
       left_ringbuf[p] = left;
-      if constexpr (STEREO)
+      if (stereo)
         right_ringbuf[p] = right;
-      p = (p + 1) % 32;
+      p = (p + 1) % XA_RESAMPLE_RING_BUFFER_SIZE;
       sixstep--;
 
       if (sixstep == 0)
       {
         sixstep = 6;
-        for (u32 j = 0; j < 7; j++)
+        for (u32 j = 0; j < XA_RESAMPLE_NUM_ZIGZAG_TABLES; j++)
         {
-          const s16 left_interp = ZigZagInterpolate(left_ringbuf, s_zigzag_table[j].data(), p);
-          const s16 right_interp = STEREO ? ZigZagInterpolate(right_ringbuf, s_zigzag_table[j].data(), p) : left_interp;
-
-          const s16 left_out = SaturateVolume(ApplyVolume(left_interp, volume_matrix[0][0]) +
-                                              ApplyVolume(right_interp, volume_matrix[1][0]));
-          const s16 right_out = SaturateVolume(ApplyVolume(left_interp, volume_matrix[1][0]) +
-                                               ApplyVolume(right_interp, volume_matrix[1][1]));
-
-          spu->AddCDAudioSample(left_out, right_out);
+          const s16 left_interp = interpolate(left_ringbuf, s_zigzag_table[j].data(), p);
+          const s16 right_interp = stereo ? interpolate(right_ringbuf, s_zigzag_table[j].data(), p) : left_interp;
+
+          frames_out[0] = SaturateVolume(ApplyVolume(left_interp, volume_matrix[0][0]) +
+                                         ApplyVolume(right_interp, volume_matrix[1][0]));
+          frames_out[1] = SaturateVolume(ApplyVolume(left_interp, volume_matrix[1][0]) +
+                                         ApplyVolume(right_interp, volume_matrix[1][1]));
+          frames_out += 2;
+          num_frames++;
         }
       }
     }
@@ -1451,6 +1608,7 @@ static void ResampleXAADPCM(const s16* samples_in, u32 num_samples_in, SPU* spu,
 
   *p_ptr = p;
   *sixstep_ptr = sixstep;
+  return num_frames;
 }
 
 void CDROM::ProcessXAADPCMSector(const u8* raw_sector, const CDImage::SubChannelQ& subq)
@@ -1462,42 +1620,15 @@ void CDROM::ProcessXAADPCMSector(const u8* raw_sector, const CDImage::SubChannel
   if (m_muted || m_adpcm_muted)
     return;
 
-  if (m_last_sector_subheader.codinginfo.IsStereo())
-  {
-    const u32 num_samples = m_last_sector_subheader.codinginfo.GetSamplesPerSector() / 2;
-    m_spu->EnsureCDAudioSpace(num_samples);
+  std::array<s16, XA_RESAMPLE_MAX_OUTPUT_FRAMES * 2> frame_buffer;
+  const bool stereo = m_last_sector_subheader.codinginfo.IsStereo();
+  const u32 num_samples = m_last_sector_subheader.codinginfo.GetSamplesPerSector() / (stereo ? 2 : 1);
+  const u32 num_frames =
+    ResampleXAADPCM(sample_buffer.data(), num_samples, stereo, m_last_sector_subheader.codinginfo.IsHalfSampleRate(),
+                    frame_buffer.data(), m_xa_resample_ring_buffer[0].data(), m_xa_resample_ring_buffer[1].data(),
+                    &m_xa_resample_p, &m_xa_resample_sixstep, m_cd_audio_volume_matrix);
 
-    if (m_last_sector_subheader.codinginfo.IsHalfSampleRate())
-    {
-      ResampleXAADPCM<true, true>(sample_buffer.data(), num_samples, m_spu, m_xa_resample_ring_buffer[0].data(),
-                                  m_xa_resample_ring_buffer[1].data(), &m_xa_resample_p, &m_xa_resample_sixstep,
-                                  m_cd_audio_volume_matrix);
-    }
-    else
-    {
-      ResampleXAADPCM<true, false>(sample_buffer.data(), num_samples, m_spu, m_xa_resample_ring_buffer[0].data(),
-                                   m_xa_resample_ring_buffer[1].data(), &m_xa_resample_p, &m_xa_resample_sixstep,
-                                   m_cd_audio_volume_matrix);
-    }
-  }
-  else
-  {
-    const u32 num_samples = m_last_sector_subheader.codinginfo.GetSamplesPerSector();
-    m_spu->EnsureCDAudioSpace(num_samples);
-
-    if (m_last_sector_subheader.codinginfo.IsHalfSampleRate())
-    {
-      ResampleXAADPCM<false, true>(sample_buffer.data(), num_samples, m_spu, m_xa_resample_ring_buffer[0].data(),
-                                   m_xa_resample_ring_buffer[1].data(), &m_xa_resample_p, &m_xa_resample_sixstep,
-                                   m_cd_audio_volume_matrix);
-    }
-    else
-    {
-      ResampleXAADPCM<false, false>(sample_buffer.data(), num_samples, m_spu, m_xa_resample_ring_buffer[0].data(),
-                                    m_xa_resample_ring_buffer[1].data(), &m_xa_resample_p, &m_xa_resample_sixstep,
-                                    m_cd_audio_volume_matrix);
-    }
-  }
+  m_spu->AddCDAudioFrames(frame_buffer.data(), num_frames);
 }
 
 void CDROM::ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ& subq)
@@ -1545,22 +1676,21 @@ void CDROM::ProcessCDDASector(const u8* raw_sector, const CDImage::SubChannelQ&
 
   constexpr bool is_stereo = true;
   constexpr u32 num_samples = RAW_SECTOR_OUTPUT_SIZE / sizeof(s16) / (is_stereo ? 2 : 1);
-  m_spu->EnsureCDAudioSpace(num_samples);
 
-  const u8* sector_ptr = raw_sector;
+  // NOTE: assumes LE
+  std::array<s16, num_samples * 2> frame_buffer;
+  std::memcpy(frame_buffer.data(), raw_sector, sizeof(frame_buffer));
   for (u32 i = 0; i < num_samples; i++)
   {
-    s16 samp_left, samp_right;
-    std::memcpy(&samp_left, sector_ptr, sizeof(samp_left));
-    std::memcpy(&samp_right, sector_ptr + sizeof(s16), sizeof(samp_right));
-    sector_ptr += sizeof(s16) * 2;
-
-    const s16 left = SaturateVolume(ApplyVolume(samp_left, m_cd_audio_volume_matrix[0][0]) +
-                                    ApplyVolume(samp_right, m_cd_audio_volume_matrix[0][1]));
-    const s16 right = SaturateVolume(ApplyVolume(samp_left, m_cd_audio_volume_matrix[1][0]) +
-                                     ApplyVolume(samp_right, m_cd_audio_volume_matrix[1][1]));
-    m_spu->AddCDAudioSample(left, right);
+    const s16 samp_left = frame_buffer[i * 2];
+    const s16 samp_right = frame_buffer[i * 2 + 1];
+    frame_buffer[i * 2] = SaturateVolume(ApplyVolume(samp_left, m_cd_audio_volume_matrix[0][0]) +
+                                         ApplyVolume(samp_right, m_cd_audio_volume_matrix[0][1]));
+    frame_buffer[i * 2 + 1] = SaturateVolume(ApplyVolume(samp_left, m_cd_audio_volume_matrix[1][0]) +
+                                             ApplyVolume(samp_right, m_cd_audio_volume_matrix[1][1]));
   }
+
+  m_spu->AddCDAudioFrames(frame_buffer.data(), num_samples);
 }
 
 void CDROM::LoadDataFIFO()
@@ -1572,8 +1702,11 @@ void CDROM::LoadDataFIFO()
     return;
   }
 
+  // the FIFO is empty, so the whole sector fits without wrapping
+  const u32 size = static_cast<u32>(m_sector_buffer.size());
   m_data_fifo.Clear();
-  m_data_fifo.PushRange(m_sector_buffer.data(), static_cast<u32>(m_sector_buffer.size()));
+  std::memcpy(m_data_fifo.GetBackPointer(), m_sector_buffer.data(), size);
+  m_data_fifo.CommitPush(size);
   m_sector_buffer.clear();
 
   Log_DebugPrintf("Loaded %u bytes to data FIFO", m_data_fifo.GetSize());
@@ -40,6 +40,18 @@ public:
   // Render statistics debug window.
   void DrawDebugWindow();
 
+  /// Resamples a sector of decoded XA-ADPCM samples (interleaved if stereo) to 44.1KHz with the zigzag filter, and
+  /// mixes it to stereo frames with the volume matrix. The ring buffers, p and sixstep carry state between sectors.
+  /// Returns the number of frames written.
+  static u32 ResampleXAADPCM(const s16* samples_in, u32 num_samples_in, bool stereo, bool half_sample_rate,
+                             s16* frames_out, s16* left_ringbuf, s16* right_ringbuf, u8* p, u8* sixstep,
+                             const std::array<std::array<u8, 2>, 2>& volume_matrix);
+
+  /// Per-sample version of ResampleXAADPCM(), which the vectorised one must match exactly.
+  static u32 ResampleXAADPCMReference(const s16* samples_in, u32 num_samples_in, bool stereo, bool half_sample_rate,
+                                      s16* frames_out, s16* left_ringbuf, s16* right_ringbuf, u8* p, u8* sixstep,
+                                      const std::array<std::array<u8, 2>, 2>& volume_matrix);
+
 private:
   enum : u32
   {
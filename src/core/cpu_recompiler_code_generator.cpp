@@ -1684,7 +1684,25 @@ Value CodeGenerator::DoGTERegisterRead(u32 index)
     case 28: // IRGB
     case 29: // ORGB
     {
-      EmitFunctionCall(&value, &Thunks::ReadGTERegister, m_register_cache.GetCPUPtr(), Value::FromConstantU32(index));
+      // ORGB register, convert 16-bit to 555, clamping each of IR1-3 / 80h to 00h..1Fh
+      Value result = Value::FromConstantU32(0);
+      for (u32 i = 0; i < 3; i++)
+      {
+        Value ir = m_register_cache.AllocateScratch(RegSize_32);
+        EmitLoadCPUStructField(ir.host_reg, RegSize_32, offsetof(Core, m_cop2.m_regs.r32[9]) + (i * sizeof(u32)));
+
+        // the shift rounds negative values towards -inf rather than zero, but they're clamped to zero anyway
+        Value component = SarValues(ir, Value::FromConstantU32(7));
+        component = AndValues(component, NotValue(SarValues(component, Value::FromConstantU32(31))));
+
+        // component - 1Fh is only negative when it's in range
+        Value excess = SubValues(component, Value::FromConstantU32(0x1F), false);
+        excess = AndValues(excess, SarValues(excess, Value::FromConstantU32(31)));
+        component = AddValues(excess, Value::FromConstantU32(0x1F), false);
+        result = OrValues(result, ShlValues(component, Value::FromConstantU32(i * 5)));
+      }
+
+      EmitCopyValue(value.host_reg, result);
     }
     break;
 
@@ -1757,7 +1775,34 @@ void CodeGenerator::DoGTERegisterWrite(u32 index, const Value& value)
     break;
 
     case 28: // IRGB
+    {
+      // IRGB register, convert 555 to 16-bit. The results are at most F80h, so there's nothing to sign-extend.
+      EmitStoreCPUStructField(offsetof(Core, m_cop2.m_regs.r32[28]), AndValues(value, Value::FromConstantU32(0x7FFF)));
+      for (u32 i = 0; i < 3; i++)
+      {
+        Value component = AndValues(ShrValues(value, Value::FromConstantU32(i * 5)), Value::FromConstantU32(0x1F));
+        EmitStoreCPUStructField(offsetof(Core, m_cop2.m_regs.r32[9]) + (i * sizeof(u32)),
+                                ShlValues(component, Value::FromConstantU32(7)));
+      }
+      return;
+    }
+
     case 30: // LZCS
+    {
+      EmitStoreCPUStructField(offsetof(Core, m_cop2.m_regs.r32[30]), value);
+
+      // LZCR counts the leading bits which match the sign bit, so flip negative values to count zeros instead.
+      // Shifting in a low one bit keeps the value non-zero, and the count comes out one short.
+      Value bits = XorValues(value, SarValues(value, Value::FromConstantU32(31)));
+      bits = GetValueInHostRegister(OrValues(ShlValues(bits, Value::FromConstantU32(1)), Value::FromConstantU32(1)));
+
+      Value count = m_register_cache.AllocateScratch(RegSize_32);
+      EmitCountLeadingZeros(count.host_reg, bits.host_reg);
+      EmitStoreCPUStructField(offsetof(Core, m_cop2.m_regs.r32[31]),
+                              AddValues(count, Value::FromConstantU32(1), false));
+      return;
+    }
+
     case 63: // FLAG
     {
       EmitFunctionCall(nullptr, &Thunks::WriteGTERegister, m_register_cache.GetCPUPtr(), Value::FromConstantU32(index),
@@ -1841,11 +1886,48 @@ bool CodeGenerator::Compile_cop2(const CodeBlockInstruction& cbi)
   }
   else
   {
-    // forward everything to the GTE.
     InstructionPrologue(cbi, 1);
 
-    Value instruction_bits = Value::FromConstantU32(cbi.instruction.bits & GTE::Instruction::REQUIRED_BITS_MASK);
-    EmitFunctionCall(nullptr, &Thunks::ExecuteGTEInstruction, m_register_cache.GetCPUPtr(), instruction_bits);
+    // The most common commands are called directly, with the sf/lm bits decoded here rather than at runtime.
+    const GTE::Instruction inst{cbi.instruction.bits};
+    const u32 variant = (BoolToUInt32(inst.sf != 0) << 1) | BoolToUInt32(inst.lm);
+    static constexpr std::array<void (*)(Core*), 4> rtps_functions = {
+      {&Thunks::ExecuteGTE_RTPS<false, false>, &Thunks::ExecuteGTE_RTPS<false, true>,
+       &Thunks::ExecuteGTE_RTPS<true, false>, &Thunks::ExecuteGTE_RTPS<true, true>}};
+    static constexpr std::array<void (*)(Core*), 4> rtpt_functions = {
+      {&Thunks::ExecuteGTE_RTPT<false, false>, &Thunks::ExecuteGTE_RTPT<false, true>,
+       &Thunks::ExecuteGTE_RTPT<true, false>, &Thunks::ExecuteGTE_RTPT<true, true>}};
+
+    switch (inst.command)
+    {
+      case 0x01: // RTPS
+        EmitFunctionCall(nullptr, rtps_functions[variant], m_register_cache.GetCPUPtr());
+        break;
+
+      case 0x06: // NCLIP
+        EmitFunctionCall(nullptr, &Thunks::ExecuteGTE_NCLIP, m_register_cache.GetCPUPtr());
+        break;
+
+      case 0x2D: // AVSZ3
+        EmitFunctionCall(nullptr, &Thunks::ExecuteGTE_AVSZ3, m_register_cache.GetCPUPtr());
+        break;
+
+      case 0x2E: // AVSZ4
+        EmitFunctionCall(nullptr, &Thunks::ExecuteGTE_AVSZ4, m_register_cache.GetCPUPtr());
+        break;
+
+      case 0x30: // RTPT
+        EmitFunctionCall(nullptr, rtpt_functions[variant], m_register_cache.GetCPUPtr());
+        break;
+
+      default:
+      {
+        // forward everything else to the GTE.
+        Value instruction_bits = Value::FromConstantU32(cbi.instruction.bits & GTE::Instruction::REQUIRED_BITS_MASK);
+        EmitFunctionCall(nullptr, &Thunks::ExecuteGTEInstruction, m_register_cache.GetCPUPtr(), instruction_bits);
+      }
+      break;
+    }
 
     InstructionEpilogue(cbi);
     return true;
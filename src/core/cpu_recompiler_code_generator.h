@@ -51,6 +51,7 @@ public:
   void EmitXor(HostReg to_reg, HostReg from_reg, const Value& value);
   void EmitTest(HostReg to_reg, const Value& value);
   void EmitNot(HostReg to_reg, RegSize size);
+  void EmitCountLeadingZeros(HostReg to_reg, HostReg from_reg); // 32-bit, from_reg must be non-zero
   void EmitSetConditionResult(HostReg to_reg, RegSize to_size, Condition condition);
 
   void EmitLoadGuestRegister(HostReg host_reg, Reg guest_reg);
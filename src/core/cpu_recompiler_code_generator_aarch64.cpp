@@ -820,6 +820,11 @@ void CodeGenerator::EmitNot(HostReg to_reg, RegSize size)
   }
 }
 
+void CodeGenerator::EmitCountLeadingZeros(HostReg to_reg, HostReg from_reg)
+{
+  m_emit->clz(GetHostReg32(to_reg), GetHostReg32(from_reg));
+}
+
 void CodeGenerator::EmitSetConditionResult(HostReg to_reg, RegSize to_size, Condition condition)
 {
   if (condition == Condition::Always)
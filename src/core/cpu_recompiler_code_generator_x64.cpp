@@ -1205,6 +1205,13 @@ void CodeGenerator::EmitNot(HostReg to_reg, RegSize size)
   }
 }
 
+void CodeGenerator::EmitCountLeadingZeros(HostReg to_reg, HostReg from_reg)
+{
+  // bsr gives the index of the highest set bit, which is undefined for zero.
+  m_emit->bsr(GetHostReg32(to_reg), GetHostReg32(from_reg));
+  m_emit->xor_(GetHostReg32(to_reg), 31);
+}
+
 void CodeGenerator::EmitSetConditionResult(HostReg to_reg, RegSize to_size, Condition condition)
 {
   switch (condition)
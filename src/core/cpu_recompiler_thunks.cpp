@@ -154,6 +154,43 @@ void Thunks::ExecuteGTEInstruction(Core* cpu, u32 instruction_bits)
   cpu->m_cop2.ExecuteInstruction(GTE::Instruction{instruction_bits});
 }
 
+template<bool sf, bool lm>
+void Thunks::ExecuteGTE_RTPS(Core* cpu)
+{
+  cpu->m_cop2.Execute_RTPS<sf, lm>();
+}
+
+template<bool sf, bool lm>
+void Thunks::ExecuteGTE_RTPT(Core* cpu)
+{
+  cpu->m_cop2.Execute_RTPT<sf, lm>();
+}
+
+template void Thunks::ExecuteGTE_RTPS<false, false>(Core* cpu);
+template void Thunks::ExecuteGTE_RTPS<false, true>(Core* cpu);
+template void Thunks::ExecuteGTE_RTPS<true, false>(Core* cpu);
+template void Thunks::ExecuteGTE_RTPS<true, true>(Core* cpu);
+template void Thunks::ExecuteGTE_RTPT<false, false>(Core* cpu);
+template void Thunks::ExecuteGTE_RTPT<false, true>(Core* cpu);
+template void Thunks::ExecuteGTE_RTPT<true, false>(Core* cpu);
+template void Thunks::ExecuteGTE_RTPT<true, true>(Core* cpu);
+
+// None of these use the sf/lm bits.
+void Thunks::ExecuteGTE_NCLIP(Core* cpu)
+{
+  cpu->m_cop2.Execute_NCLIP(GTE::Instruction{0});
+}
+
+void Thunks::ExecuteGTE_AVSZ3(Core* cpu)
+{
+  cpu->m_cop2.Execute_AVSZ3(GTE::Instruction{0});
+}
+
+void Thunks::ExecuteGTE_AVSZ4(Core* cpu)
+{
+  cpu->m_cop2.Execute_AVSZ4(GTE::Instruction{0});
+}
+
 u32 Thunks::ReadGTERegister(Core* cpu, u32 reg)
 {
   return cpu->m_cop2.ReadRegister(reg);
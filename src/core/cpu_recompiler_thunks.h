@@ -45,6 +45,13 @@ public:
   static void RaiseException(Core* cpu, u32 epc, u32 ri_bits);
   static void RaiseAddressException(Core* cpu, u32 address, bool store, bool branch);
   static void ExecuteGTEInstruction(Core* cpu, u32 instruction_bits);
+  template<bool sf, bool lm>
+  static void ExecuteGTE_RTPS(Core* cpu);
+  template<bool sf, bool lm>
+  static void ExecuteGTE_RTPT(Core* cpu);
+  static void ExecuteGTE_NCLIP(Core* cpu);
+  static void ExecuteGTE_AVSZ3(Core* cpu);
+  static void ExecuteGTE_AVSZ4(Core* cpu);
   static u32 ReadGTERegister(Core* cpu, u32 reg);
   static void WriteGTERegister(Core* cpu, u32 reg, u32 value);
 };
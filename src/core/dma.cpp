@@ -9,6 +9,8 @@
 #include "mdec.h"
 #include "spu.h"
 #include "system.h"
+#include <algorithm>
+#include <cstring>
 Log_SetChannel(DMA);
 
 DMA::DMA() = default;
@@ -317,31 +319,7 @@ void DMA::TransferChannel(Channel channel, TickCount ticks_late)
       {
         Log_DebugPrintf("DMA%u: Copying linked list starting at 0x%08X to device", static_cast<u32>(channel),
                         current_address);
-
-        for (;;)
-        {
-          u32 header;
-          m_bus->DispatchAccess<MemoryAccessType::Read, MemoryAccessSize::Word>(current_address & ADDRESS_MASK, header);
-
-          const u32 word_count = header >> 24;
-          const u32 next_address = header & UINT32_C(0x00FFFFFF);
-          Log_TracePrintf(" .. linked list entry at 0x%08X size=%u(%u words) next=0x%08X", current_address,
-                          word_count * UINT32_C(4), word_count, next_address);
-          if (word_count > 0)
-            TransferMemoryToDevice(channel, (current_address + sizeof(header)) & ADDRESS_MASK, 4, word_count);
-
-          // Self-referencing DMA loops.. not sure how these are happening?
-          if (current_address == next_address)
-          {
-            Log_ErrorPrintf("HACK: Aborting self-referencing DMA loop @ 0x%08X. Something went wrong to generate this.",
-                            current_address);
-            break;
-          }
-
-          current_address = next_address;
-          if (current_address & UINT32_C(0x800000))
-            break;
-        }
+        current_address = TransferLinkedList(channel, current_address);
       }
 
       cs.base_address = current_address;
@@ -401,37 +379,176 @@ void DMA::TransferChannel(Channel channel, TickCount ticks_late)
   }
 }
 
+PhysicalMemoryAddress DMA::TransferLinkedList(Channel channel, PhysicalMemoryAddress address)
+{
+  const u32* ram = m_bus->GetRAMWordPointer(0, RAM_WORD_COUNT);
+  u32 batch_size = 0;
+
+  // A list which loops back on itself would keep the DMA busy forever. Nodes which point to themselves are caught
+  // straight away, and longer loops with Brent's algorithm: each node is compared against a checkpoint, which moves
+  // forward after a doubling number of steps. This doesn't need any extra memory, and finds the loop within a couple of
+  // trips around it.
+  PhysicalMemoryAddress checkpoint_address = address & ADDRESS_MASK;
+  u32 checkpoint_interval = 1;
+  u32 steps_since_checkpoint = 0;
+
+  for (;;)
+  {
+    const u32 node_address = address & ADDRESS_MASK;
+    const u32 header = ram[node_address / sizeof(u32)];
+    const u32 word_count = header >> 24;
+    address = header & UINT32_C(0x00FFFFFF);
+    Log_TracePrintf(" .. linked list entry at 0x%08X size=%u(%u words) next=0x%08X", node_address,
+                    word_count * UINT32_C(4), word_count, address);
+
+    if (word_count > 0)
+    {
+      // Most nodes are only a handful of words, so their payloads are sent to the device in batches.
+      if ((batch_size + word_count) > LINKED_LIST_BATCH_SIZE)
+      {
+        WriteToDevice(channel, m_transfer_buffer.data(), batch_size);
+        batch_size = 0;
+      }
+
+      if (m_transfer_buffer.size() < (batch_size + word_count))
+        m_transfer_buffer.resize(LINKED_LIST_BATCH_SIZE);
+
+      CopyFromRAM((node_address + sizeof(u32)) & ADDRESS_MASK, m_transfer_buffer.data() + batch_size, word_count);
+      batch_size += word_count;
+    }
+
+    if (address & UINT32_C(0x800000))
+      break;
+
+    const u32 next_node_address = address & ADDRESS_MASK;
+    if (next_node_address == node_address || next_node_address == checkpoint_address)
+    {
+      // Leave the channel pointing at the node which would have started the loop again.
+      Log_ErrorPrintf("Aborting looping DMA linked list at 0x%08X", node_address);
+      address = next_node_address;
+      break;
+    }
+
+    if (++steps_since_checkpoint == checkpoint_interval)
+    {
+      checkpoint_address = next_node_address;
+      checkpoint_interval *= 2;
+      steps_since_checkpoint = 0;
+    }
+  }
+
+  if (batch_size > 0)
+    WriteToDevice(channel, m_transfer_buffer.data(), batch_size);
+
+  return address;
+}
+
 void DMA::TransferMemoryToDevice(Channel channel, u32 address, u32 increment, u32 word_count)
 {
-  // Read from memory. Wrap-around?
+  address &= ADDRESS_MASK;
+  if (increment == sizeof(u32))
+  {
+    // Devices read straight out of RAM. A transfer which runs off the end of RAM wraps around to the start, so it's
+    // sent as a second span.
+    const u32 first_count = GetContiguousWordCount(address, word_count);
+    WriteToDevice(channel, m_bus->GetRAMWordPointer(address, first_count), first_count);
+    if (first_count < word_count)
+      WriteToDevice(channel, m_bus->GetRAMWordPointer(0, word_count - first_count), word_count - first_count);
+
+    return;
+  }
+
+  // Stepping backwards, so copy the range forwards and then reverse it.
   if (m_transfer_buffer.size() < word_count)
     m_transfer_buffer.resize(word_count);
 
-  if (increment > 0 && ((address + (increment * word_count)) & ADDRESS_MASK) > address)
-  {
-    m_bus->ReadWords(address, m_transfer_buffer.data(), word_count);
-  }
-  else
+  CopyFromRAM((address - (sizeof(u32) * (word_count - 1))) & ADDRESS_MASK, m_transfer_buffer.data(), word_count);
+  std::reverse(m_transfer_buffer.begin(), m_transfer_buffer.begin() + word_count);
+  WriteToDevice(channel, m_transfer_buffer.data(), word_count);
+}
+
+void DMA::TransferDeviceToMemory(Channel channel, u32 address, u32 increment, u32 word_count)
+{
+  address &= ADDRESS_MASK;
+  if (channel == Channel::OTC)
   {
-    for (u32 i = 0; i < word_count; i++)
+    // Clear the ordering table. This always goes in reverse, with each entry pointing to the one before it, and the
+    // last (lowest) entry marking the end of the list. Fill it forwards, straight into RAM.
+    const u32 end_address = (address - (sizeof(u32) * (word_count - 1))) & ADDRESS_MASK;
+    u32 span_address = end_address;
+    u32 remaining = word_count;
+    while (remaining > 0)
     {
-      m_bus->DispatchAccess<MemoryAccessType::Read, MemoryAccessSize::Word>(address, m_transfer_buffer[i]);
-      address = (address + increment) & ADDRESS_MASK;
+      const u32 span_count = GetContiguousWordCount(span_address, remaining);
+      u32* span = m_bus->GetRAMWordPointerForWrite(span_address, span_count);
+      for (u32 i = 0; i < span_count; i++)
+      {
+        const u32 entry_address = span_address + (i * sizeof(u32));
+        span[i] = (entry_address == end_address) ? UINT32_C(0xFFFFFF) : ((entry_address - sizeof(u32)) & ADDRESS_MASK);
+      }
+
+      remaining -= span_count;
+      span_address = 0;
     }
+
+    return;
+  }
+
+  if (increment == sizeof(u32))
+  {
+    // Devices write straight into RAM, in two spans if the transfer wraps around.
+    const u32 first_count = GetContiguousWordCount(address, word_count);
+    ReadFromDevice(channel, m_bus->GetRAMWordPointerForWrite(address, first_count), first_count);
+    if (first_count < word_count)
+      ReadFromDevice(channel, m_bus->GetRAMWordPointerForWrite(0, word_count - first_count), word_count - first_count);
+
+    return;
+  }
+
+  if (m_transfer_buffer.size() < word_count)
+    m_transfer_buffer.resize(word_count);
+
+  ReadFromDevice(channel, m_transfer_buffer.data(), word_count);
+  std::reverse(m_transfer_buffer.begin(), m_transfer_buffer.begin() + word_count);
+  CopyToRAM((address - (sizeof(u32) * (word_count - 1))) & ADDRESS_MASK, m_transfer_buffer.data(), word_count);
+}
+
+void DMA::CopyFromRAM(u32 address, u32* words, u32 word_count)
+{
+  const u32 first_count = GetContiguousWordCount(address, word_count);
+  std::memcpy(words, m_bus->GetRAMWordPointer(address, first_count), sizeof(u32) * first_count);
+  if (first_count < word_count)
+  {
+    std::memcpy(words + first_count, m_bus->GetRAMWordPointer(0, word_count - first_count),
+                sizeof(u32) * (word_count - first_count));
   }
+}
+
+void DMA::CopyToRAM(u32 address, const u32* words, u32 word_count)
+{
+  const u32 first_count = GetContiguousWordCount(address, word_count);
+  std::memcpy(m_bus->GetRAMWordPointerForWrite(address, first_count), words, sizeof(u32) * first_count);
+  if (first_count < word_count)
+  {
+    std::memcpy(m_bus->GetRAMWordPointerForWrite(0, word_count - first_count), words + first_count,
+                sizeof(u32) * (word_count - first_count));
+  }
+}
 
+void DMA::WriteToDevice(Channel channel, const u32* words, u32 word_count)
+{
   switch (channel)
   {
     case Channel::GPU:
-      m_gpu->DMAWrite(m_transfer_buffer.data(), word_count);
+      m_gpu->DMAWrite(words, word_count);
       break;
 
     case Channel::SPU:
-      m_spu->DMAWrite(m_transfer_buffer.data(), word_count);
+      m_spu->DMAWrite(words, word_count);
       break;
 
     case Channel::MDECin:
-      m_mdec->DMAWrite(m_transfer_buffer.data(), word_count);
+      m_mdec->DMAWrite(words, word_count);
       break;
 
     case Channel::CDROM:
@@ -443,80 +560,31 @@ void DMA::TransferMemoryToDevice(Channel channel, u32 address, u32 increment, u3
   }
 }
 
-void DMA::TransferDeviceToMemory(Channel channel, u32 address, u32 increment, u32 word_count)
+void DMA::ReadFromDevice(Channel channel, u32* words, u32 word_count)
 {
-  if (m_transfer_buffer.size() < word_count)
-    m_transfer_buffer.resize(word_count);
-
-  // Read from device.
   switch (channel)
   {
-    case Channel::OTC:
-    {
-      // clear ordering table
-      // this always goes in reverse, so we can generate values in reverse order and write it forwards
-      if (((address - (4 * word_count)) & ADDRESS_MASK) < address)
-      {
-        const u32 end_address = (address - (4 * (word_count - 1))) & ADDRESS_MASK;
-
-        u32 value = end_address;
-        m_transfer_buffer[0] = UINT32_C(0xFFFFFF);
-        for (u32 i = 1; i < word_count; i++)
-        {
-          m_transfer_buffer[i] = value;
-          value = (value + 4) & ADDRESS_MASK;
-        }
-
-        m_bus->WriteWords(end_address, m_transfer_buffer.data(), word_count);
-      }
-      else
-      {
-        for (u32 i = 0; i < word_count; i++)
-        {
-          u32 value = (i == word_count - 1) ? UINT32_C(0xFFFFFFF) : ((address - 4) & ADDRESS_MASK);
-          m_bus->DispatchAccess<MemoryAccessType::Write, MemoryAccessSize::Word>(address, value);
-          address = (address - 4) & ADDRESS_MASK;
-        }
-      }
-
-      return;
-    }
-    break;
-
     case Channel::GPU:
-      m_gpu->DMARead(m_transfer_buffer.data(), word_count);
+      m_gpu->DMARead(words, word_count);
       break;
 
     case Channel::CDROM:
-      m_cdrom->DMARead(m_transfer_buffer.data(), word_count);
+      m_cdrom->DMARead(words, word_count);
       break;
 
     case Channel::SPU:
-      m_spu->DMARead(m_transfer_buffer.data(), word_count);
+      m_spu->DMARead(words, word_count);
       break;
 
     case Channel::MDECout:
-      m_mdec->DMARead(m_transfer_buffer.data(), word_count);
+      m_mdec->DMARead(words, word_count);
       break;
 
     case Channel::MDECin:
     case Channel::PIO:
     default:
       Panic("Unhandled DMA channel for device read");
-      std::fill_n(m_transfer_buffer.begin(), word_count, UINT32_C(0xFFFFFFFF));
+      std::fill_n(words, word_count, UINT32_C(0xFFFFFFFF));
       break;
   }
-
-  if (increment > 0 && ((address + (increment * word_count)) & ADDRESS_MASK) > address)
-  {
-    m_bus->WriteWords(address, m_transfer_buffer.data(), word_count);
-  }
-  else
-  {
-    for (u32 i = 0; i < word_count; i++)
-    {
-      m_bus->DispatchAccess<MemoryAccessType::Write, MemoryAccessSize::Word>(address, m_transfer_buffer[i]);
-      address = (address + increment) & ADDRESS_MASK;
-    }
-  }
 }
@@ -55,6 +55,10 @@ private:
   static constexpr PhysicalMemoryAddress BASE_ADDRESS_MASK = UINT32_C(0x00FFFFFF);
   static constexpr PhysicalMemoryAddress ADDRESS_MASK = UINT32_C(0x001FFFFC);
   static constexpr u32 TRANSFER_TICKS = 10;
+  static constexpr u32 RAM_WORD_COUNT = (ADDRESS_MASK + sizeof(u32)) / sizeof(u32);
+
+  // Payloads of consecutive linked list nodes are gathered into batches of up to this many words.
+  static constexpr u32 LINKED_LIST_BATCH_SIZE = 4096;
 
   enum class SyncMode : u32
   {
@@ -81,6 +85,23 @@ private:
   // from memory -> device
   void TransferMemoryToDevice(Channel channel, u32 address, u32 increment, u32 word_count);
 
+  // Walks a linked list of packets in RAM, sending their payloads to the device. Returns the end-of-list address.
+  PhysicalMemoryAddress TransferLinkedList(Channel channel, PhysicalMemoryAddress address);
+
+  // Returns how many of the words starting at address come before the end of RAM, where transfers wrap around.
+  static u32 GetContiguousWordCount(u32 address, u32 word_count)
+  {
+    const u32 words_to_end = RAM_WORD_COUNT - (address / 4);
+    return (word_count < words_to_end) ? word_count : words_to_end;
+  }
+
+  // Copies between RAM and a linear buffer, wrapping around at the end of RAM.
+  void CopyFromRAM(u32 address, u32* words, u32 word_count);
+  void CopyToRAM(u32 address, const u32* words, u32 word_count);
+
+  void WriteToDevice(Channel channel, const u32* words, u32 word_count);
+  void ReadFromDevice(Channel channel, u32* words, u32 word_count);
+
   System* m_system = nullptr;
   Bus* m_bus = nullptr;
   InterruptController* m_interrupt_controller = nullptr;
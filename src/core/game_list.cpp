@@ -1,21 +1,38 @@
 #include "game_list.h"
 #include "bios.h"
+#include "common/align.h"
 #include "common/assert.h"
 #include "common/byte_stream.h"
 #include "common/cd_image.h"
 #include "common/file_system.h"
 #include "common/iso_reader.h"
 #include "common/log.h"
+#include "common/md5_digest.h"
+#include "common/memory_mapped_file.h"
 #include "common/string_util.h"
+#include "common/timer.h"
 #include "settings.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <string_view>
+#include <thread>
 #include <tinyxml2.h>
 #include <utility>
 Log_SetChannel(GameList);
 
+// Only a few sectors are read when identifying an image, so decompressing CHD hunks ahead would just start threads.
+static CDImage::OpenOptions GetProbeOpenOptions()
+{
+  CDImage::OpenOptions options;
+  options.chd_cache_hunk_count = 1;
+  options.chd_decompression_thread_count = 0;
+  return options;
+}
+
 GameList::GameList() = default;
 
 GameList::~GameList() = default;
@@ -28,7 +45,7 @@ const char* GameList::EntryTypeToString(GameListEntryType type)
 
 std::string GameList::GetGameCodeForPath(const char* image_path)
 {
-  std::unique_ptr<CDImage> cdi = CDImage::Open(image_path);
+  std::unique_ptr<CDImage> cdi = CDImage::Open(image_path, GetProbeOpenOptions());
   if (!cdi)
     return {};
 
@@ -186,13 +203,58 @@ std::optional<ConsoleRegion> GameList::GetRegionForImage(CDImage* cdi)
 
 std::optional<ConsoleRegion> GameList::GetRegionForPath(const char* image_path)
 {
-  std::unique_ptr<CDImage> cdi = CDImage::Open(image_path);
+  std::unique_ptr<CDImage> cdi = CDImage::Open(image_path, GetProbeOpenOptions());
   if (!cdi)
     return {};
 
   return GetRegionForImage(cdi.get());
 }
 
+bool GameList::ComputeTrackHashes(CDImage* cdi, std::vector<GameListTrackHash>* hashes)
+{
+  hashes->clear();
+
+  u8 sector_buffer[CDImage::RAW_SECTOR_SIZE];
+  const u8 track_count = static_cast<u8>(cdi->GetTrackCount());
+  for (u8 track = 1; track <= track_count; track++)
+  {
+    CDImage::LBA start_lba;
+    u32 sector_count;
+    if (!cdi->GetTrackDumpRange(track, &start_lba, &sector_count) || !cdi->Seek(start_lba))
+      return false;
+
+    MD5Digest digest;
+    for (u32 i = 0; i < sector_count; i++)
+    {
+      const u8* sector = cdi->ReadRawSectorPointer(sector_buffer);
+      if (!sector)
+        return false;
+
+      digest.Update(sector, CDImage::RAW_SECTOR_SIZE);
+    }
+
+    GameListTrackHash hash;
+    digest.Final(hash.data());
+    hashes->push_back(hash);
+  }
+
+  return true;
+}
+
+std::string GameList::TrackHashToString(const GameListTrackHash& hash)
+{
+  static constexpr char hex_digits[] = "0123456789abcdef";
+  std::string hash_str;
+  hash_str.reserve(hash.size() * 2);
+  for (const u8 byte : hash)
+  {
+    hash_str.push_back(hex_digits[byte >> 4]);
+    hash_str.push_back(hex_digits[byte & 0xF]);
+  }
+
+  return hash_str;
+}
+
 bool GameList::IsExeFileName(const char* path)
 {
   const char* extension = std::strrchr(path, '.');
@@ -265,6 +327,7 @@ bool GameList::GetExeListEntry(const char* path, GameListEntry* entry)
   entry->path = path;
   entry->region = ConsoleRegion::NTSC_U;
   entry->total_size = ZeroExtend64(file_size);
+  entry->file_size = ffd.Size;
   entry->last_modified_time = ffd.ModificationTime.AsUnixTimestamp();
   entry->type = GameListEntryType::PSExe;
 
@@ -276,7 +339,7 @@ bool GameList::GetGameListEntry(const std::string& path, GameListEntry* entry)
   if (IsExeFileName(path.c_str()))
     return GetExeListEntry(path.c_str(), entry);
 
-  std::unique_ptr<CDImage> cdi = CDImage::Open(path.c_str());
+  std::unique_ptr<CDImage> cdi = CDImage::Open(path.c_str(), GetProbeOpenOptions());
   if (!cdi)
     return false;
 
@@ -286,216 +349,429 @@ bool GameList::GetGameListEntry(const std::string& path, GameListEntry* entry)
     GetRegionFromSystemArea(cdi.get()).value_or(GetRegionForCode(entry->code).value_or(ConsoleRegion::NTSC_U));
   entry->total_size = static_cast<u64>(CDImage::RAW_SECTOR_SIZE) * static_cast<u64>(cdi->GetLBACount());
   entry->type = GameListEntryType::Disc;
+  entry->track_hashes.clear();
+  if (m_compute_track_hashes && !ComputeTrackHashes(cdi.get(), &entry->track_hashes))
+  {
+    Log_WarningPrintf("Failed to compute track hashes for '%s'", path.c_str());
+    entry->track_hashes.clear();
+  }
   cdi.reset();
 
-  if (entry->code.empty())
+  GameListDatabaseEntry database_entry;
+  bool in_database = (!entry->code.empty() && GetDatabaseEntryForCode(entry->code, &database_entry));
+  if (!in_database)
   {
-    // no game code, so use the filename title
-    entry->title = GetTitleForPath(path.c_str());
+    // images without a code, or with one which isn't in the database, can still be identified by their tracks
+    for (const GameListTrackHash& hash : entry->track_hashes)
+    {
+      if ((in_database = GetDatabaseEntryForTrackHash(hash, &database_entry)) == true)
+      {
+        entry->code = database_entry.code;
+        Log_DevPrintf("Identified '%s' as '%s' by track hash", path.c_str(), entry->code.c_str());
+        break;
+      }
+    }
+  }
+
+  if (in_database)
+  {
+    entry->title = database_entry.title;
+    entry->region = database_entry.region;
   }
   else
   {
-    const GameListDatabaseEntry* database_entry = GetDatabaseEntryForCode(entry->code);
-    if (database_entry)
-    {
-      entry->title = database_entry->title;
-      entry->region = database_entry->region;
-    }
-    else
-    {
+    // no game code, so use the filename title
+    if (!entry->code.empty())
       Log_WarningPrintf("'%s' not found in database", entry->code.c_str());
-      entry->title = GetTitleForPath(path.c_str());
-    }
+
+    entry->title = GetTitleForPath(path.c_str());
   }
 
   FILESYSTEM_STAT_DATA ffd;
   if (!FileSystem::StatFile(path.c_str(), &ffd))
     return false;
 
+  entry->file_size = ffd.Size;
   entry->last_modified_time = ffd.ModificationTime.AsUnixTimestamp();
   return true;
 }
 
-bool GameList::GetGameListEntryFromCache(const std::string& path, GameListEntry* entry)
+// Cache file layout: header, then the path index, then the entry records. Records are aligned and never modified once
+// written. A changed entry is appended as a new record and its old record is left as dead space, so a partial update
+// can't corrupt entries which the old index still points at. The cache is compacted when too much of it is dead.
+struct GameList::CacheHeader
 {
-  auto iter = m_cache_map.find(path);
-  if (iter == m_cache_map.end())
-    return false;
+  u32 signature;
+  u32 version;
+  u32 slot_count;
+  u32 record_count;
+  u32 data_size;
+  u32 dead_size;
+};
 
-  *entry = std::move(iter->second);
-  m_cache_map.erase(iter);
-  return true;
+// Followed by the path, code and title (not null-terminated), then the track hashes.
+// Records are padded to the alignment, and their size is worked out from the lengths.
+struct GameList::CacheRecordHeader
+{
+  u32 path_length;
+  u32 code_length;
+  u32 title_length;
+  u8 region;
+  u8 type;
+  u8 track_hash_count;
+  u8 reserved;
+  u64 total_size;
+  u64 file_size;
+  u64 last_modified_time;
+};
+
+u32 GameList::GetCacheRecordSize(const GameListEntry& entry)
+{
+  return static_cast<u32>(sizeof(CacheRecordHeader) + entry.path.size() + entry.code.size() +
+                          entry.title.size() + (entry.track_hashes.size() * sizeof(GameListTrackHash)));
 }
 
-void GameList::LoadCache()
+u32 GameList::GetCacheRecordSize(const CacheRecordHeader& rh)
 {
-  if (m_cache_filename.empty())
-    return;
+  return static_cast<u32>(sizeof(CacheRecordHeader) + rh.path_length + rh.code_length + rh.title_length +
+                          (rh.track_hash_count * sizeof(GameListTrackHash)));
+}
 
-  std::unique_ptr<ByteStream> stream =
-    FileSystem::OpenFile(m_cache_filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
-  if (!stream)
-    return;
+void GameList::WriteCacheRecord(const GameListEntry& entry, u8* data)
+{
+  CacheRecordHeader rh = {};
+  rh.path_length = static_cast<u32>(entry.path.size());
+  rh.code_length = static_cast<u32>(entry.code.size());
+  rh.title_length = static_cast<u32>(entry.title.size());
+  rh.total_size = entry.total_size;
+  rh.file_size = entry.file_size;
+  rh.last_modified_time = entry.last_modified_time;
+  rh.region = static_cast<u8>(entry.region);
+  rh.type = static_cast<u8>(entry.type);
+  rh.track_hash_count = static_cast<u8>(entry.track_hashes.size());
+  std::memcpy(data, &rh, sizeof(rh));
+  data += sizeof(rh);
+
+  std::memcpy(data, entry.path.data(), entry.path.size());
+  data += entry.path.size();
+  std::memcpy(data, entry.code.data(), entry.code.size());
+  data += entry.code.size();
+  std::memcpy(data, entry.title.data(), entry.title.size());
+  data += entry.title.size();
+  if (!entry.track_hashes.empty())
+    std::memcpy(data, entry.track_hashes.data(), entry.track_hashes.size() * sizeof(GameListTrackHash));
+}
 
-  if (!LoadEntriesFromCache(stream.get()))
+u32 GameList::HashPath(std::string_view path)
+{
+  // FNV-1a, case-insensitive since lookups from the frontend ignore case
+  u32 hash = 2166136261u;
+  for (const char ch : path)
   {
-    Log_WarningPrintf("Deleting corrupted cache file '%s'", m_cache_filename.c_str());
-    stream.reset();
-    m_cache_map.clear();
-    DeleteCacheFile();
-    return;
+    hash ^= static_cast<u8>(std::tolower(static_cast<u8>(ch)));
+    hash *= 16777619u;
   }
+
+  return hash;
 }
 
-static bool ReadString(ByteStream* stream, std::string* dest)
+u32 GameList::GetPathIndexSlotCount(u32 entry_count)
 {
-  u32 size;
-  if (!stream->Read2(&size, sizeof(size)))
-    return false;
-
-  dest->resize(size);
-  if (!stream->Read2(dest->data(), size))
-    return false;
+  // keep the table at most half full so probe sequences stay short
+  u32 slot_count = MIN_PATH_INDEX_SLOTS;
+  while (slot_count < (entry_count * 2))
+    slot_count *= 2;
 
-  return true;
+  return slot_count;
 }
 
-static bool ReadU8(ByteStream* stream, u8* dest)
+template<typename T>
+u32 GameList::FindPathIndexSlot(const PathIndexSlot* slots, u32 slot_count, u32 hash, const T& is_match)
 {
-  return stream->Read2(dest, sizeof(u8));
-}
+  // returns the slot for the path, or the free slot it would go in, or slot_count if the table is full
+  const u32 mask = slot_count - 1;
+  u32 slot = hash & mask;
+  for (u32 i = 0; i < slot_count; i++)
+  {
+    if (slots[slot].value == 0 || (slots[slot].hash == hash && is_match(slots[slot].value)))
+      return slot;
 
-static bool ReadU32(ByteStream* stream, u32* dest)
-{
-  return stream->Read2(dest, sizeof(u32));
-}
+    slot = (slot + 1) & mask;
+  }
 
-static bool ReadU64(ByteStream* stream, u64* dest)
-{
-  return stream->Read2(dest, sizeof(u64));
+  return slot_count;
 }
 
-static bool WriteString(ByteStream* stream, const std::string& str)
+bool GameList::GetGameListEntryFromCache(const FILESYSTEM_FIND_DATA& ffd, GameListEntry* entry)
 {
-  const u32 size = static_cast<u32>(str.size());
-  return (stream->Write2(&size, sizeof(size)) && (size == 0 || stream->Write2(str.data(), size)));
+  if (!m_cache_mapping)
+    return false;
+
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(m_cache_mapping->GetData());
+  const PathIndexSlot* slots = reinterpret_cast<const PathIndexSlot*>(header + 1);
+  const std::string_view path(ffd.FileName);
+  const CacheRecordHeader* rh = nullptr;
+  const u32 slot = FindPathIndexSlot(slots, header->slot_count, HashPath(path), [this, &path, &rh](u32 offset) {
+    std::string_view record_path;
+    rh = GetCacheRecord(offset, &record_path);
+    return (rh && record_path == path);
+  });
+  if (slot == header->slot_count || slots[slot].value == 0)
+    return false;
+
+  // rescan files which have changed, or which are missing hashes we want
+  if (rh->last_modified_time != ffd.ModificationTime.AsUnixTimestamp() || rh->file_size != ffd.Size ||
+      (m_compute_track_hashes && rh->type == static_cast<u8>(GameListEntryType::Disc) && rh->track_hash_count == 0))
+  {
+    return false;
+  }
+
+  const char* strings = reinterpret_cast<const char*>(rh + 1);
+  entry->path.assign(strings, rh->path_length);
+  strings += rh->path_length;
+  entry->code.assign(strings, rh->code_length);
+  strings += rh->code_length;
+  entry->title.assign(strings, rh->title_length);
+  strings += rh->title_length;
+  entry->total_size = rh->total_size;
+  entry->file_size = rh->file_size;
+  entry->last_modified_time = rh->last_modified_time;
+  entry->region = static_cast<ConsoleRegion>(rh->region);
+  entry->type = static_cast<GameListEntryType>(rh->type);
+  entry->track_hashes.resize(rh->track_hash_count);
+  if (rh->track_hash_count > 0)
+    std::memcpy(entry->track_hashes.data(), strings, rh->track_hash_count * sizeof(GameListTrackHash));
+
+  return true;
 }
 
-static bool WriteU8(ByteStream* stream, u8 dest)
+const GameList::CacheRecordHeader* GameList::GetCacheRecord(u32 offset, std::string_view* path) const
 {
-  return stream->Write2(&dest, sizeof(u8));
+  // records are checked as they're used, rather than reading the whole file up front
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(m_cache_mapping->GetData());
+  if ((offset % GAME_LIST_CACHE_RECORD_ALIGNMENT) != 0 || offset >= header->data_size ||
+      (header->data_size - offset) < sizeof(CacheRecordHeader))
+  {
+    return nullptr;
+  }
+
+  const CacheRecordHeader* rh = reinterpret_cast<const CacheRecordHeader*>(m_cache_mapping->GetData() + offset);
+  const u64 size = sizeof(CacheRecordHeader) + static_cast<u64>(rh->path_length) + rh->code_length +
+                   rh->title_length + (rh->track_hash_count * sizeof(GameListTrackHash));
+  if (size > (header->data_size - offset) ||
+      rh->region >= static_cast<u8>(ConsoleRegion::Count) || rh->type > static_cast<u8>(GameListEntryType::PSExe) ||
+      rh->track_hash_count > MAX_TRACK_HASHES)
+  {
+    return nullptr;
+  }
+
+  *path = std::string_view(reinterpret_cast<const char*>(rh + 1), rh->path_length);
+  return rh;
 }
 
-static bool WriteU32(ByteStream* stream, u32 dest)
+void GameList::LoadCache()
 {
-  return stream->Write2(&dest, sizeof(u32));
+  if (m_cache_filename.empty())
+    return;
+
+  m_cache_mapping = MemoryMappedFile::Open(m_cache_filename.c_str());
+  if (!m_cache_mapping)
+    return;
+
+  const u64 size = m_cache_mapping->GetSize();
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(m_cache_mapping->GetData());
+  if (size < sizeof(CacheHeader) || header->signature != GAME_LIST_CACHE_SIGNATURE ||
+      header->version != GAME_LIST_CACHE_VERSION || header->slot_count == 0 ||
+      (header->slot_count & (header->slot_count - 1)) != 0 || header->data_size > size ||
+      header->data_size < (sizeof(CacheHeader) + static_cast<u64>(header->slot_count) * sizeof(PathIndexSlot)))
+  {
+    Log_WarningPrintf("Deleting corrupted cache file '%s'", m_cache_filename.c_str());
+    DeleteCacheFile();
+    return;
+  }
+
+  Log_DevPrintf("Mapped game list cache with %u entries", header->record_count);
 }
 
-static bool WriteU64(ByteStream* stream, u64 dest)
+void GameList::CloseCache()
 {
-  return stream->Write2(&dest, sizeof(u64));
+  m_cache_mapping.reset();
 }
 
-bool GameList::LoadEntriesFromCache(ByteStream* stream)
+void GameList::UpdateCache(const std::vector<const GameListEntry*>& changed_entries)
 {
-  u32 file_signature, file_version;
-  if (!ReadU32(stream, &file_signature) || !ReadU32(stream, &file_version) ||
-      file_signature != GAME_LIST_CACHE_SIGNATURE || file_version != GAME_LIST_CACHE_VERSION)
+  if (m_cache_filename.empty() || changed_entries.empty())
+    return;
+
+  if (!m_cache_mapping)
   {
-    Log_WarningPrintf("Game list cache is corrupted");
-    return false;
+    CompactCache(changed_entries);
+    return;
   }
 
-  while (stream->GetPosition() != stream->GetSize())
-  {
-    std::string path;
-    std::string code;
-    std::string title;
-    u64 total_size;
-    u64 last_modified_time;
-    u8 region;
-    u8 type;
+  // work out where everything goes against a copy of the index, so we can give up and compact at any point
+  CacheHeader header;
+  std::memcpy(&header, m_cache_mapping->GetData(), sizeof(header));
+  std::vector<PathIndexSlot> slots(header.slot_count);
+  std::memcpy(slots.data(), m_cache_mapping->GetData() + sizeof(header), sizeof(PathIndexSlot) * header.slot_count);
 
-    if (!ReadString(stream, &path) || !ReadString(stream, &code) || !ReadString(stream, &title) ||
-        !ReadU64(stream, &total_size) || !ReadU64(stream, &last_modified_time) || !ReadU8(stream, &region) ||
-        region >= static_cast<u8>(ConsoleRegion::Count) || !ReadU8(stream, &type) ||
-        type > static_cast<u8>(GameListEntryType::PSExe))
+  std::vector<std::pair<u32, u32>> writes; // offset, aligned size
+  writes.reserve(changed_entries.size());
+  u64 data_size = header.data_size;
+  for (const GameListEntry* entry : changed_entries)
+  {
+    const u32 size = GetCacheRecordSize(*entry);
+    const u32 hash = HashPath(entry->path);
+    const CacheRecordHeader* rh = nullptr;
+    const u32 slot = FindPathIndexSlot(slots.data(), header.slot_count, hash, [this, entry, &rh](u32 offset) {
+      std::string_view record_path;
+      rh = GetCacheRecord(offset, &record_path);
+      return (rh && record_path == entry->path);
+    });
+    if (slot == header.slot_count)
     {
-      Log_WarningPrintf("Game list cache entry is corrupted");
-      return false;
+      CompactCache(changed_entries);
+      return;
     }
 
-    GameListEntry ge;
-    ge.path = path;
-    ge.code = std::move(code);
-    ge.title = std::move(title);
-    ge.total_size = total_size;
-    ge.last_modified_time = last_modified_time;
-    ge.region = static_cast<ConsoleRegion>(region);
-    ge.type = static_cast<GameListEntryType>(type);
-
-    auto iter = m_cache_map.find(ge.path);
-    if (iter != m_cache_map.end())
-      iter->second = std::move(ge);
+    // Deliberately not rewritten in place even if the new record would fit, since the old index has to stay valid
+    // until the header is written.
+    if (slots[slot].value != 0)
+      header.dead_size += Common::AlignUpPow2(GetCacheRecordSize(*rh), GAME_LIST_CACHE_RECORD_ALIGNMENT);
     else
-      m_cache_map.emplace(std::move(path), std::move(ge));
+      header.record_count++;
+
+    const u32 aligned_size = Common::AlignUpPow2(size, GAME_LIST_CACHE_RECORD_ALIGNMENT);
+    writes.emplace_back(static_cast<u32>(data_size), aligned_size);
+    slots[slot] = {hash, static_cast<u32>(data_size)};
+    data_size += aligned_size;
   }
 
-  return true;
+  if (data_size > static_cast<u64>(std::numeric_limits<s32>::max()) ||
+      (header.record_count * 2) > header.slot_count || (header.dead_size * 2) > data_size)
+  {
+    CompactCache(changed_entries);
+    return;
+  }
+
+  header.data_size = static_cast<u32>(data_size);
+  CloseCache();
+
+  // can't use a ByteStream here, since it can only append to existing files
+  auto fp = FileSystem::OpenManagedCFile(m_cache_filename.c_str(), "r+b");
+  if (!fp)
+  {
+    Log_WarningPrintf("Failed to open game list cache '%s' for writing", m_cache_filename.c_str());
+    return;
+  }
+
+  // records are written out with their padding, so the file always covers the data
+  bool result = true;
+  std::vector<u8> record;
+  for (size_t i = 0; i < changed_entries.size(); i++)
+  {
+    record.assign(writes[i].second, 0);
+    WriteCacheRecord(*changed_entries[i], record.data());
+    result &= (std::fseek(fp.get(), static_cast<long>(writes[i].first), SEEK_SET) == 0 &&
+               std::fwrite(record.data(), record.size(), 1, fp.get()) == 1);
+  }
+
+  // Index and header last. The new records are all past the old data size, so slots pointing at them are ignored
+  // until the header is written, and a partial write leaves the old entries intact.
+  result &= (std::fseek(fp.get(), sizeof(header), SEEK_SET) == 0 &&
+             std::fwrite(slots.data(), sizeof(PathIndexSlot) * slots.size(), 1, fp.get()) == 1 &&
+             std::fflush(fp.get()) == 0 && std::fseek(fp.get(), 0, SEEK_SET) == 0 &&
+             std::fwrite(&header, sizeof(header), 1, fp.get()) == 1 && std::fflush(fp.get()) == 0);
+  fp.reset();
+
+  if (!result)
+  {
+    Log_WarningPrintf("Failed to update game list cache '%s'", m_cache_filename.c_str());
+    DeleteCacheFile();
+  }
 }
 
-bool GameList::OpenCacheForWriting()
+void GameList::CompactCache(const std::vector<const GameListEntry*>& changed_entries)
 {
-  if (m_cache_filename.empty())
-    return false;
+  // keep the records for entries which haven't changed, including ones for files we didn't scan this time
+  std::unordered_set<std::string_view> changed_paths;
+  for (const GameListEntry* entry : changed_entries)
+    changed_paths.insert(entry->path);
 
-  Assert(!m_cache_write_stream);
-  m_cache_write_stream =
-    FileSystem::OpenFile(m_cache_filename.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE |
-                                                     BYTESTREAM_OPEN_APPEND | BYTESTREAM_OPEN_STREAMED);
-  if (!m_cache_write_stream)
-    return false;
-
-  if (m_cache_write_stream->GetPosition() == 0)
+  std::vector<std::pair<u32, const CacheRecordHeader*>> kept_records;
+  if (m_cache_mapping)
   {
-    // new cache file, write header
-    if (!WriteU32(m_cache_write_stream.get(), GAME_LIST_CACHE_SIGNATURE) ||
-        !WriteU32(m_cache_write_stream.get(), GAME_LIST_CACHE_VERSION))
+    const CacheHeader* old_header = reinterpret_cast<const CacheHeader*>(m_cache_mapping->GetData());
+    const PathIndexSlot* old_slots = reinterpret_cast<const PathIndexSlot*>(old_header + 1);
+    for (u32 i = 0; i < old_header->slot_count; i++)
     {
-      Log_ErrorPrintf("Failed to write game list cache header");
-      m_cache_write_stream.reset();
-      FileSystem::DeleteFile(m_cache_filename.c_str());
-      return false;
+      std::string_view path;
+      const CacheRecordHeader* rh = (old_slots[i].value != 0) ? GetCacheRecord(old_slots[i].value, &path) : nullptr;
+      if (rh && changed_paths.find(path) == changed_paths.end())
+        kept_records.emplace_back(old_slots[i].hash, rh);
     }
   }
 
-  return true;
-}
+  CacheHeader header = {};
+  header.signature = GAME_LIST_CACHE_SIGNATURE;
+  header.version = GAME_LIST_CACHE_VERSION;
+  header.record_count = static_cast<u32>(kept_records.size() + changed_entries.size());
+  header.slot_count = GetPathIndexSlotCount(header.record_count);
+
+  std::vector<u8> data(sizeof(CacheHeader) + sizeof(PathIndexSlot) * header.slot_count);
+  data.resize(Common::AlignUpPow2(data.size(), GAME_LIST_CACHE_RECORD_ALIGNMENT));
+  auto add_record = [&data, &header](u32 hash, u32 size) {
+    // paths are unique, so this only finds free slots
+    PathIndexSlot* slots = reinterpret_cast<PathIndexSlot*>(data.data() + sizeof(CacheHeader));
+    const u32 slot = FindPathIndexSlot(slots, header.slot_count, hash, [](u32) { return false; });
+    const u32 offset = static_cast<u32>(data.size());
+    slots[slot] = {hash, offset};
+    data.resize(data.size() + Common::AlignUpPow2(size, GAME_LIST_CACHE_RECORD_ALIGNMENT));
+    return data.data() + offset;
+  };
+
+  for (const auto& [hash, rh] : kept_records)
+  {
+    const u32 size = GetCacheRecordSize(*rh);
+    u8* record = add_record(hash, size);
+    std::memcpy(record, rh, size);
+  }
 
-bool GameList::WriteEntryToCache(const GameListEntry* entry, ByteStream* stream)
-{
-  bool result = WriteString(stream, entry->path);
-  result &= WriteString(stream, entry->code);
-  result &= WriteString(stream, entry->title);
-  result &= WriteU64(stream, entry->total_size);
-  result &= WriteU64(stream, entry->last_modified_time);
-  result &= WriteU8(stream, static_cast<u8>(entry->region));
-  result &= WriteU8(stream, static_cast<u8>(entry->type));
-  return result;
-}
+  for (const GameListEntry* entry : changed_entries)
+  {
+    const u32 size = GetCacheRecordSize(*entry);
+    u8* record = add_record(HashPath(entry->path), size);
+    WriteCacheRecord(*entry, record);
+  }
 
-void GameList::CloseCacheFileStream()
-{
-  if (!m_cache_write_stream)
+  header.data_size = static_cast<u32>(data.size());
+  std::memcpy(data.data(), &header, sizeof(header));
+  CloseCache();
+
+  if (data.size() > static_cast<size_t>(std::numeric_limits<s32>::max()))
+  {
+    Log_WarningPrintf("Game list cache is too large");
+    DeleteCacheFile();
     return;
+  }
 
-  m_cache_write_stream->Commit();
-  m_cache_write_stream.reset();
+  std::unique_ptr<ByteStream> stream =
+    FileSystem::OpenFile(m_cache_filename.c_str(),
+                         BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
+                           BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_CREATE_PATH | BYTESTREAM_OPEN_STREAMED);
+  if (!stream || !stream->Write2(data.data(), static_cast<u32>(data.size())) || !stream->Commit())
+  {
+    Log_WarningPrintf("Failed to write game list cache '%s'", m_cache_filename.c_str());
+    return;
+  }
+
+  Log_InfoPrintf("Wrote game list cache with %u entries (%u changed)", header.record_count,
+                 static_cast<u32>(changed_entries.size()));
 }
 
 void GameList::DeleteCacheFile()
 {
-  Assert(!m_cache_write_stream);
+  CloseCache();
   if (!FileSystem::FileExists(m_cache_filename.c_str()))
     return;
 
@@ -505,15 +781,28 @@ void GameList::DeleteCacheFile()
     Log_WarningPrintf("Failed to delete game list cache '%s'", m_cache_filename.c_str());
 }
 
-void GameList::ScanDirectory(const char* path, bool recursive)
+void GameList::BuildEntryIndex()
+{
+  m_entry_index.clear();
+  m_entry_index.resize(GetPathIndexSlotCount(static_cast<u32>(m_entries.size())));
+  for (u32 i = 0; i < static_cast<u32>(m_entries.size()); i++)
+  {
+    const u32 hash = HashPath(m_entries[i].path);
+    const u32 slot =
+      FindPathIndexSlot(m_entry_index.data(), static_cast<u32>(m_entry_index.size()), hash, [](u32) { return false; });
+    m_entry_index[slot] = {hash, i + 1};
+  }
+}
+
+void GameList::ScanDirectory(const char* path, bool recursive, std::unordered_set<std::string>* seen_paths,
+                             std::vector<FILESYSTEM_FIND_DATA>* files)
 {
   Log_DevPrintf("Scanning %s%s", path, recursive ? " (recursively)" : "");
 
-  FileSystem::FindResultsArray files;
-  FileSystem::FindFiles(path, "*", FILESYSTEM_FIND_FILES | (recursive ? FILESYSTEM_FIND_RECURSIVE : 0), &files);
+  FileSystem::FindResultsArray found_files;
+  FileSystem::FindFiles(path, "*", FILESYSTEM_FIND_FILES | (recursive ? FILESYSTEM_FIND_RECURSIVE : 0), &found_files);
 
-  GameListEntry entry;
-  for (const FILESYSTEM_FIND_DATA& ffd : files)
+  for (FILESYSTEM_FIND_DATA& ffd : found_files)
   {
     // if this is a .bin, check if we have a .cue. if there is one, skip it
     const char* extension = std::strrchr(ffd.FileName.c_str(), '.');
@@ -533,41 +822,98 @@ void GameList::ScanDirectory(const char* path, bool recursive)
 #endif
     }
 
-    std::string entry_path(ffd.FileName);
-    if (std::any_of(m_entries.begin(), m_entries.end(),
-                    [&entry_path](const GameListEntry& other) { return other.path == entry_path; }))
-    {
+    // directories can overlap when some are recursive
+    if (!seen_paths->insert(ffd.FileName).second)
       continue;
-    }
-    Log_DebugPrintf("Trying '%s'...", entry_path.c_str());
 
-    // try opening the image
-    if (!GetGameListEntryFromCache(entry_path, &entry) ||
-        entry.last_modified_time != ffd.ModificationTime.AsUnixTimestamp())
+    files->push_back(std::move(ffd));
+  }
+}
+
+void GameList::ProbeFiles(const std::vector<FILESYSTEM_FIND_DATA>& files, const std::vector<u32>& indices,
+                          std::vector<GameListEntry>* entries, std::vector<u8>* entry_valid)
+{
+  // Probing is mostly waiting for the disk (or network), so use at least a few threads even on small machines.
+  const u32 thread_count =
+    std::min(std::max<u32>(std::thread::hardware_concurrency(), MIN_SCAN_THREADS), static_cast<u32>(indices.size()));
+
+  std::atomic<u32> next_index{0};
+  const auto ThreadEntryPoint = [this, &files, &indices, entries, entry_valid, &next_index]() {
+    for (u32 i = next_index++; i < indices.size(); i = next_index++)
     {
-      if (GetGameListEntry(entry_path, &entry))
-      {
-        if (m_cache_write_stream || OpenCacheForWriting())
-        {
-          if (!WriteEntryToCache(&entry, m_cache_write_stream.get()))
-            Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
-        }
-      }
-      else
-      {
-        continue;
-      }
+      const u32 file_index = indices[i];
+      Log_DebugPrintf("Trying '%s'...", files[file_index].FileName.c_str());
+      (*entry_valid)[file_index] = GetGameListEntry(files[file_index].FileName, &(*entries)[file_index]);
     }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (u32 i = 0; i < thread_count; i++)
+    threads.emplace_back(ThreadEntryPoint);
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+struct GameList::CompiledDatabaseHeader
+{
+  u32 signature;
+  u32 version;
+  u64 source_size;
+  u64 source_modified_time;
+  u32 code_count;
+  u32 hash_count;
+  u32 string_table_size;
+  u32 reserved;
+};
+
+// Sorted by code, followed by the hash entries sorted by hash, then the null-terminated strings.
+struct GameList::CompiledDatabaseCodeEntry
+{
+  u32 code_offset;
+  u32 title_offset;
+  u32 region;
+};
+
+struct GameList::CompiledDatabaseHashEntry
+{
+  GameListTrackHash hash;
+  u32 code_index;
+};
 
-    m_entries.push_back(std::move(entry));
-    entry = {};
+static bool ParseTrackHash(const char* str, GameListTrackHash* hash)
+{
+  const auto HexDigit = [](char ch) -> int {
+    if (ch >= '0' && ch <= '9')
+      return ch - '0';
+    else if (ch >= 'a' && ch <= 'f')
+      return ch - 'a' + 10;
+    else if (ch >= 'A' && ch <= 'F')
+      return ch - 'A' + 10;
+    else
+      return -1;
+  };
+
+  for (u8& byte : *hash)
+  {
+    const int high = HexDigit(*(str++));
+    const int low = (high >= 0) ? HexDigit(*(str++)) : -1;
+    if (low < 0)
+      return false;
+
+    byte = static_cast<u8>((high << 4) | low);
   }
+
+  return (*str == '\0');
 }
 
 class GameList::RedumpDatVisitor final : public tinyxml2::XMLVisitor
 {
 public:
-  RedumpDatVisitor(DatabaseMap& database) : m_database(database) {}
+  RedumpDatVisitor(DatabaseMap& database, HashDatabaseMap& hash_database)
+    : m_database(database), m_hash_database(hash_database)
+  {
+  }
 
   static std::string FixupSerial(const std::string_view str)
   {
@@ -612,18 +958,14 @@ public:
     // Handle entries like <serial>SCES-00984, SCES-00984#</serial>
     const char* start = serial_text;
     const char* end = std::strchr(start, ',');
+    std::string first_code;
     for (;;)
     {
       std::string code = FixupSerial(end ? std::string_view(start, end - start) : std::string_view(start));
-      auto iter = m_database.find(code);
-      if (iter == m_database.end())
-      {
-        GameListDatabaseEntry gde;
-        gde.code = std::move(code);
-        gde.region = GameList::GetRegionForCode(gde.code).value_or(ConsoleRegion::NTSC_U);
-        gde.title = name;
-        m_database.emplace(gde.code, std::move(gde));
-      }
+      if (first_code.empty())
+        first_code = code;
+
+      m_database.emplace(std::move(code), name);
 
       if (!end)
         break;
@@ -635,11 +977,22 @@ public:
       end = std::strchr(start, ',');
     }
 
+    // <rom name="Game (Track 1).bin" size="..." crc="..." md5="..." sha1="..."/>
+    for (const tinyxml2::XMLElement* rom_elem = element.FirstChildElement("rom"); rom_elem;
+         rom_elem = rom_elem->NextSiblingElement("rom"))
+    {
+      const char* md5 = rom_elem->Attribute("md5");
+      GameListTrackHash hash;
+      if (md5 && ParseTrackHash(md5, &hash))
+        m_hash_database.emplace(hash, first_code);
+    }
+
     return false;
   }
 
 private:
   DatabaseMap& m_database;
+  HashDatabaseMap& m_hash_database;
 };
 
 void GameList::AddDirectory(std::string path, bool recursive)
@@ -657,23 +1010,58 @@ void GameList::AddDirectory(std::string path, bool recursive)
 
 const GameListEntry* GameList::GetEntryForPath(const char* path) const
 {
-  const size_t path_length = std::strlen(path);
-  for (const GameListEntry& entry : m_entries)
-  {
-    if (entry.path.size() == path_length && StringUtil::Strcasecmp(entry.path.c_str(), path) == 0)
-      return &entry;
-  }
+  if (m_entry_index.empty())
+    return nullptr;
+
+  const u32 slot = FindPathIndexSlot(
+    m_entry_index.data(), static_cast<u32>(m_entry_index.size()), HashPath(path),
+    [this, path](u32 value) { return (StringUtil::Strcasecmp(m_entries[value - 1].path.c_str(), path) == 0); });
+  if (slot == m_entry_index.size() || m_entry_index[slot].value == 0)
+    return nullptr;
 
-  return nullptr;
+  return &m_entries[m_entry_index[slot].value - 1];
 }
 
-const GameListDatabaseEntry* GameList::GetDatabaseEntryForCode(const std::string& code) const
+bool GameList::GetDatabaseEntryForCode(std::string_view code, GameListDatabaseEntry* entry) const
 {
   if (!m_database_load_tried)
     const_cast<GameList*>(this)->LoadDatabase();
 
-  auto iter = m_database.find(code);
-  return (iter != m_database.end()) ? &iter->second : nullptr;
+  const CompiledDatabaseCodeEntry* begin = m_database_codes;
+  const CompiledDatabaseCodeEntry* end = m_database_codes + m_database_code_count;
+  const CompiledDatabaseCodeEntry* iter =
+    std::lower_bound(begin, end, code, [this](const CompiledDatabaseCodeEntry& ce, std::string_view value) {
+      return std::string_view(m_database_strings + ce.code_offset) < value;
+    });
+  if (iter == end || std::string_view(m_database_strings + iter->code_offset) != code)
+    return false;
+
+  *entry = GetDatabaseEntry(static_cast<u32>(iter - begin));
+  return true;
+}
+
+bool GameList::GetDatabaseEntryForTrackHash(const GameListTrackHash& hash, GameListDatabaseEntry* entry) const
+{
+  if (!m_database_load_tried)
+    const_cast<GameList*>(this)->LoadDatabase();
+
+  const CompiledDatabaseHashEntry* end = m_database_hashes + m_database_hash_count;
+  const CompiledDatabaseHashEntry* iter = std::lower_bound(
+    m_database_hashes, end, hash,
+    [](const CompiledDatabaseHashEntry& he, const GameListTrackHash& value) { return he.hash < value; });
+  if (iter == end || iter->hash != hash)
+    return false;
+
+  *entry = GetDatabaseEntry(iter->code_index);
+  return true;
+}
+
+GameListDatabaseEntry GameList::GetDatabaseEntry(u32 index) const
+{
+  const CompiledDatabaseCodeEntry& ce = m_database_codes[index];
+  return GameListDatabaseEntry{std::string_view(m_database_strings + ce.code_offset),
+                               std::string_view(m_database_strings + ce.title_offset),
+                               static_cast<ConsoleRegion>(ce.region)};
 }
 
 void GameList::SetSearchDirectoriesFromSettings(SettingsInterface& si)
@@ -696,6 +1084,8 @@ bool GameList::IsDatabasePresent() const
 
 void GameList::Refresh(bool invalidate_cache, bool invalidate_database)
 {
+  Common::Timer timer;
+
   if (invalidate_cache)
     DeleteCacheFile();
   else
@@ -705,13 +1095,53 @@ void GameList::Refresh(bool invalidate_cache, bool invalidate_database)
     ClearDatabase();
 
   m_entries.clear();
+  m_entry_index.clear();
 
+  std::unordered_set<std::string> seen_paths;
+  std::vector<FILESYSTEM_FIND_DATA> files;
   for (const DirectoryEntry& de : m_search_directories)
-    ScanDirectory(de.path.c_str(), de.recursive);
+    ScanDirectory(de.path.c_str(), de.recursive, &seen_paths, &files);
+
+  // unchanged files come from the cache, everything else has to be opened
+  std::vector<GameListEntry> entries(files.size());
+  std::vector<u8> entry_valid(files.size());
+  std::vector<u32> probe_indices;
+  for (u32 i = 0; i < static_cast<u32>(files.size()); i++)
+  {
+    entry_valid[i] = GetGameListEntryFromCache(files[i], &entries[i]);
+    if (!entry_valid[i])
+      probe_indices.push_back(i);
+  }
+
+  if (!probe_indices.empty())
+  {
+    // the database is loaded on demand, which isn't thread-safe
+    LoadDatabase();
+    ProbeFiles(files, probe_indices, &entries, &entry_valid);
+
+    std::vector<const GameListEntry*> changed_entries;
+    for (const u32 index : probe_indices)
+    {
+      if (entry_valid[index])
+        changed_entries.push_back(&entries[index]);
+    }
+
+    UpdateCache(changed_entries);
+  }
 
-  // don't need unused cache entries
-  CloseCacheFileStream();
-  m_cache_map.clear();
+  CloseCache();
+
+  m_entries.reserve(files.size());
+  for (u32 i = 0; i < static_cast<u32>(files.size()); i++)
+  {
+    if (entry_valid[i])
+      m_entries.push_back(std::move(entries[i]));
+  }
+
+  BuildEntryIndex();
+
+  Log_InfoPrintf("Found %zu games in %zu files (%zu scanned) in %.2f seconds", m_entries.size(), files.size(),
+                 probe_indices.size(), timer.GetTimeSeconds());
 }
 
 void GameList::LoadDatabase()
@@ -723,29 +1153,205 @@ void GameList::LoadDatabase()
   if (m_database_filename.empty())
     return;
 
+  // the compiled database is only used if it was built from the current dat
+  FILESYSTEM_STAT_DATA source_sd;
+  const bool source_present = FileSystem::StatFile(m_database_filename.c_str(), &source_sd);
+  if (!m_compiled_database_filename.empty())
+  {
+    m_database_mapping = MemoryMappedFile::Open(m_compiled_database_filename.c_str());
+    if (m_database_mapping && OpenCompiledDatabase(m_database_mapping->GetData(), m_database_mapping->GetSize(),
+                                                   source_present ? &source_sd : nullptr))
+    {
+      Log_InfoPrintf("Loaded %u entries from compiled database '%s'", m_database_code_count,
+                     m_compiled_database_filename.c_str());
+      return;
+    }
+
+    m_database_mapping.reset();
+  }
+
+  if (!source_present)
+    return;
+
+  Common::Timer timer;
+  std::vector<u8> data;
+  if (!CompileDatabase(&data, source_sd))
+    return;
+
+  Log_InfoPrintf("Compiled Redump.org database '%s' in %.2f ms", m_database_filename.c_str(),
+                 timer.GetTimeMilliseconds());
+
+  // write it out for next time, and map it back in so the pages can be shared and dropped
+  if (!m_compiled_database_filename.empty())
+  {
+    std::unique_ptr<ByteStream> stream =
+      FileSystem::OpenFile(m_compiled_database_filename.c_str(),
+                           BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
+                             BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_CREATE_PATH | BYTESTREAM_OPEN_STREAMED);
+    if (stream && stream->Write2(data.data(), static_cast<u32>(data.size())) && stream->Commit())
+    {
+      stream.reset();
+      m_database_mapping = MemoryMappedFile::Open(m_compiled_database_filename.c_str());
+      if (m_database_mapping &&
+          OpenCompiledDatabase(m_database_mapping->GetData(), m_database_mapping->GetSize(), &source_sd))
+      {
+        return;
+      }
+
+      m_database_mapping.reset();
+    }
+    else
+    {
+      Log_WarningPrintf("Failed to write compiled database '%s'", m_compiled_database_filename.c_str());
+    }
+  }
+
+  m_database_memory = std::move(data);
+  OpenCompiledDatabase(m_database_memory.data(), m_database_memory.size(), &source_sd);
+}
+
+bool GameList::OpenCompiledDatabase(const u8* data, u64 size, const FILESYSTEM_STAT_DATA* source_sd)
+{
+  if (size < sizeof(CompiledDatabaseHeader))
+    return false;
+
+  const CompiledDatabaseHeader* header = reinterpret_cast<const CompiledDatabaseHeader*>(data);
+  if (header->signature != COMPILED_DATABASE_SIGNATURE || header->version != COMPILED_DATABASE_VERSION)
+    return false;
+
+  if (source_sd && (header->source_size != source_sd->Size ||
+                    header->source_modified_time != source_sd->ModificationTime.AsUnixTimestamp()))
+  {
+    Log_InfoPrintf("Compiled database is out of date");
+    return false;
+  }
+
+  const u64 codes_size = static_cast<u64>(header->code_count) * sizeof(CompiledDatabaseCodeEntry);
+  const u64 hashes_size = static_cast<u64>(header->hash_count) * sizeof(CompiledDatabaseHashEntry);
+  if ((sizeof(CompiledDatabaseHeader) + codes_size + hashes_size + header->string_table_size) != size)
+  {
+    Log_WarningPrintf("Compiled database is corrupted");
+    return false;
+  }
+
+  // check everything once here, so lookups don't have to
+  const u8* ptr = data + sizeof(CompiledDatabaseHeader);
+  const CompiledDatabaseCodeEntry* codes = reinterpret_cast<const CompiledDatabaseCodeEntry*>(ptr);
+  const CompiledDatabaseHashEntry* hashes = reinterpret_cast<const CompiledDatabaseHashEntry*>(ptr + codes_size);
+  const char* strings = reinterpret_cast<const char*>(ptr + codes_size + hashes_size);
+  const u32 string_table_size = header->string_table_size;
+  if (string_table_size == 0 || strings[string_table_size - 1] != '\0' ||
+      std::any_of(codes, codes + header->code_count,
+                  [string_table_size](const CompiledDatabaseCodeEntry& ce) {
+                    return (ce.code_offset >= string_table_size || ce.title_offset >= string_table_size ||
+                            ce.region >= static_cast<u32>(ConsoleRegion::Count));
+                  }) ||
+      std::any_of(hashes, hashes + header->hash_count,
+                  [code_count = header->code_count](const CompiledDatabaseHashEntry& he) {
+                    return (he.code_index >= code_count);
+                  }))
+  {
+    Log_WarningPrintf("Compiled database is corrupted");
+    return false;
+  }
+
+  m_database_codes = codes;
+  m_database_hashes = hashes;
+  m_database_strings = strings;
+  m_database_code_count = header->code_count;
+  m_database_hash_count = header->hash_count;
+  return true;
+}
+
+bool GameList::CompileDatabase(std::vector<u8>* data, const FILESYSTEM_STAT_DATA& source_sd)
+{
   tinyxml2::XMLDocument doc;
   tinyxml2::XMLError error = doc.LoadFile(m_database_filename.c_str());
   if (error != tinyxml2::XML_SUCCESS)
   {
     Log_ErrorPrintf("Failed to parse redump dat '%s': %s", m_database_filename.c_str(),
                     tinyxml2::XMLDocument::ErrorIDToName(error));
-    return;
+    return false;
   }
 
   const tinyxml2::XMLElement* datafile_elem = doc.FirstChildElement("datafile");
   if (!datafile_elem)
   {
     Log_ErrorPrintf("Failed to get datafile element in '%s'", m_database_filename.c_str());
-    return;
+    return false;
   }
 
-  RedumpDatVisitor visitor(m_database);
+  DatabaseMap database;
+  HashDatabaseMap hash_database;
+  RedumpDatVisitor visitor(database, hash_database);
   datafile_elem->Accept(&visitor);
-  Log_InfoPrintf("Loaded %zu entries from Redump.org database '%s'", m_database.size(), m_database_filename.c_str());
+
+  // titles are shared between all the codes for a game
+  std::string strings;
+  std::unordered_map<std::string_view, u32> string_offsets;
+  const auto AddString = [&strings, &string_offsets](std::string_view str) {
+    auto iter = string_offsets.find(str);
+    if (iter != string_offsets.end())
+      return iter->second;
+
+    const u32 offset = static_cast<u32>(strings.size());
+    strings.append(str);
+    strings.push_back('\0');
+    string_offsets.emplace(str, offset);
+    return offset;
+  };
+
+  // the maps are already sorted the way lookups search them
+  std::vector<CompiledDatabaseCodeEntry> codes;
+  std::unordered_map<std::string_view, u32> code_indices;
+  codes.reserve(database.size());
+  for (const auto& it : database)
+  {
+    code_indices.emplace(it.first, static_cast<u32>(codes.size()));
+    codes.push_back(CompiledDatabaseCodeEntry{
+      AddString(it.first), AddString(it.second),
+      static_cast<u32>(GetRegionForCode(it.first).value_or(ConsoleRegion::NTSC_U))});
+  }
+
+  std::vector<CompiledDatabaseHashEntry> hashes;
+  hashes.reserve(hash_database.size());
+  for (const auto& it : hash_database)
+  {
+    auto iter = code_indices.find(it.second);
+    if (iter != code_indices.end())
+      hashes.push_back(CompiledDatabaseHashEntry{it.first, iter->second});
+  }
+
+  CompiledDatabaseHeader header = {};
+  header.signature = COMPILED_DATABASE_SIGNATURE;
+  header.version = COMPILED_DATABASE_VERSION;
+  header.source_size = source_sd.Size;
+  header.source_modified_time = source_sd.ModificationTime.AsUnixTimestamp();
+  header.code_count = static_cast<u32>(codes.size());
+  header.hash_count = static_cast<u32>(hashes.size());
+  header.string_table_size = static_cast<u32>(strings.size());
+
+  const u8* header_bytes = reinterpret_cast<const u8*>(&header);
+  const u8* codes_bytes = reinterpret_cast<const u8*>(codes.data());
+  const u8* hashes_bytes = reinterpret_cast<const u8*>(hashes.data());
+  data->clear();
+  data->reserve(sizeof(header) + codes.size() * sizeof(CompiledDatabaseCodeEntry) +
+                hashes.size() * sizeof(CompiledDatabaseHashEntry) + strings.size());
+  data->insert(data->end(), header_bytes, header_bytes + sizeof(header));
+  data->insert(data->end(), codes_bytes, codes_bytes + codes.size() * sizeof(CompiledDatabaseCodeEntry));
+  data->insert(data->end(), hashes_bytes, hashes_bytes + hashes.size() * sizeof(CompiledDatabaseHashEntry));
+  data->insert(data->end(), strings.begin(), strings.end());
+  return true;
 }
 
 void GameList::ClearDatabase()
 {
-  m_database.clear();
+  m_database_codes = nullptr;
+  m_database_hashes = nullptr;
+  m_database_strings = nullptr;
+  m_database_code_count = 0;
+  m_database_hash_count = 0;
+  m_database_mapping.reset();
+  m_database_memory = {};
   m_database_load_tried = false;
 }
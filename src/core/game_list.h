@@ -1,14 +1,19 @@
 #pragma once
 #include "types.h"
+#include <array>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class CDImage;
-class ByteStream;
+class MemoryMappedFile;
+struct FILESYSTEM_FIND_DATA;
+struct FILESYSTEM_STAT_DATA;
 
 class SettingsInterface;
 
@@ -18,22 +23,28 @@ enum class GameListEntryType
   PSExe
 };
 
+/// Points into the compiled database, so only valid until the database is reloaded.
 struct GameListDatabaseEntry
 {
-  std::string code;
-  std::string title;
+  std::string_view code;
+  std::string_view title;
   ConsoleRegion region;
 };
 
+/// MD5 of a track's sectors, as listed in the Redump database.
+using GameListTrackHash = std::array<u8, 16>;
+
 struct GameListEntry
 {
   std::string path;
   std::string code;
   std::string title;
   u64 total_size;
+  u64 file_size;
   u64 last_modified_time;
   ConsoleRegion region;
   GameListEntryType type;
+  std::vector<GameListTrackHash> track_hashes;
 };
 
 class GameList
@@ -57,19 +68,30 @@ public:
   static std::optional<ConsoleRegion> GetRegionForPath(const char* image_path);
   static std::string_view GetTitleForPath(const char* path);
 
+  /// Computes the MD5 of every track in the image. This reads the whole image, so it's slow.
+  static bool ComputeTrackHashes(CDImage* cdi, std::vector<GameListTrackHash>* hashes);
+  static std::string TrackHashToString(const GameListTrackHash& hash);
+
   const EntryList& GetEntries() const { return m_entries; }
   const u32 GetEntryCount() const { return static_cast<u32>(m_entries.size()); }
 
   const GameListEntry* GetEntryForPath(const char* path) const;
-  const GameListDatabaseEntry* GetDatabaseEntryForCode(const std::string& code) const;
+  bool GetDatabaseEntryForCode(std::string_view code, GameListDatabaseEntry* entry) const;
+  bool GetDatabaseEntryForTrackHash(const GameListTrackHash& hash, GameListDatabaseEntry* entry) const;
 
   const std::string& GetCacheFilename() const { return m_cache_filename; }
   const std::string& GetDatabaseFilename() const { return m_database_filename; }
+  const std::string& GetCompiledDatabaseFilename() const { return m_compiled_database_filename; }
 
   void SetCacheFilename(std::string filename) { m_cache_filename = std::move(filename); }
   void SetDatabaseFilename(std::string filename) { m_database_filename = std::move(filename); }
+  void SetCompiledDatabaseFilename(std::string filename) { m_compiled_database_filename = std::move(filename); }
   void SetSearchDirectoriesFromSettings(SettingsInterface& si);
 
+  /// Track hashes identify images without a game code, or with one which isn't in the database.
+  bool GetComputeTrackHashes() const { return m_compute_track_hashes; }
+  void SetComputeTrackHashes(bool enabled) { m_compute_track_hashes = enabled; }
+
   bool IsDatabasePresent() const;
 
   void AddDirectory(std::string path, bool recursive);
@@ -79,11 +101,18 @@ private:
   enum : u32
   {
     GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
-    GAME_LIST_CACHE_VERSION = 2
+    GAME_LIST_CACHE_VERSION = 5,
+    GAME_LIST_CACHE_RECORD_ALIGNMENT = 16,
+    MIN_PATH_INDEX_SLOTS = 64,
+    MAX_TRACK_HASHES = 99,
+    MIN_SCAN_THREADS = 4,
+    COMPILED_DATABASE_SIGNATURE = 0x42444C47,
+    COMPILED_DATABASE_VERSION = 1
   };
 
-  using DatabaseMap = std::unordered_map<std::string, GameListDatabaseEntry>;
-  using CacheMap = std::unordered_map<std::string, GameListEntry>;
+  // Code -> title, and track hash -> code, only used while compiling the database.
+  using DatabaseMap = std::map<std::string, std::string>;
+  using HashDatabaseMap = std::map<GameListTrackHash, std::string>;
 
   struct DirectoryEntry
   {
@@ -91,31 +120,69 @@ private:
     bool recursive;
   };
 
+  /// Open-addressed hash table slot, shared by the cache file and the entry list. Value is zero if the slot is unused.
+  struct PathIndexSlot
+  {
+    u32 hash;
+    u32 value;
+  };
+
   class RedumpDatVisitor;
+  struct CompiledDatabaseHeader;
+  struct CompiledDatabaseCodeEntry;
+  struct CompiledDatabaseHashEntry;
+  struct CacheHeader;
+  struct CacheRecordHeader;
 
   static bool GetExeListEntry(const char* path, GameListEntry* entry);
 
+  static u32 GetCacheRecordSize(const GameListEntry& entry);
+  static u32 GetCacheRecordSize(const CacheRecordHeader& rh);
+  static void WriteCacheRecord(const GameListEntry& entry, u8* data);
+  static u32 HashPath(std::string_view path);
+  static u32 GetPathIndexSlotCount(u32 entry_count);
+  template<typename T>
+  static u32 FindPathIndexSlot(const PathIndexSlot* slots, u32 slot_count, u32 hash, const T& is_match);
+
   bool GetGameListEntry(const std::string& path, GameListEntry* entry);
-  bool GetGameListEntryFromCache(const std::string& path, GameListEntry* entry);
-  void ScanDirectory(const char* path, bool recursive);
+  bool GetGameListEntryFromCache(const FILESYSTEM_FIND_DATA& ffd, GameListEntry* entry);
+  void ScanDirectory(const char* path, bool recursive, std::unordered_set<std::string>* seen_paths,
+                     std::vector<FILESYSTEM_FIND_DATA>* files);
+  void ProbeFiles(const std::vector<FILESYSTEM_FIND_DATA>& files, const std::vector<u32>& indices,
+                  std::vector<GameListEntry>* entries, std::vector<u8>* entry_valid);
 
   void LoadCache();
-  bool LoadEntriesFromCache(ByteStream* stream);
-  bool OpenCacheForWriting();
-  bool WriteEntryToCache(const GameListEntry* entry, ByteStream* stream);
-  void CloseCacheFileStream();
+  void CloseCache();
+  const CacheRecordHeader* GetCacheRecord(u32 offset, std::string_view* path) const;
+  void UpdateCache(const std::vector<const GameListEntry*>& changed_entries);
+  void CompactCache(const std::vector<const GameListEntry*>& changed_entries);
   void DeleteCacheFile();
+  void BuildEntryIndex();
 
   void LoadDatabase();
+  bool OpenCompiledDatabase(const u8* data, u64 size, const FILESYSTEM_STAT_DATA* source_sd);
+  bool CompileDatabase(std::vector<u8>* data, const FILESYSTEM_STAT_DATA& source_sd);
   void ClearDatabase();
-
-  DatabaseMap m_database;
+  GameListDatabaseEntry GetDatabaseEntry(u32 index) const;
+
+  // The compiled database is mapped from disk, or held in memory if it couldn't be written.
+  std::unique_ptr<MemoryMappedFile> m_database_mapping;
+  std::vector<u8> m_database_memory;
+  const CompiledDatabaseCodeEntry* m_database_codes = nullptr;
+  const CompiledDatabaseHashEntry* m_database_hashes = nullptr;
+  const char* m_database_strings = nullptr;
+  u32 m_database_code_count = 0;
+  u32 m_database_hash_count = 0;
   EntryList m_entries;
-  CacheMap m_cache_map;
-  std::unique_ptr<ByteStream> m_cache_write_stream;
+  std::vector<PathIndexSlot> m_entry_index;
+
+  // Only mapped while refreshing.
+  std::unique_ptr<MemoryMappedFile> m_cache_mapping;
 
   std::vector<DirectoryEntry> m_search_directories;
   std::string m_cache_filename;
   std::string m_database_filename;
+  std::string m_compiled_database_filename;
   bool m_database_load_tried = false;
+  bool m_compute_track_hashes = false;
 };
@@ -3,6 +3,7 @@
 #include "common/log.h"
 #include "common/state_wrapper.h"
 #include "dma.h"
+#include "gpu_dump.h"
 #include "host_interface.h"
 #include "interrupt_controller.h"
 #include "stb_image_write.h"
@@ -37,8 +38,31 @@ void GPU::UpdateSettings()
   m_force_progressive_scan = m_system->GetSettings().gpu_force_progressive_scan;
 }
 
+bool GPU::StartDump(const char* filename, u32 num_frames)
+{
+  m_dump_recorder.reset();
+  if (num_frames == 0)
+    return false;
+
+  m_dump_recorder = GPUDump::Recorder::Create(filename, this, m_system->IsPALRegion(), num_frames);
+  return static_cast<bool>(m_dump_recorder);
+}
+
+void GPU::StopDump()
+{
+  if (!m_dump_recorder)
+    return;
+
+  m_system->GetHostInterface()->AddFormattedOSDMessage(2.0f, "Saved GPU dump to '%s'.",
+                                                       m_dump_recorder->GetFileName().c_str());
+  m_dump_recorder.reset();
+}
+
 void GPU::Reset()
 {
+  // The command stream can't be replayed across a reset or state load.
+  StopDump();
+
   SoftReset();
   m_set_texture_disable_mask = false;
   m_GPUREAD_latch = 0;
@@ -59,7 +83,7 @@ void GPU::SoftReset()
   m_state = State::Idle;
   m_command_total_words = 0;
   m_vram_transfer = {};
-  m_GP0_buffer.clear();
+  m_GP0_buffer.Clear();
   SetDrawMode(0);
   SetTexturePalette(0);
   m_draw_mode.SetTextureWindow(0);
@@ -216,7 +240,12 @@ u32 GPU::ReadRegister(u32 offset)
   switch (offset)
   {
     case 0x00:
+    {
+      if (m_dump_recorder)
+        m_dump_recorder->ReadGPUREAD(1);
+
       return ReadGPUREAD();
+    }
 
     case 0x04:
       return m_GPUSTAT.bits;
@@ -232,12 +261,22 @@ void GPU::WriteRegister(u32 offset, u32 value)
   switch (offset)
   {
     case 0x00:
+    {
+      if (m_dump_recorder)
+        m_dump_recorder->WriteGP0(value);
+
       WriteGP0(value);
       return;
+    }
 
     case 0x04:
+    {
+      if (m_dump_recorder)
+        m_dump_recorder->WriteGP1(value);
+
       WriteGP1(value);
       return;
+    }
 
     default:
       Log_ErrorPrintf("Unhandled register write: %02X <- %08X", offset, value);
@@ -254,6 +293,9 @@ void GPU::DMARead(u32* words, u32 word_count)
     return;
   }
 
+  if (m_dump_recorder)
+    m_dump_recorder->ReadGPUREAD(word_count);
+
   for (u32 i = 0; i < word_count; i++)
     words[i] = ReadGPUREAD();
 }
@@ -264,8 +306,23 @@ void GPU::DMAWrite(const u32* words, u32 word_count)
   {
     case DMADirection::CPUtoGP0:
     {
-      std::copy(words, words + word_count, std::back_inserter(m_GP0_buffer));
-      ExecuteCommands();
+      if (m_dump_recorder)
+        m_dump_recorder->WriteGP0(words, word_count);
+
+      if (m_GP0_buffer.IsEmpty())
+      {
+        // Nothing is pending, so complete commands can be executed straight from the source without copying.
+        const u32 words_used = ExecuteCommands(words, word_count);
+        if (words_used < word_count)
+          m_GP0_buffer.PushRange(words + words_used, word_count - words_used);
+
+        UpdateGPUSTAT();
+      }
+      else
+      {
+        m_GP0_buffer.PushRange(words, word_count);
+        ExecuteCommands();
+      }
     }
     break;
 
@@ -463,6 +520,9 @@ void GPU::Execute(TickCount ticks)
         FlushRender();
         UpdateDisplay();
         m_system->IncrementFrameNumber();
+
+        if (m_dump_recorder && !m_dump_recorder->EndFrame())
+          StopDump();
       }
 
       m_timers->SetGate(HBLANK_TIMER_INDEX, new_vblank);
@@ -541,7 +601,7 @@ u32 GPU::ReadGPUREAD()
 
 void GPU::WriteGP0(u32 value)
 {
-  m_GP0_buffer.push_back(value);
+  m_GP0_buffer.Push(value);
   ExecuteCommands();
 }
 
@@ -564,7 +624,7 @@ void GPU::WriteGP1(u32 value)
       m_state = State::Idle;
       m_command_total_words = 0;
       m_vram_transfer = {};
-      m_GP0_buffer.clear();
+      m_GP0_buffer.Clear();
       UpdateGPUSTAT();
     }
     break;
@@ -848,21 +908,13 @@ bool GPU::DumpVRAMToFile(const char* filename, u32 width, u32 height, u32 stride
 {
   std::vector<u32> rgba8_buf(width * height);
 
-  const char* ptr_in = static_cast<const char*>(buffer);
+  const u8* ptr_in = static_cast<const u8*>(buffer);
   u32* ptr_out = rgba8_buf.data();
   for (u32 row = 0; row < height; row++)
   {
-    const char* row_ptr_in = ptr_in;
-
-    for (u32 col = 0; col < width; col++)
-    {
-      u16 src_col;
-      std::memcpy(&src_col, row_ptr_in, sizeof(u16));
-      row_ptr_in += sizeof(u16);
-      *(ptr_out++) = RGBA5551ToRGBA8888(remove_alpha ? (src_col | u16(0x8000)) : src_col);
-    }
-
+    ConvertRGBA5551ToRGBA8888(reinterpret_cast<const u16*>(ptr_in), ptr_out, width, remove_alpha);
     ptr_in += stride;
+    ptr_out += width;
   }
   return (stbi_write_png(filename, width, height, 4, rgba8_buf.data(), sizeof(u32) * width) != 0);
 }
@@ -925,6 +977,11 @@ void GPU::DrawDebugStateWindow()
     ImGui::Text("%u", stats.num_polygons);
     ImGui::NextColumn();
 
+    ImGui::TextUnformatted("Pixels Drawn (Estimated): ");
+    ImGui::NextColumn();
+    ImGui::Text("%u", stats.num_pixels);
+    ImGui::NextColumn();
+
     ImGui::Columns(1);
   }
 
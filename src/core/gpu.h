@@ -1,5 +1,6 @@
 #pragma once
 #include "common/bitfield.h"
+#include "common/fifo_queue.h"
 #include "common/rectangle.h"
 #include "timers.h"
 #include "types.h"
@@ -20,8 +21,15 @@ class DMA;
 class InterruptController;
 class Timers;
 
+namespace GPUDump {
+class Recorder;
+class Player;
+} // namespace GPUDump
+
 class GPU
 {
+  friend GPUDump::Player;
+
 public:
   enum class State : u8
   {
@@ -92,6 +100,7 @@ public:
     TEXTURE_PAGE_HEIGHT = 256,
     MAX_PRIMITIVE_WIDTH = 1024,
     MAX_PRIMITIVE_HEIGHT = 512,
+    GP0_FIFO_SIZE = 1048576, // in words
     DOT_TIMER_INDEX = 0,
     HBLANK_TIMER_INDEX = 1
   };
@@ -134,6 +143,11 @@ public:
   // Recompile shaders/recreate framebuffers when needed.
   virtual void UpdateSettings();
 
+  /// Starts writing the command stream to a dump file, stopping automatically after num_frames frames.
+  bool StartDump(const char* filename, u32 num_frames);
+  void StopDump();
+  bool IsDumping() const { return static_cast<bool>(m_dump_recorder); }
+
   // gpu_hw_d3d11.cpp
   static std::unique_ptr<GPU> CreateHardwareD3D11Renderer();
 
@@ -191,6 +205,13 @@ protected:
     return ZeroExtend32(r) | (ZeroExtend32(g) << 8) | (ZeroExtend32(b) << 16);
   }
 
+  /// Converts a span of RGBA5551 pixels to RGBA8888, using the fastest path supported by the host CPU.
+  /// If set_alpha is true, the mask bit is ignored and the alpha channel is always set.
+  static void ConvertRGBA5551ToRGBA8888(const u16* src, u32* dst, u32 count, bool set_alpha = false);
+
+  /// Converts a span of packed 24-bit pixels (as used by 24-bit scanout) to RGBA8888 with full alpha.
+  static void ConvertRGB888ToRGBA8888(const u8* src, u32* dst, u32 count);
+
   static bool DumpVRAMToFile(const char* filename, u32 width, u32 height, u32 stride, const void* buffer,
                              bool remove_alpha);
 
@@ -316,6 +337,9 @@ protected:
   void WriteGP0(u32 value);
   void WriteGP1(u32 value);
   void ExecuteCommands();
+
+  /// Executes as many complete commands as possible from a linear buffer. Returns the number of words consumed.
+  u32 ExecuteCommands(const u32* command_ptr, u32 command_size);
   void EndCommand();
   void HandleGetGPUInfoCommand(u32 value);
 
@@ -547,7 +571,12 @@ protected:
   /// GPUREAD value for non-VRAM-reads.
   u32 m_GPUREAD_latch = 0;
 
-  std::vector<u32> m_GP0_buffer;
+  HeapFIFOQueue<u32, GP0_FIFO_SIZE> m_GP0_buffer;
+
+  // Holds a linear copy of the GP0 FIFO when a command straddles the wrap-around point.
+  std::vector<u32> m_GP0_linear_buffer;
+
+  std::unique_ptr<GPUDump::Recorder> m_dump_recorder;
 
   struct Stats
   {
@@ -557,6 +586,7 @@ protected:
     u32 num_vram_copies;
     u32 num_vertices;
     u32 num_polygons;
+    u32 num_pixels; // estimated from primitive sizes, before clipping
   };
   Stats m_stats = {};
   Stats m_last_stats = {};
@@ -583,6 +613,10 @@ private:
   bool HandleCopyRectangleVRAMToCPUCommand(const u32*& command_ptr, u32 command_size);
   bool HandleCopyRectangleVRAMToVRAMCommand(const u32*& command_ptr, u32 command_size);
 
+  // Returns the approximate number of pixels covered by a render command, for statistics.
+  static u32 EstimateRenderCommandPixels(RenderCommand rc, u32 num_vertices, u32 words_per_vertex,
+                                         const u32* command_ptr);
+
   static const GP0CommandHandlerTable s_GP0_command_handler_table;
 };
 
@@ -4,6 +4,7 @@
 #include "gpu.h"
 #include "interrupt_controller.h"
 #include "system.h"
+#include <cstdlib>
 Log_SetChannel(GPU);
 
 #define CHECK_COMMAND_SIZE(num_words)                                                                                  \
@@ -24,10 +25,41 @@ static constexpr u32 ReplaceZero(u32 value, u32 value_for_zero)
 
 void GPU::ExecuteCommands()
 {
-  Assert(m_GP0_buffer.size() < 1048576);
+  while (!m_GP0_buffer.IsEmpty())
+  {
+    const u32 contiguous_size = m_GP0_buffer.GetContiguousSize();
+    u32 words_used = ExecuteCommands(m_GP0_buffer.GetFrontPointer(), contiguous_size);
+    m_GP0_buffer.Remove(words_used);
+    if (words_used == contiguous_size)
+      continue;
+
+    // The current command continues past the wrap-around point. Once all of its words have arrived, execute just that
+    // command from a linear copy, and carry on from the FIFO after it. m_command_total_words is the size of the command,
+    // or for polylines the number of words needed to see the next possible terminator, so an incomplete command isn't
+    // copied again until more words arrive.
+    const u32 remaining_size = m_GP0_buffer.GetSize();
+    const u32 remaining_contiguous_size = m_GP0_buffer.GetContiguousSize();
+    if (m_state == State::ReadingVRAM || remaining_size == remaining_contiguous_size ||
+        remaining_size < m_command_total_words)
+    {
+      break;
+    }
 
-  const u32* command_ptr = m_GP0_buffer.data();
-  u32 command_size = static_cast<u32>(m_GP0_buffer.size());
+    const u32 command_size = m_command_total_words;
+    m_GP0_linear_buffer.resize(command_size);
+    m_GP0_buffer.PeekRange(m_GP0_linear_buffer.data(), command_size);
+    words_used = ExecuteCommands(m_GP0_linear_buffer.data(), command_size);
+    m_GP0_buffer.Remove(words_used);
+    if (words_used == 0)
+      break;
+  }
+
+  UpdateGPUSTAT();
+}
+
+u32 GPU::ExecuteCommands(const u32* command_ptr, u32 command_size)
+{
+  const u32* const start_command_ptr = command_ptr;
   while (m_state != State::ReadingVRAM && command_size > 0 && command_size >= m_command_total_words)
   {
     const u32 command = command_ptr[0] >> 24;
@@ -40,12 +72,7 @@ void GPU::ExecuteCommands()
     command_size -= words_used;
   }
 
-  if (command_size == 0)
-    m_GP0_buffer.clear();
-  else if (command_ptr > m_GP0_buffer.data())
-    m_GP0_buffer.erase(m_GP0_buffer.begin(), m_GP0_buffer.begin() + (command_ptr - m_GP0_buffer.data()));
-
-  UpdateGPUSTAT();
+  return static_cast<u32>(command_ptr - start_command_ptr);
 }
 
 void GPU::EndCommand()
@@ -255,7 +282,8 @@ bool GPU::HandleRenderCommand(const u32*& command_ptr, u32 command_size)
         // polyline goes until we hit the termination code
         num_vertices = 1;
         bool found_terminator = false;
-        for (u32 pos = 2; pos < command_size; pos += words_per_vertex)
+        u32 pos = 2;
+        for (; pos < command_size; pos += words_per_vertex)
         {
           if (command_ptr[pos] == 0x55555555)
           {
@@ -266,7 +294,12 @@ bool GPU::HandleRenderCommand(const u32*& command_ptr, u32 command_size)
           num_vertices++;
         }
         if (!found_terminator)
+        {
+          // wait until the word where the terminator could next be has arrived
+          m_command_total_words = pos + 1;
+          m_state = State::WaitingForParameters;
           return false;
+        }
 
         total_words = words_per_vertex * num_vertices + BoolToUInt32(!rc.shading_enable) + 1;
       }
@@ -306,9 +339,10 @@ bool GPU::HandleRenderCommand(const u32*& command_ptr, u32 command_size)
                   ZeroExtend32(words_per_vertex));
 
   DispatchRenderCommand(rc, num_vertices, command_ptr);
-  command_ptr += total_words;
   m_stats.num_vertices += num_vertices;
   m_stats.num_polygons++;
+  m_stats.num_pixels += EstimateRenderCommandPixels(rc, num_vertices, words_per_vertex, command_ptr);
+  command_ptr += total_words;
   EndCommand();
   return true;
 }
@@ -431,3 +465,65 @@ bool GPU::HandleCopyRectangleVRAMToVRAMCommand(const u32*& command_ptr, u32 comm
   EndCommand();
   return true;
 }
+
+u32 GPU::EstimateRenderCommandPixels(RenderCommand rc, u32 num_vertices, u32 words_per_vertex, const u32* command_ptr)
+{
+  // Positions are at the same offset for shaded and flat primitives, as the first colour is in the command word.
+  const auto GetPosition = [command_ptr, words_per_vertex](u32 index) -> std::tuple<s32, s32> {
+    const VertexPosition vp{command_ptr[1 + index * words_per_vertex]};
+    return std::make_tuple(static_cast<s32>(vp.x), static_cast<s32>(vp.y));
+  };
+
+  switch (rc.primitive)
+  {
+    case Primitive::Polygon:
+    {
+      const auto GetTriangleArea = [&GetPosition](u32 i0, u32 i1, u32 i2) -> u32 {
+        const auto [x0, y0] = GetPosition(i0);
+        const auto [x1, y1] = GetPosition(i1);
+        const auto [x2, y2] = GetPosition(i2);
+        return static_cast<u32>(std::abs(((x1 - x0) * (y2 - y0)) - ((y1 - y0) * (x2 - x0)))) / 2;
+      };
+
+      u32 pixels = GetTriangleArea(0, 1, 2);
+      if (num_vertices > 3)
+        pixels += GetTriangleArea(2, 1, 3);
+
+      return pixels;
+    }
+
+    case Primitive::Line:
+    {
+      u32 pixels = 0;
+      for (u32 i = 1; i < num_vertices; i++)
+      {
+        const auto [x0, y0] = GetPosition(i - 1);
+        const auto [x1, y1] = GetPosition(i);
+        pixels += static_cast<u32>(std::max(std::abs(x1 - x0), std::abs(y1 - y0))) + 1;
+      }
+
+      return pixels;
+    }
+
+    case Primitive::Rectangle:
+    {
+      switch (rc.rectangle_size)
+      {
+        case DrawRectangleSize::R1x1:
+          return 1;
+        case DrawRectangleSize::R8x8:
+          return 8 * 8;
+        case DrawRectangleSize::R16x16:
+          return 16 * 16;
+        default:
+        {
+          const u32 size = command_ptr[2 + BoolToUInt32(rc.texture_enable)];
+          return (size & 0x3FF) * ((size >> 16) & 0x1FF);
+        }
+      }
+    }
+
+    default:
+      return 0;
+  }
+}
@@ -0,0 +1,221 @@
+#include "common/cpu_detect.h"
+#include "gpu.h"
+
+#if defined(CPU_X64)
+#include <immintrin.h>
+#elif defined(CPU_AARCH64)
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang need the target ISA specified for functions using intrinsics beyond the baseline.
+#if defined(CPU_X64) && !defined(_MSC_VER)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+
+using ConvertRGBA5551Function = void (*)(const u16* src, u32* dst, u32 count, u16 or_mask);
+using ConvertRGB888Function = void (*)(const u8* src, u32* dst, u32 count);
+
+static void ConvertRGBA5551ToRGBA8888_Scalar(const u16* src, u32* dst, u32 count, u16 or_mask)
+{
+  for (u32 i = 0; i < count; i++)
+  {
+    const u16 color = src[i] | or_mask;
+    u8 r = Truncate8(color & 31);
+    u8 g = Truncate8((color >> 5) & 31);
+    u8 b = Truncate8((color >> 10) & 31);
+    const u8 a = (color & 0x8000) ? 255 : 0;
+    r = (r << 3) | (r & 0b111);
+    g = (g << 3) | (g & 0b111);
+    b = (b << 3) | (b & 0b111);
+    dst[i] = ZeroExtend32(r) | (ZeroExtend32(g) << 8) | (ZeroExtend32(b) << 16) | (ZeroExtend32(a) << 24);
+  }
+}
+
+static void ConvertRGB888ToRGBA8888_Scalar(const u8* src, u32* dst, u32 count)
+{
+  // Don't read a whole word here, the last pixel in VRAM would go out of bounds.
+  for (u32 i = 0; i < count; i++)
+  {
+    dst[i] = ZeroExtend32(src[0]) | (ZeroExtend32(src[1]) << 8) | (ZeroExtend32(src[2]) << 16) | UINT32_C(0xFF000000);
+    src += 3;
+  }
+}
+
+#if defined(CPU_X64)
+
+// SSE2 is part of the x64 baseline, so no check is needed for it.
+static void ConvertRGBA5551ToRGBA8888_SSE2(const u16* src, u32* dst, u32 count, u16 or_mask)
+{
+  const __m128i mask5 = _mm_set1_epi16(0x1F);
+  const __m128i mask3 = _mm_set1_epi16(0x07);
+  const __m128i vor_mask = _mm_set1_epi16(static_cast<s16>(or_mask));
+
+  for (; count >= 8; count -= 8)
+  {
+    const __m128i color = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), vor_mask);
+    __m128i r = _mm_and_si128(color, mask5);
+    __m128i g = _mm_and_si128(_mm_srli_epi16(color, 5), mask5);
+    __m128i b = _mm_and_si128(_mm_srli_epi16(color, 10), mask5);
+    const __m128i a = _mm_srli_epi16(_mm_srai_epi16(color, 15), 8);
+    r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_and_si128(r, mask3));
+    g = _mm_or_si128(_mm_slli_epi16(g, 3), _mm_and_si128(g, mask3));
+    b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_and_si128(b, mask3));
+
+    const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    const __m128i ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), _mm_unpackhi_epi16(rg, ba));
+    src += 8;
+    dst += 8;
+  }
+
+  ConvertRGBA5551ToRGBA8888_Scalar(src, dst, count, or_mask);
+}
+
+TARGET_AVX2 static void ConvertRGBA5551ToRGBA8888_AVX2(const u16* src, u32* dst, u32 count, u16 or_mask)
+{
+  const __m256i mask5 = _mm256_set1_epi16(0x1F);
+  const __m256i mask3 = _mm256_set1_epi16(0x07);
+  const __m256i vor_mask = _mm256_set1_epi16(static_cast<s16>(or_mask));
+
+  for (; count >= 16; count -= 16)
+  {
+    const __m256i color = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)), vor_mask);
+    __m256i r = _mm256_and_si256(color, mask5);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi16(color, 5), mask5);
+    __m256i b = _mm256_and_si256(_mm256_srli_epi16(color, 10), mask5);
+    const __m256i a = _mm256_srli_epi16(_mm256_srai_epi16(color, 15), 8);
+    r = _mm256_or_si256(_mm256_slli_epi16(r, 3), _mm256_and_si256(r, mask3));
+    g = _mm256_or_si256(_mm256_slli_epi16(g, 3), _mm256_and_si256(g, mask3));
+    b = _mm256_or_si256(_mm256_slli_epi16(b, 3), _mm256_and_si256(b, mask3));
+
+    // unpack works on 128-bit lanes, so the halves have to be swizzled back into order.
+    const __m256i rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+    const __m256i ba = _mm256_or_si256(b, _mm256_slli_epi16(a, 8));
+    const __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+    const __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+    src += 16;
+    dst += 16;
+  }
+
+  ConvertRGBA5551ToRGBA8888_SSE2(src, dst, count, or_mask);
+}
+
+TARGET_SSSE3 static void ConvertRGB888ToRGBA8888_SSSE3(const u8* src, u32* dst, u32 count)
+{
+  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const __m128i alpha = _mm_set1_epi32(static_cast<s32>(UINT32_C(0xFF000000)));
+
+  // Each iteration consumes 12 bytes but loads 16, so stop early enough to not read past the end.
+  for (; count >= 6; count -= 4)
+  {
+    const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+    src += 12;
+    dst += 4;
+  }
+
+  ConvertRGB888ToRGBA8888_Scalar(src, dst, count);
+}
+
+static ConvertRGBA5551Function SelectConvertRGBA5551Function()
+{
+  return CPUDetect::HostSupportsAVX2() ? ConvertRGBA5551ToRGBA8888_AVX2 : ConvertRGBA5551ToRGBA8888_SSE2;
+}
+
+static ConvertRGB888Function SelectConvertRGB888Function()
+{
+  return CPUDetect::HostSupportsSSSE3() ? ConvertRGB888ToRGBA8888_SSSE3 : ConvertRGB888ToRGBA8888_Scalar;
+}
+
+#elif defined(CPU_AARCH64)
+
+static void ConvertRGBA5551ToRGBA8888_NEON(const u16* src, u32* dst, u32 count, u16 or_mask)
+{
+  const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+  const uint16x8_t mask3 = vdupq_n_u16(0x07);
+  const uint16x8_t vor_mask = vdupq_n_u16(or_mask);
+
+  for (; count >= 8; count -= 8)
+  {
+    const uint16x8_t color = vorrq_u16(vld1q_u16(src), vor_mask);
+    uint16x8_t r = vandq_u16(color, mask5);
+    uint16x8_t g = vandq_u16(vshrq_n_u16(color, 5), mask5);
+    uint16x8_t b = vandq_u16(vshrq_n_u16(color, 10), mask5);
+    const uint16x8_t a = vshrq_n_u16(vreinterpretq_u16_s16(vshrq_n_s16(vreinterpretq_s16_u16(color), 15)), 8);
+    r = vorrq_u16(vshlq_n_u16(r, 3), vandq_u16(r, mask3));
+    g = vorrq_u16(vshlq_n_u16(g, 3), vandq_u16(g, mask3));
+    b = vorrq_u16(vshlq_n_u16(b, 3), vandq_u16(b, mask3));
+
+    // Interleaving RG and BA halfwords gives us RGBA words.
+    uint16x8x2_t rgba;
+    rgba.val[0] = vorrq_u16(r, vshlq_n_u16(g, 8));
+    rgba.val[1] = vorrq_u16(b, vshlq_n_u16(a, 8));
+    vst2q_u16(reinterpret_cast<u16*>(dst), rgba);
+    src += 8;
+    dst += 8;
+  }
+
+  ConvertRGBA5551ToRGBA8888_Scalar(src, dst, count, or_mask);
+}
+
+static void ConvertRGB888ToRGBA8888_NEON(const u8* src, u32* dst, u32 count)
+{
+  for (; count >= 16; count -= 16)
+  {
+    const uint8x16x3_t rgb = vld3q_u8(src);
+    uint8x16x4_t rgba;
+    rgba.val[0] = rgb.val[0];
+    rgba.val[1] = rgb.val[1];
+    rgba.val[2] = rgb.val[2];
+    rgba.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(reinterpret_cast<u8*>(dst), rgba);
+    src += 48;
+    dst += 16;
+  }
+
+  ConvertRGB888ToRGBA8888_Scalar(src, dst, count);
+}
+
+static ConvertRGBA5551Function SelectConvertRGBA5551Function()
+{
+  return ConvertRGBA5551ToRGBA8888_NEON;
+}
+
+static ConvertRGB888Function SelectConvertRGB888Function()
+{
+  return ConvertRGB888ToRGBA8888_NEON;
+}
+
+#else
+
+static ConvertRGBA5551Function SelectConvertRGBA5551Function()
+{
+  return ConvertRGBA5551ToRGBA8888_Scalar;
+}
+
+static ConvertRGB888Function SelectConvertRGB888Function()
+{
+  return ConvertRGB888ToRGBA8888_Scalar;
+}
+
+#endif
+
+static const ConvertRGBA5551Function s_convert_rgba5551_function = SelectConvertRGBA5551Function();
+static const ConvertRGB888Function s_convert_rgb888_function = SelectConvertRGB888Function();
+
+void GPU::ConvertRGBA5551ToRGBA8888(const u16* src, u32* dst, u32 count, bool set_alpha /* = false */)
+{
+  s_convert_rgba5551_function(src, dst, count, set_alpha ? 0x8000 : 0x0000);
+}
+
+void GPU::ConvertRGB888ToRGBA8888(const u8* src, u32* dst, u32 count)
+{
+  s_convert_rgb888_function(src, dst, count);
+}
@@ -0,0 +1,305 @@
+#include "gpu_dump.h"
+#include "common/byte_stream.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/md5_digest.h"
+#include "common/state_wrapper.h"
+#include "gpu.h"
+Log_SetChannel(GPUDump);
+
+namespace GPUDump {
+
+Recorder::Recorder(std::unique_ptr<ByteStream> stream, std::string filename, u32 num_frames)
+  : m_stream(std::move(stream)), m_filename(std::move(filename)), m_frames_remaining(num_frames)
+{
+  m_gp0_buffer.reserve(MAX_GP0_PACKET_WORDS);
+}
+
+Recorder::~Recorder()
+{
+  FlushGP0();
+  FlushGPUREAD();
+
+  if (!m_stream->Flush() || m_stream->InErrorState())
+    Log_ErrorPrintf("Failed to write GPU dump '%s'", m_filename.c_str());
+  else
+    Log_InfoPrintf("Finished writing GPU dump '%s'", m_filename.c_str());
+}
+
+std::unique_ptr<Recorder> Recorder::Create(const char* filename, GPU* gpu, bool pal_mode, u32 num_frames)
+{
+  std::unique_ptr<ByteStream> stream =
+    FileSystem::OpenFile(filename, BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE |
+                                     BYTESTREAM_OPEN_CREATE_PATH | BYTESTREAM_OPEN_STREAMED);
+  if (!stream)
+  {
+    Log_ErrorPrintf("Failed to open GPU dump '%s' for writing", filename);
+    return {};
+  }
+
+  // The initial state includes VRAM, and any partial command which is sitting in the FIFO.
+  std::unique_ptr<GrowableMemoryByteStream> state_stream = ByteStream_CreateGrowableMemoryStream();
+  StateWrapper sw(state_stream.get(), StateWrapper::Mode::Write);
+  if (!gpu->DoState(sw))
+  {
+    Log_ErrorPrintf("Failed to save GPU state for dump");
+    return {};
+  }
+
+  FileHeader header = {};
+  header.magic = FILE_MAGIC;
+  header.version = FILE_VERSION;
+  header.pal_mode = BoolToUInt32(pal_mode);
+  header.state_size = static_cast<u32>(state_stream->GetSize());
+  if (!stream->Write2(&header, sizeof(header)) ||
+      !stream->Write2(state_stream->GetMemoryPointer(), header.state_size))
+  {
+    Log_ErrorPrintf("Failed to write GPU dump header to '%s'", filename);
+    return {};
+  }
+
+  Log_InfoPrintf("Writing %u frames of GPU commands to '%s'", num_frames, filename);
+  return std::unique_ptr<Recorder>(new Recorder(std::move(stream), filename, num_frames));
+}
+
+void Recorder::WriteGP0(const u32* words, u32 word_count)
+{
+  FlushGPUREAD();
+
+  while (word_count > 0)
+  {
+    const u32 words_in_packet =
+      std::min<u32>(word_count, MAX_GP0_PACKET_WORDS - static_cast<u32>(m_gp0_buffer.size()));
+    m_gp0_buffer.insert(m_gp0_buffer.end(), words, words + words_in_packet);
+    if (m_gp0_buffer.size() >= MAX_GP0_PACKET_WORDS)
+      FlushGP0();
+
+    words += words_in_packet;
+    word_count -= words_in_packet;
+  }
+}
+
+void Recorder::WriteGP1(u32 value)
+{
+  FlushGP0();
+  FlushGPUREAD();
+  WritePacket(PacketType::GP1Write, &value, 1);
+}
+
+void Recorder::ReadGPUREAD(u32 word_count)
+{
+  FlushGP0();
+
+  // The length field is only 24 bits, so split huge reads up.
+  m_pending_gpuread_count += word_count;
+  if (m_pending_gpuread_count >= MAX_GPUREAD_PACKET_COUNT)
+    FlushGPUREAD();
+}
+
+bool Recorder::EndFrame()
+{
+  FlushGP0();
+  FlushGPUREAD();
+  WritePacket(PacketType::VSync, nullptr, 0);
+
+  m_frames_remaining--;
+  return (m_frames_remaining > 0);
+}
+
+void Recorder::FlushGP0()
+{
+  if (m_gp0_buffer.empty())
+    return;
+
+  WritePacket(PacketType::GP0Data, m_gp0_buffer.data(), static_cast<u32>(m_gp0_buffer.size()));
+  m_gp0_buffer.clear();
+}
+
+void Recorder::FlushGPUREAD()
+{
+  while (m_pending_gpuread_count > 0)
+  {
+    const u32 count = std::min<u32>(m_pending_gpuread_count, MAX_GPUREAD_PACKET_COUNT);
+    WritePacket(PacketType::GPUREADRead, nullptr, count);
+    m_pending_gpuread_count -= count;
+  }
+}
+
+void Recorder::WritePacket(PacketType type, const u32* data, u32 length)
+{
+  const u32 header = MakePacketHeader(type, length);
+  m_stream->Write2(&header, sizeof(header));
+  if (type != PacketType::GPUREADRead && length > 0)
+    m_stream->Write2(data, sizeof(u32) * length);
+}
+
+Player::~Player() = default;
+
+std::unique_ptr<Player> Player::Open(const char* filename)
+{
+  std::unique_ptr<ByteStream> stream = FileSystem::OpenFile(filename, BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
+  if (!stream)
+  {
+    Log_ErrorPrintf("Failed to open GPU dump '%s'", filename);
+    return {};
+  }
+
+  FileHeader header;
+  if (!stream->Read2(&header, sizeof(header)) || header.magic != FILE_MAGIC || header.version != FILE_VERSION)
+  {
+    Log_ErrorPrintf("'%s' is not a GPU dump, or is from an incompatible version", filename);
+    return {};
+  }
+
+  const u64 packets_size = stream->GetSize() - sizeof(header) - header.state_size;
+  if (stream->GetSize() < (sizeof(header) + header.state_size) || (packets_size % sizeof(u32)) != 0)
+  {
+    Log_ErrorPrintf("GPU dump '%s' is truncated", filename);
+    return {};
+  }
+
+  std::unique_ptr<Player> player(new Player());
+  player->m_pal_mode = (header.pal_mode != 0);
+  player->m_state.resize(header.state_size);
+  player->m_packets.resize(static_cast<size_t>(packets_size / sizeof(u32)));
+  if (!stream->Read2(player->m_state.data(), header.state_size) ||
+      !stream->Read2(player->m_packets.data(), static_cast<u32>(packets_size)))
+  {
+    Log_ErrorPrintf("Failed to read GPU dump '%s'", filename);
+    return {};
+  }
+
+  // Validate the packets up front, so that playback doesn't have to.
+  const u32 num_packet_words = static_cast<u32>(player->m_packets.size());
+  for (u32 pos = 0; pos < num_packet_words;)
+  {
+    const u32 header_word = player->m_packets[pos++];
+    const PacketType type = GetPacketType(header_word);
+    const u32 length = GetPacketLength(header_word);
+    switch (type)
+    {
+      case PacketType::GP0Data:
+      case PacketType::GP1Write:
+        pos += length;
+        break;
+
+      case PacketType::GPUREADRead:
+        break;
+
+      case PacketType::VSync:
+        player->m_num_frames++;
+        break;
+
+      default:
+        pos = num_packet_words + 1;
+        break;
+    }
+
+    if (pos > num_packet_words || (type == PacketType::GP1Write && length != 1))
+    {
+      Log_ErrorPrintf("GPU dump '%s' is corrupted at word %u", filename, pos);
+      return {};
+    }
+  }
+
+  Log_InfoPrintf("Loaded GPU dump '%s': %u frames, %u command words", filename, player->m_num_frames,
+                 num_packet_words);
+  return player;
+}
+
+bool Player::LoadInitialState(GPU* gpu) const
+{
+  std::unique_ptr<ReadOnlyMemoryByteStream> stream =
+    ByteStream_CreateReadOnlyMemoryStream(m_state.data(), static_cast<u32>(m_state.size()));
+  StateWrapper sw(stream.get(), StateWrapper::Mode::Read);
+  return gpu->DoState(sw);
+}
+
+void Player::Execute(GPU* gpu, Statistics* stats) const
+{
+  *stats = {};
+
+  // Stats are reset every frame, so the 32-bit counters in the GPU can't overflow.
+  const auto AccumulateStats = [gpu, stats]() {
+    const GPU::Stats& gs = gpu->m_stats;
+    stats->num_primitives += gs.num_polygons;
+    stats->num_vertices += gs.num_vertices;
+    stats->num_pixels += gs.num_pixels;
+    stats->num_vram_fills += gs.num_vram_fills;
+    stats->num_vram_writes += gs.num_vram_writes;
+    stats->num_vram_copies += gs.num_vram_copies;
+    stats->num_vram_reads += gs.num_vram_reads;
+    gpu->m_stats = {};
+  };
+
+  gpu->m_stats = {};
+
+  const u32* packet_ptr = m_packets.data();
+  const u32* const packet_end = packet_ptr + m_packets.size();
+  while (packet_ptr != packet_end)
+  {
+    const u32 header = *(packet_ptr++);
+    const u32 length = GetPacketLength(header);
+    switch (GetPacketType(header))
+    {
+      case PacketType::GP0Data:
+      {
+        gpu->m_GP0_buffer.PushRange(packet_ptr, length);
+        gpu->ExecuteCommands();
+        packet_ptr += length;
+      }
+      break;
+
+      case PacketType::GP1Write:
+      {
+        gpu->WriteGP1(*packet_ptr);
+        packet_ptr += length;
+      }
+      break;
+
+      case PacketType::GPUREADRead:
+      {
+        for (u32 i = 0; i < length; i++)
+          gpu->ReadGPUREAD();
+      }
+      break;
+
+      case PacketType::VSync:
+      {
+        gpu->FlushRender();
+        gpu->UpdateDisplay();
+        AccumulateStats();
+        stats->num_frames++;
+      }
+      break;
+    }
+  }
+
+  gpu->FlushRender();
+  AccumulateStats();
+}
+
+std::string Player::GetVRAMHash(GPU* gpu)
+{
+  gpu->FlushRender();
+  gpu->ReadVRAM(0, 0, GPU::VRAM_WIDTH, GPU::VRAM_HEIGHT);
+
+  MD5Digest digest;
+  digest.Update(gpu->m_vram_ptr, GPU::VRAM_SIZE);
+
+  u8 hash[16];
+  digest.Final(hash);
+
+  static constexpr char hex_digits[] = "0123456789abcdef";
+  std::string hash_str;
+  hash_str.reserve(sizeof(hash) * 2);
+  for (u32 i = 0; i < sizeof(hash); i++)
+  {
+    hash_str.push_back(hex_digits[hash[i] >> 4]);
+    hash_str.push_back(hex_digits[hash[i] & 0xF]);
+  }
+
+  return hash_str;
+}
+
+} // namespace GPUDump
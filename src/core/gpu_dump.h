@@ -0,0 +1,140 @@
+#pragma once
+#include "types.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class ByteStream;
+
+class GPU;
+
+// Command stream dumps capture the GPU state at the start of the dump, followed by every GP0/GP1 write and GPUREAD
+// read for a number of frames. They can be replayed into any GPU backend without the rest of the system.
+namespace GPUDump {
+
+enum : u32
+{
+  FILE_MAGIC = 0x50475344, // DSGP
+  FILE_VERSION = 1,
+
+  // Runs of GP0 writes are coalesced into a single packet up to this many words.
+  MAX_GP0_PACKET_WORDS = 65536,
+
+  // Limit of the 24-bit length field.
+  MAX_GPUREAD_PACKET_COUNT = 0xFFFFFF
+};
+
+enum class PacketType : u8
+{
+  GP0Data = 0,     // length = number of words following
+  GP1Write = 1,    // length = 1, value following
+  GPUREADRead = 2, // length = number of reads, no data
+  VSync = 3        // length = 0
+};
+
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 pal_mode;
+  u32 state_size;
+};
+
+static_assert(sizeof(FileHeader) == 16, "GPU dump header has no padding");
+
+// Packets are a single header word, followed by the data words.
+static constexpr u32 MakePacketHeader(PacketType type, u32 length)
+{
+  return (static_cast<u32>(type) << 24) | (length & UINT32_C(0x00FFFFFF));
+}
+static constexpr PacketType GetPacketType(u32 header)
+{
+  return static_cast<PacketType>(header >> 24);
+}
+static constexpr u32 GetPacketLength(u32 header)
+{
+  return header & UINT32_C(0x00FFFFFF);
+}
+
+class Recorder
+{
+public:
+  ~Recorder();
+
+  /// Creates a new dump file, and writes the current state of the GPU to it.
+  static std::unique_ptr<Recorder> Create(const char* filename, GPU* gpu, bool pal_mode, u32 num_frames);
+
+  const std::string& GetFileName() const { return m_filename; }
+
+  void WriteGP0(u32 value)
+  {
+    if (m_pending_gpuread_count > 0)
+      FlushGPUREAD();
+
+    m_gp0_buffer.push_back(value);
+    if (m_gp0_buffer.size() >= MAX_GP0_PACKET_WORDS)
+      FlushGP0();
+  }
+  void WriteGP0(const u32* words, u32 word_count);
+  void WriteGP1(u32 value);
+  void ReadGPUREAD(u32 word_count);
+
+  /// Marks the end of a frame. Returns false once the requested number of frames has been recorded.
+  bool EndFrame();
+
+private:
+  Recorder(std::unique_ptr<ByteStream> stream, std::string filename, u32 num_frames);
+
+  void FlushGP0();
+  void FlushGPUREAD();
+  void WritePacket(PacketType type, const u32* data, u32 length);
+
+  std::unique_ptr<ByteStream> m_stream;
+  std::string m_filename;
+  std::vector<u32> m_gp0_buffer;
+  u32 m_frames_remaining;
+  u32 m_pending_gpuread_count = 0;
+};
+
+class Player
+{
+public:
+  struct Statistics
+  {
+    u32 num_frames;
+    u64 num_primitives;
+    u64 num_vertices;
+    u64 num_pixels;
+    u64 num_vram_fills;
+    u64 num_vram_writes;
+    u64 num_vram_copies;
+    u64 num_vram_reads;
+  };
+
+  ~Player();
+
+  /// Loads a dump file into memory.
+  static std::unique_ptr<Player> Open(const char* filename);
+
+  bool IsPALMode() const { return m_pal_mode; }
+  u32 GetFrameCount() const { return m_num_frames; }
+
+  /// Restores the GPU to the state at the beginning of the dump.
+  bool LoadInitialState(GPU* gpu) const;
+
+  /// Feeds the whole command stream to the GPU, updating the display at the end of each frame.
+  void Execute(GPU* gpu, Statistics* stats) const;
+
+  /// Returns the MD5 hash of VRAM, as a hex string.
+  static std::string GetVRAMHash(GPU* gpu);
+
+private:
+  Player() = default;
+
+  std::vector<u8> m_state;
+  std::vector<u32> m_packets;
+  u32 m_num_frames = 0;
+  bool m_pal_mode = false;
+};
+
+} // namespace GPUDump
@@ -8,6 +8,10 @@
 #include <sstream>
 Log_SetChannel(GPU_HW);
 
+static_assert(static_cast<u32>(VRAMTileMap::VRAM_WIDTH) == static_cast<u32>(GPU::VRAM_WIDTH) &&
+                static_cast<u32>(VRAMTileMap::VRAM_HEIGHT) == static_cast<u32>(GPU::VRAM_HEIGHT),
+              "tile map covers VRAM");
+
 GPU_HW::GPU_HW() : GPU()
 {
   m_vram_ptr = m_vram_shadow.data();
@@ -43,7 +47,7 @@ void GPU_HW::Reset()
   m_batch_ubo_data = {};
   m_batch_ubo_dirty = true;
 
-  SetFullVRAMDirtyRectangle();
+  SetFullVRAMDirty();
 }
 
 bool GPU_HW::DoState(StateWrapper& sw)
@@ -53,7 +57,7 @@ bool GPU_HW::DoState(StateWrapper& sw)
 
   // invalidate the whole VRAM read texture when loading state
   if (sw.IsReading())
-    SetFullVRAMDirtyRectangle();
+    SetFullVRAMDirty();
 
   return true;
 }
@@ -229,22 +233,6 @@ void GPU_HW::CalcScissorRect(int* left, int* top, int* right, int* bottom)
   *bottom = std::max<u32>((m_drawing_area.bottom + 1) * m_resolution_scale, *top + 1);
 }
 
-Common::Rectangle<u32> GPU_HW::GetVRAMTransferBounds(u32 x, u32 y, u32 width, u32 height)
-{
-  Common::Rectangle<u32> out_rc = Common::Rectangle<u32>::FromExtents(x, y, width, height);
-  if (out_rc.right > VRAM_WIDTH)
-  {
-    out_rc.left = 0;
-    out_rc.right = VRAM_WIDTH;
-  }
-  if (out_rc.bottom > VRAM_HEIGHT)
-  {
-    out_rc.top = 0;
-    out_rc.bottom = VRAM_HEIGHT;
-  }
-  return out_rc;
-}
-
 GPU_HW::BatchPrimitive GPU_HW::GetPrimitiveForCommand(RenderCommand rc)
 {
   if (rc.primitive == Primitive::Line)
@@ -257,18 +245,50 @@ GPU_HW::BatchPrimitive GPU_HW::GetPrimitiveForCommand(RenderCommand rc)
 
 void GPU_HW::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
 {
-  m_vram_dirty_rect.Include(Common::Rectangle<u32>::FromExtents(x, y, width, height).Clamped(0, 0, VRAM_WIDTH, VRAM_HEIGHT));
+  SetVRAMDirty(Common::Rectangle<u32>::FromExtents(x, y, width, height));
 }
 
 void GPU_HW::UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data)
 {
   DebugAssert((x + width) <= VRAM_WIDTH && (y + height) <= VRAM_HEIGHT);
-  m_vram_dirty_rect.Include(Common::Rectangle<u32>::FromExtents(x, y, width, height));
+
+  // The shadow copy is updated here instead of reading the area back later. When called from the oversized paths,
+  // the data is already in the shadow copy.
+  if (data != m_vram_shadow.data())
+  {
+    const u16* src_ptr = static_cast<const u16*>(data);
+    u16* dst_ptr = &m_vram_shadow[y * VRAM_WIDTH + x];
+    for (u32 row = 0; row < height; row++)
+    {
+      std::memcpy(dst_ptr, src_ptr, width * sizeof(u16));
+      src_ptr += width;
+      dst_ptr += VRAM_WIDTH;
+    }
+  }
+
+  m_vram_read_texture_dirty_tiles.Set(Common::Rectangle<u32>::FromExtents(x, y, width, height));
 }
 
 void GPU_HW::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height)
 {
-  m_vram_dirty_rect.Include(Common::Rectangle<u32>::FromExtents(dst_x, dst_y, width, height).Clamped(0, 0, VRAM_WIDTH, VRAM_HEIGHT));
+  SetVRAMDirty(Common::Rectangle<u32>::FromExtents(dst_x, dst_y, width, height));
+}
+
+void GPU_HW::UpdateVRAMReadTexture()
+{
+  const auto CopyArea = [this](const Common::Rectangle<u32>& rc) {
+    const auto CopyTiles = [this](const Common::Rectangle<u32>& tile_rc) { CopyVRAMToReadTexture(tile_rc); };
+    m_vram_read_texture_dirty_tiles.Consume(rc, CopyTiles);
+
+    // pages and palettes wrap around at the right edge of VRAM
+    if (rc.right > VRAM_WIDTH)
+      m_vram_read_texture_dirty_tiles.Consume(Common::Rectangle<u32>(0, rc.top, rc.right - VRAM_WIDTH, rc.bottom),
+                                              CopyTiles);
+  };
+
+  CopyArea(m_draw_mode.GetTexturePageRectangle());
+  CopyArea(m_draw_mode.GetTexturePaletteRectangle());
+  m_renderer_stats.num_vram_read_texture_updates++;
 }
 
 void GPU_HW::DispatchRenderCommand(RenderCommand rc, u32 num_vertices, const u32* command_ptr)
@@ -280,8 +300,8 @@ void GPU_HW::DispatchRenderCommand(RenderCommand rc, u32 num_vertices, const u32
     if (m_draw_mode.IsTexturePageChanged())
     {
       m_draw_mode.ClearTexturePageChangedFlag();
-      if (m_vram_dirty_rect.Valid() && (m_draw_mode.GetTexturePageRectangle().Intersects(m_vram_dirty_rect) ||
-                                        m_draw_mode.GetTexturePaletteRectangle().Intersects(m_vram_dirty_rect)))
+      if (IsVRAMReadTextureDirty(m_draw_mode.GetTexturePageRectangle()) ||
+          IsVRAMReadTextureDirty(m_draw_mode.GetTexturePaletteRectangle()))
       {
         Log_DevPrintf("Invalidating VRAM read cache due to drawing area overlap");
         if (!IsFlushed())
@@ -396,6 +416,11 @@ void GPU_HW::DrawRendererStats(bool is_idle_frame)
     ImGui::Text("%u", stats.num_vram_read_texture_updates);
     ImGui::NextColumn();
 
+    ImGui::TextUnformatted("VRAM Readbacks:");
+    ImGui::NextColumn();
+    ImGui::Text("%u", stats.num_vram_readbacks);
+    ImGui::NextColumn();
+
     ImGui::TextUnformatted("Uniform Buffer Updates: ");
     ImGui::NextColumn();
     ImGui::Text("%u", stats.num_uniform_buffer_updates);
@@ -1,6 +1,8 @@
 #pragma once
 #include "common/heap_array.h"
 #include "gpu.h"
+#include "vram_tile_map.h"
+#include <array>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -108,6 +110,7 @@ protected:
   {
     u32 num_batches;
     u32 num_vram_read_texture_updates;
+    u32 num_vram_readbacks;
     u32 num_uniform_buffer_updates;
   };
 
@@ -120,14 +123,42 @@ protected:
   }
 
   virtual void MapBatchVertexPointer(u32 required_vertices) = 0;
-  virtual void UpdateVRAMReadTexture() = 0;
 
-  void SetFullVRAMDirtyRectangle()
+  /// Copies an area of the VRAM texture to the VRAM read texture. Coordinates are unscaled.
+  virtual void CopyVRAMToReadTexture(const Common::Rectangle<u32>& rc) = 0;
+
+  /// Returns true if an area which is about to be sampled from has been modified since it was copied to the read
+  /// texture. Handles wrap-around of X.
+  bool IsVRAMReadTextureDirty(const Common::Rectangle<u32>& rc) const
+  {
+    return m_vram_read_texture_dirty_tiles.Intersects(rc) ||
+           (rc.right > VRAM_WIDTH &&
+            m_vram_read_texture_dirty_tiles.Intersects(
+              Common::Rectangle<u32>(0, rc.top, rc.right - VRAM_WIDTH, rc.bottom)));
+  }
+
+  /// Brings the parts of the VRAM read texture which the current texture page and palette use up to date.
+  void UpdateVRAMReadTexture();
+
+  /// Marks an area of VRAM as modified by the GPU. Both the read texture and the shadow copy are out of date.
+  void SetVRAMDirty(const Common::Rectangle<u32>& rc)
   {
-    m_vram_dirty_rect.Set(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+    m_vram_read_texture_dirty_tiles.Set(rc);
+    m_vram_shadow_dirty_tiles.Set(rc);
+  }
+  void SetFullVRAMDirty()
+  {
+    m_vram_read_texture_dirty_tiles.SetAll();
+    m_vram_shadow_dirty_tiles.SetAll();
     m_draw_mode.SetTexturePageChanged();
   }
-  void ClearVRAMDirtyRectangle() { m_vram_dirty_rect.SetInvalid(); }
+
+  /// Marks the drawing area as modified, called whenever a batch is drawn.
+  void SetDrawingAreaDirty()
+  {
+    SetVRAMDirty(Common::Rectangle<u32>(m_drawing_area.left, m_drawing_area.top, m_drawing_area.right + 1,
+                                        m_drawing_area.bottom + 1));
+  }
 
   u32 GetBatchVertexSpace() const { return static_cast<u32>(m_batch_end_vertex_ptr - m_batch_current_vertex_ptr); }
   u32 GetBatchVertexCount() const { return static_cast<u32>(m_batch_current_vertex_ptr - m_batch_start_vertex_ptr); }
@@ -147,9 +178,6 @@ protected:
     return std::make_tuple(x * s32(m_resolution_scale), y * s32(m_resolution_scale));
   }
 
-  /// Computes the area affected by a VRAM transfer, including wrap-around of X.
-  Common::Rectangle<u32> GetVRAMTransferBounds(u32 x, u32 y, u32 width, u32 height);
-
   HeapArray<u16, VRAM_WIDTH * VRAM_HEIGHT> m_vram_shadow;
 
   BatchVertex* m_batch_start_vertex_ptr = nullptr;
@@ -167,8 +195,10 @@ protected:
   BatchConfig m_batch = {};
   BatchUBOData m_batch_ubo_data = {};
 
-  // Bounding box of VRAM area that the GPU has drawn into.
-  Common::Rectangle<u32> m_vram_dirty_rect;
+  // Areas of VRAM that the GPU has modified since they were last copied to the read texture, and read back to the
+  // shadow copy respectively. CPU-side uploads keep the shadow copy current, so they only dirty the read texture.
+  VRAMTileMap m_vram_read_texture_dirty_tiles;
+  VRAMTileMap m_vram_shadow_dirty_tiles;
 
   // Statistics
   RendererStats m_renderer_stats = {};
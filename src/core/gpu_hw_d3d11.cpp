@@ -185,7 +185,7 @@ bool GPU_HW_D3D11::CreateFramebuffer()
   }
 
   m_context->OMSetRenderTargets(1, m_vram_texture.GetD3DRTVArray(), nullptr);
-  SetFullVRAMDirtyRectangle();
+  SetFullVRAMDirty();
   return true;
 }
 
@@ -193,7 +193,7 @@ void GPU_HW_D3D11::ClearFramebuffer()
 {
   static constexpr std::array<float, 4> color = {};
   m_context->ClearRenderTargetView(m_vram_texture.GetD3DRTV(), color.data());
-  SetFullVRAMDirtyRectangle();
+  SetFullVRAMDirty();
 }
 
 void GPU_HW_D3D11::DestroyFramebuffer()
@@ -493,10 +493,11 @@ void GPU_HW_D3D11::SetDrawState(BatchRenderMode render_mode)
   if (m_drawing_area_changed)
   {
     m_drawing_area_changed = false;
-    m_vram_dirty_rect.Include(m_drawing_area);
     SetScissorFromDrawingArea();
   }
 
+  SetDrawingAreaDirty();
+
   if (m_batch_ubo_dirty)
   {
     UploadUniformBlock(&m_batch_ubo_data, sizeof(m_batch_ubo_data));
@@ -593,34 +594,47 @@ void GPU_HW_D3D11::UpdateDisplay()
 
 void GPU_HW_D3D11::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
-  // Get bounds with wrap-around handled.
-  const Common::Rectangle<u32> copy_rect = GetVRAMTransferBounds(x, y, width, height);
-  const u32 encoded_width = (copy_rect.GetWidth() + 1) / 2;
-  const u32 encoded_height = copy_rect.GetHeight();
-
-  // Encode the 24-bit texture as 16-bit.
-  const u32 uniforms[4] = {copy_rect.left, copy_rect.top, copy_rect.GetWidth(), copy_rect.GetHeight()};
-  m_context->OMSetRenderTargets(1, m_vram_encoding_texture.GetD3DRTVArray(), nullptr);
-  m_context->PSSetShaderResources(0, 1, m_vram_texture.GetD3DSRVArray());
-  SetViewportAndScissor(0, 0, encoded_width, encoded_height);
-  DrawUtilityShader(m_vram_read_pixel_shader.Get(), uniforms, sizeof(uniforms));
-
-  // Stage the readback.
-  m_vram_readback_texture.CopyFromTexture(m_context.Get(), m_vram_encoding_texture.GetD3DTexture(), 0, 0, 0, 0, 0,
-                                          encoded_width, encoded_height);
-  // And copy it into our shadow buffer.
-  if (m_vram_readback_texture.Map(m_context.Get(), false))
-  {
-    m_vram_readback_texture.ReadPixels(0, 0, encoded_width * 2, encoded_height, VRAM_WIDTH,
-                                       &m_vram_shadow[copy_rect.top * VRAM_WIDTH + copy_rect.left]);
-    m_vram_readback_texture.Unmap(m_context.Get());
-  }
-  else
-  {
-    Log_ErrorPrintf("Failed to map VRAM readback texture");
-  }
+  // Get bounds with wrap-around handled. Only the tiles which have been modified since they were last read back are
+  // copied, the rest of the shadow copy is already current.
+  const Common::Rectangle<u32> bounds = VRAMTileMap::GetTransferBounds(x, y, width, height);
+  bool state_changed = false;
+  m_vram_shadow_dirty_tiles.Consume(bounds, [this, &state_changed](const Common::Rectangle<u32>& copy_rect) {
+    if (!state_changed)
+    {
+      m_context->OMSetRenderTargets(1, m_vram_encoding_texture.GetD3DRTVArray(), nullptr);
+      m_context->PSSetShaderResources(0, 1, m_vram_texture.GetD3DSRVArray());
+      state_changed = true;
+    }
 
-  RestoreGraphicsAPIState();
+    const u32 encoded_width = (copy_rect.GetWidth() + 1) / 2;
+    const u32 encoded_height = copy_rect.GetHeight();
+
+    // Encode the 24-bit texture as 16-bit.
+    const u32 uniforms[4] = {copy_rect.left, copy_rect.top, copy_rect.GetWidth(), copy_rect.GetHeight()};
+    SetViewportAndScissor(0, 0, encoded_width, encoded_height);
+    DrawUtilityShader(m_vram_read_pixel_shader.Get(), uniforms, sizeof(uniforms));
+
+    // Stage the readback.
+    m_vram_readback_texture.CopyFromTexture(m_context.Get(), m_vram_encoding_texture.GetD3DTexture(), 0, 0, 0, 0, 0,
+                                            encoded_width, encoded_height);
+    // And copy it into our shadow buffer.
+    if (m_vram_readback_texture.Map(m_context.Get(), false))
+    {
+      m_vram_readback_texture.ReadPixels(0, 0, encoded_width * 2, encoded_height, VRAM_WIDTH,
+                                         &m_vram_shadow[copy_rect.top * VRAM_WIDTH + copy_rect.left]);
+      m_vram_readback_texture.Unmap(m_context.Get());
+      m_renderer_stats.num_vram_readbacks++;
+    }
+    else
+    {
+      // Try again next time.
+      Log_ErrorPrintf("Failed to map VRAM readback texture");
+      m_vram_shadow_dirty_tiles.Set(copy_rect);
+    }
+  });
+
+  if (state_changed)
+    RestoreGraphicsAPIState();
 }
 
 void GPU_HW_D3D11::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
@@ -707,15 +721,12 @@ void GPU_HW_D3D11::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 widt
   m_context->CopySubresourceRegion(m_vram_texture, 0, dst_x, dst_y, 0, m_vram_texture, 0, &src_box);
 }
 
-void GPU_HW_D3D11::UpdateVRAMReadTexture()
+void GPU_HW_D3D11::CopyVRAMToReadTexture(const Common::Rectangle<u32>& rc)
 {
-  const auto scaled_rect = m_vram_dirty_rect * m_resolution_scale;
+  const auto scaled_rect = rc * m_resolution_scale;
   const CD3D11_BOX src_box(scaled_rect.left, scaled_rect.top, 0, scaled_rect.right, scaled_rect.bottom, 1);
   m_context->CopySubresourceRegion(m_vram_read_texture, 0, scaled_rect.left, scaled_rect.top, 0, m_vram_texture, 0,
                                    &src_box);
-
-  m_renderer_stats.num_vram_read_texture_updates++;
-  ClearVRAMDirtyRectangle();
 }
 
 void GPU_HW_D3D11::FlushRender()
@@ -176,7 +176,7 @@ bool GPU_HW_OpenGL_ES::CreateFramebuffer()
   }
 
   m_vram_texture.BindFramebuffer(GL_DRAW_FRAMEBUFFER);
-  SetFullVRAMDirtyRectangle();
+  SetFullVRAMDirty();
   return true;
 }
 
@@ -186,7 +186,7 @@ void GPU_HW_OpenGL_ES::ClearFramebuffer()
   glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
   glClear(GL_COLOR_BUFFER_BIT);
   glEnable(GL_SCISSOR_TEST);
-  SetFullVRAMDirtyRectangle();
+  SetFullVRAMDirty();
 }
 
 bool GPU_HW_OpenGL_ES::CompilePrograms()
@@ -310,10 +310,11 @@ void GPU_HW_OpenGL_ES::SetDrawState(BatchRenderMode render_mode)
   if (m_drawing_area_changed)
   {
     m_drawing_area_changed = false;
-    m_vram_dirty_rect.Include(m_drawing_area);
     SetScissorFromDrawingArea();
   }
 
+  SetDrawingAreaDirty();
+
   if (m_batch_ubo_dirty)
   {
     prog.Uniform2iv(0, m_batch_ubo_data.u_pos_offset);
@@ -446,31 +447,45 @@ void GPU_HW_OpenGL_ES::UpdateDisplay()
 
 void GPU_HW_OpenGL_ES::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
-  // Get bounds with wrap-around handled.
-  const Common::Rectangle<u32> copy_rect = GetVRAMTransferBounds(x, y, width, height);
-  const u32 encoded_width = (copy_rect.GetWidth() + 1) / 2;
-  const u32 encoded_height = copy_rect.GetHeight();
-
-  // Encode the 24-bit texture as 16-bit.
-  m_vram_encoding_texture.BindFramebuffer(GL_DRAW_FRAMEBUFFER);
-  m_vram_texture.Bind();
-  m_vram_read_program.Bind();
-  m_vram_read_program.Uniform2i(0, copy_rect.left, VRAM_HEIGHT - copy_rect.top - copy_rect.GetHeight());
-  m_vram_read_program.Uniform2i(1, copy_rect.GetWidth(), copy_rect.GetHeight());
-  glDisable(GL_BLEND);
-  glDisable(GL_SCISSOR_TEST);
-  glViewport(0, 0, encoded_width, encoded_height);
-  glDrawArrays(GL_TRIANGLES, 0, 3);
-
-  // Readback encoded texture.
-  m_vram_encoding_texture.BindFramebuffer(GL_READ_FRAMEBUFFER);
-  glPixelStorei(GL_PACK_ALIGNMENT, 2);
-  glPixelStorei(GL_PACK_ROW_LENGTH, VRAM_WIDTH / 2);
-  glReadPixels(0, 0, encoded_width, encoded_height, GL_RGBA, GL_UNSIGNED_BYTE,
-               &m_vram_shadow[copy_rect.top * VRAM_WIDTH + copy_rect.left]);
-  glPixelStorei(GL_PACK_ALIGNMENT, 4);
-  glPixelStorei(GL_PACK_ROW_LENGTH, 0);
-  RestoreGraphicsAPIState();
+  // Get bounds with wrap-around handled. Only the tiles which have been modified since they were last read back are
+  // copied, the rest of the shadow copy is already current.
+  const Common::Rectangle<u32> bounds = VRAMTileMap::GetTransferBounds(x, y, width, height);
+  bool state_changed = false;
+  m_vram_shadow_dirty_tiles.Consume(bounds, [this, &state_changed](const Common::Rectangle<u32>& copy_rect) {
+    if (!state_changed)
+    {
+      m_vram_texture.Bind();
+      m_vram_read_program.Bind();
+      glDisable(GL_BLEND);
+      glDisable(GL_SCISSOR_TEST);
+      glPixelStorei(GL_PACK_ALIGNMENT, 2);
+      glPixelStorei(GL_PACK_ROW_LENGTH, VRAM_WIDTH / 2);
+      state_changed = true;
+    }
+
+    const u32 encoded_width = (copy_rect.GetWidth() + 1) / 2;
+    const u32 encoded_height = copy_rect.GetHeight();
+
+    // Encode the 24-bit texture as 16-bit.
+    m_vram_encoding_texture.BindFramebuffer(GL_DRAW_FRAMEBUFFER);
+    m_vram_read_program.Uniform2i(0, copy_rect.left, VRAM_HEIGHT - copy_rect.top - copy_rect.GetHeight());
+    m_vram_read_program.Uniform2i(1, copy_rect.GetWidth(), copy_rect.GetHeight());
+    glViewport(0, 0, encoded_width, encoded_height);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    // Readback encoded texture.
+    m_vram_encoding_texture.BindFramebuffer(GL_READ_FRAMEBUFFER);
+    glReadPixels(0, 0, encoded_width, encoded_height, GL_RGBA, GL_UNSIGNED_BYTE,
+                 &m_vram_shadow[copy_rect.top * VRAM_WIDTH + copy_rect.left]);
+    m_renderer_stats.num_vram_readbacks++;
+  });
+
+  if (state_changed)
+  {
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    RestoreGraphicsAPIState();
+  }
 }
 
 void GPU_HW_OpenGL_ES::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
@@ -612,9 +627,9 @@ void GPU_HW_OpenGL_ES::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32
   }
 }
 
-void GPU_HW_OpenGL_ES::UpdateVRAMReadTexture()
+void GPU_HW_OpenGL_ES::CopyVRAMToReadTexture(const Common::Rectangle<u32>& rc)
 {
-  const auto scaled_rect = m_vram_dirty_rect * m_resolution_scale;
+  const auto scaled_rect = rc * m_resolution_scale;
   const u32 width = scaled_rect.GetWidth();
   const u32 height = scaled_rect.GetHeight();
   const u32 x = scaled_rect.left;
@@ -634,9 +649,6 @@ void GPU_HW_OpenGL_ES::UpdateVRAMReadTexture()
     glEnable(GL_SCISSOR_TEST);
     m_vram_texture.BindFramebuffer(GL_FRAMEBUFFER);
   }
-
-  m_renderer_stats.num_vram_read_texture_updates++;
-  ClearVRAMDirtyRectangle();
 }
 
 void GPU_HW_OpenGL_ES::FlushRender()
@@ -29,7 +29,7 @@ protected:
   void CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 width, u32 height) override;
   void FlushRender() override;
   void MapBatchVertexPointer(u32 required_vertices) override;
-  void UpdateVRAMReadTexture() override;
+  void CopyVRAMToReadTexture(const Common::Rectangle<u32>& rc) override;
 
 private:
   struct GLStats
@@ -7,6 +7,7 @@
 GPU_SW::GPU_SW()
 {
   m_vram.fill(0);
+  m_display_texture_buffer.fill(0);
   m_vram_ptr = m_vram.data();
 }
 
@@ -77,11 +78,7 @@ void GPU_SW::CopyOut15Bit(const u16* src_ptr, u32 src_stride, u32* dst_ptr, u32
 {
   for (u32 row = 0; row < height; row++)
   {
-    const u16* src_row_ptr = src_ptr;
-    u32* dst_row_ptr = dst_ptr;
-    for (u32 col = 0; col < width; col++)
-      *(dst_row_ptr++) = RGBA5551ToRGBA8888(*(src_row_ptr++));
-
+    ConvertRGBA5551ToRGBA8888(src_ptr, dst_ptr, width);
     src_ptr += src_stride;
     dst_ptr += dst_stride;
   }
@@ -91,18 +88,7 @@ void GPU_SW::CopyOut24Bit(const u16* src_ptr, u32 src_stride, u32* dst_ptr, u32
 {
   for (u32 row = 0; row < height; row++)
   {
-    const u8* src_row_ptr = reinterpret_cast<const u8*>(src_ptr);
-    u32* dst_row_ptr = dst_ptr;
-
-    // Beware unaligned accesses.
-    for (u32 col = 0; col < width; col++)
-    {
-      // This will fill the alpha channel with junk, but that's okay since we don't use it
-      std::memcpy(dst_row_ptr, src_row_ptr, sizeof(u32));
-      src_row_ptr += 3;
-      dst_row_ptr++;
-    }
-
+    ConvertRGB888ToRGBA8888(reinterpret_cast<const u8*>(src_ptr), dst_ptr, width);
     src_ptr += src_stride;
     dst_ptr += dst_stride;
   }
@@ -110,21 +96,27 @@ void GPU_SW::CopyOut24Bit(const u16* src_ptr, u32 src_stride, u32* dst_ptr, u32
 
 void GPU_SW::UpdateDisplay()
 {
-  // fill display texture
-  m_display_texture_buffer.resize(VRAM_WIDTH * VRAM_HEIGHT);
-
   u32 display_width;
   u32 display_height;
   float display_aspect_ratio;
   if (!m_system->GetSettings().debugging.show_vram)
   {
-    // TODO: Handle interlacing
     const u32 vram_offset_x = m_crtc_state.regs.X;
     const u32 vram_offset_y = m_crtc_state.regs.Y;
     display_width = std::min<u32>(m_crtc_state.display_width, VRAM_WIDTH - vram_offset_x);
     display_height = std::min<u32>(m_crtc_state.display_height, VRAM_HEIGHT - vram_offset_y);
     display_aspect_ratio = m_crtc_state.display_aspect_ratio;
 
+    // In interlaced modes, only the lines for the current field are converted. The other field's lines are left over
+    // in the display buffer from the previous frame, which is the same as what the hardware renderers do.
+    const bool interlaced = IsDisplayInterlaced();
+    const u32 field_offset = BoolToUInt8(interlaced && m_GPUSTAT.interlaced_field);
+    const u32 line_step = interlaced ? 2 : 1;
+    const u32 num_lines =
+      (display_height > field_offset) ? ((display_height - field_offset + line_step - 1) / line_step) : 0;
+    const u16* src_ptr = m_vram.data() + (vram_offset_y + field_offset) * VRAM_WIDTH + vram_offset_x;
+    u32* dst_ptr = m_display_texture_buffer.data() + field_offset * display_width;
+
     if (m_GPUSTAT.display_disable)
     {
       m_host_display->SetDisplayTexture(nullptr, 0, 0, 0, 0, 0, 0, display_aspect_ratio);
@@ -132,13 +124,11 @@ void GPU_SW::UpdateDisplay()
     }
     else if (m_GPUSTAT.display_area_color_depth_24)
     {
-      CopyOut24Bit(m_vram.data() + vram_offset_y * VRAM_WIDTH + vram_offset_x, VRAM_WIDTH,
-                   m_display_texture_buffer.data(), display_width, display_width, display_height);
+      CopyOut24Bit(src_ptr, VRAM_WIDTH * line_step, dst_ptr, display_width * line_step, display_width, num_lines);
     }
     else
     {
-      CopyOut15Bit(m_vram.data() + vram_offset_y * VRAM_WIDTH + vram_offset_x, VRAM_WIDTH,
-                   m_display_texture_buffer.data(), display_width, display_width, display_height);
+      CopyOut15Bit(src_ptr, VRAM_WIDTH * line_step, dst_ptr, display_width * line_step, display_width, num_lines);
     }
   }
   else
@@ -453,21 +443,51 @@ void GPU_SW::DrawRectangle(s32 origin_x, s32 origin_y, u32 width, u32 height, u8
   origin_x += m_drawing_offset.x;
   origin_y += m_drawing_offset.y;
 
-  for (u32 offset_y = 0; offset_y < height; offset_y++)
+  // clip to drawing area once, rather than per pixel
+  const s32 start_x = std::max(origin_x, static_cast<s32>(m_drawing_area.left));
+  const s32 end_x = std::min(origin_x + static_cast<s32>(width) - 1, static_cast<s32>(m_drawing_area.right));
+  const s32 start_y = std::max(origin_y, static_cast<s32>(m_drawing_area.top));
+  const s32 end_y = std::min(origin_y + static_cast<s32>(height) - 1, static_cast<s32>(m_drawing_area.bottom));
+  if (start_x > end_x || start_y > end_y)
+    return;
+
+  const u16 mask_and = m_GPUSTAT.GetMaskAND();
+  const u16 mask_or = m_GPUSTAT.GetMaskOR();
+
+  if constexpr (!texture_enable && !transparency_enable)
   {
-    const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y < static_cast<s32>(m_drawing_area.top) || y > static_cast<s32>(m_drawing_area.bottom))
-      continue;
+    // Flat colour, opaque - every pixel is the same, so fill the spans.
+    VRAMPixel color;
+    color.SetRGB24(r, g, b);
+    if ((color.bits & mask_and) != mask_and)
+      return;
 
-    const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + offset_y);
+    const u16 value = color.bits | mask_or;
+    const u32 span_width = static_cast<u32>(end_x - start_x + 1);
+    for (s32 y = start_y; y <= end_y; y++)
+      std::fill_n(GetPixelPtr(static_cast<u32>(start_x), static_cast<u32>(y)), span_width, value);
 
-    for (u32 offset_x = 0; offset_x < width; offset_x++)
+    return;
+  }
+  else if constexpr (texture_enable && !transparency_enable)
+  {
+    // Opaque textured rectangles without a texture window can read the page rows directly.
+    if (m_draw_mode.texture_window_mask_x == 0 && m_draw_mode.texture_window_mask_y == 0 &&
+        !m_draw_mode.texture_x_flip && !m_draw_mode.texture_y_flip)
     {
-      const s32 x = origin_x + static_cast<s32>(offset_x);
-      if (x < static_cast<s32>(m_drawing_area.left) || x > static_cast<s32>(m_drawing_area.right))
-        continue;
+      DrawTexturedRectangleSpans<raw_texture_enable>(origin_x, origin_y, start_x, start_y, end_x, end_y, r, g, b,
+                                                     origin_texcoord_x, origin_texcoord_y);
+      return;
+    }
+  }
+
+  for (s32 y = start_y; y <= end_y; y++)
+  {
+    const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + static_cast<u32>(y - origin_y));
 
-      const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + offset_x);
+    for (s32 x = start_x; x <= end_x; x++)
+    {
+      const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + static_cast<u32>(x - origin_x));
 
       ShadePixel<texture_enable, raw_texture_enable, transparency_enable, false>(
         static_cast<u32>(x), static_cast<u32>(y), r, g, b, texcoord_x, texcoord_y);
@@ -475,6 +495,93 @@ void GPU_SW::DrawRectangle(s32 origin_x, s32 origin_y, u32 width, u32 height, u8
   }
 }
 
+template<bool raw_texture_enable>
+void GPU_SW::DrawTexturedRectangleSpans(s32 origin_x, s32 origin_y, s32 start_x, s32 start_y, s32 end_x, s32 end_y,
+                                        u8 r, u8 g, u8 b, u8 origin_texcoord_x, u8 origin_texcoord_y)
+{
+  const u16 mask_and = m_GPUSTAT.GetMaskAND();
+  const u16 mask_or = m_GPUSTAT.GetMaskOR();
+  const u32 page_x = m_draw_mode.texture_page_x;
+  const u32 page_y = m_draw_mode.texture_page_y;
+
+  // Translate the palette once for the whole rectangle.
+  std::array<u16, 256> clut;
+  const TextureMode texture_mode = m_draw_mode.GetTextureMode();
+  if (texture_mode == TextureMode::Palette4Bit || texture_mode == TextureMode::Palette8Bit)
+  {
+    const u32 clut_size = (texture_mode == TextureMode::Palette4Bit) ? 16 : 256;
+    for (u32 i = 0; i < clut_size; i++)
+    {
+      clut[i] = GetPixel(std::min<u32>(m_draw_mode.texture_palette_x + i, VRAM_WIDTH - 1),
+                         m_draw_mode.texture_palette_y);
+    }
+  }
+
+  const auto draw_spans = [&](auto fetch_texel) {
+    for (s32 y = start_y; y <= end_y; y++)
+    {
+      const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + static_cast<u32>(y - origin_y));
+      const u16* page_row_ptr = GetPixelPtr(0, std::min<u32>(page_y + ZeroExtend32(texcoord_y), VRAM_HEIGHT - 1));
+      u16* dst_ptr = GetPixelPtr(0, static_cast<u32>(y));
+
+      for (s32 x = start_x; x <= end_x; x++)
+      {
+        const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + static_cast<u32>(x - origin_x));
+        const VRAMPixel texture_color{fetch_texel(page_row_ptr, texcoord_x)};
+        if (texture_color.bits == 0)
+          continue;
+
+        VRAMPixel color;
+        if constexpr (raw_texture_enable)
+        {
+          color.bits = texture_color.bits;
+        }
+        else
+        {
+          color.SetRGB24(
+            Truncate8(std::min<u16>((ZeroExtend16(texture_color.GetR8()) * ZeroExtend16(r)) >> 7, 0xFF)),
+            Truncate8(std::min<u16>((ZeroExtend16(texture_color.GetG8()) * ZeroExtend16(g)) >> 7, 0xFF)),
+            Truncate8(std::min<u16>((ZeroExtend16(texture_color.GetB8()) * ZeroExtend16(b)) >> 7, 0xFF)));
+        }
+
+        if ((color.bits & mask_and) != mask_and)
+          continue;
+
+        dst_ptr[x] = color.bits | mask_or;
+      }
+    }
+  };
+
+  switch (texture_mode)
+  {
+    case GPU::TextureMode::Palette4Bit:
+    {
+      draw_spans([page_x, &clut](const u16* page_row_ptr, u8 texcoord_x) -> u16 {
+        const u16 palette_value = page_row_ptr[std::min<u32>(page_x + ZeroExtend32(texcoord_x / 4), VRAM_WIDTH - 1)];
+        return clut[(palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu];
+      });
+    }
+    break;
+
+    case GPU::TextureMode::Palette8Bit:
+    {
+      draw_spans([page_x, &clut](const u16* page_row_ptr, u8 texcoord_x) -> u16 {
+        const u16 palette_value = page_row_ptr[std::min<u32>(page_x + ZeroExtend32(texcoord_x / 2), VRAM_WIDTH - 1)];
+        return clut[(palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu];
+      });
+    }
+    break;
+
+    default:
+    {
+      draw_spans([page_x](const u16* page_row_ptr, u8 texcoord_x) -> u16 {
+        return page_row_ptr[std::min<u32>(page_x + ZeroExtend32(texcoord_x), VRAM_WIDTH - 1)];
+      });
+    }
+    break;
+  }
+}
+
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
 void GPU_SW::ShadePixel(u32 x, u32 y, u8 color_r, u8 color_g, u8 color_b, u8 texcoord_x, u8 texcoord_y)
 {
@@ -640,6 +747,18 @@ void GPU_SW::DrawLine(const SWVertex* p0, const SWVertex* p1)
   const s32 dy = p1->y - p0->y;
   const s32 k = std::max(std::abs(dx), std::abs(dy));
 
+  // Flat opaque horizontal/vertical lines don't need the stepping, and are common in UIs.
+  if constexpr (!shading_enable && !transparency_enable)
+  {
+    if (k > 0 && (dx == 0 || dy == 0))
+    {
+      DrawAxisAlignedLine<dithering_enable>(p0->x + m_drawing_offset.x, p0->y + m_drawing_offset.y,
+                                            p1->x + m_drawing_offset.x, p1->y + m_drawing_offset.y, p0->color_r,
+                                            p0->color_g, p0->color_b);
+      return;
+    }
+  }
+
   FixedPointCoord step_x, step_y;
   FixedPointColor step_r, step_g, step_b;
   if (k > 0)
@@ -703,6 +822,69 @@ void GPU_SW::DrawLine(const SWVertex* p0, const SWVertex* p1)
   }
 }
 
+template<bool dithering_enable>
+void GPU_SW::DrawAxisAlignedLine(s32 x0, s32 y0, s32 x1, s32 y1, u8 r, u8 g, u8 b)
+{
+  s32 start_x = std::max(std::min(x0, x1), static_cast<s32>(m_drawing_area.left));
+  s32 end_x = std::min(std::max(x0, x1), static_cast<s32>(m_drawing_area.right));
+  s32 start_y = std::max(std::min(y0, y1), static_cast<s32>(m_drawing_area.top));
+  s32 end_y = std::min(std::max(y0, y1), static_cast<s32>(m_drawing_area.bottom));
+  if (start_x > end_x || start_y > end_y)
+    return;
+
+  // The dither pattern repeats every four pixels along either axis, so only four values are needed.
+  const u16 mask_and = m_GPUSTAT.GetMaskAND();
+  const u16 mask_or = m_GPUSTAT.GetMaskOR();
+  std::array<u16, 4> values;
+  std::array<bool, 4> writable;
+  for (u32 i = 0; i < 4; i++)
+  {
+    VRAMPixel color;
+    if constexpr (dithering_enable)
+    {
+      if (start_y == end_y)
+        color.SetRGB24Dithered(static_cast<u32>(start_x) + i, static_cast<u32>(start_y), r, g, b);
+      else
+        color.SetRGB24Dithered(static_cast<u32>(start_x), static_cast<u32>(start_y) + i, r, g, b);
+    }
+    else
+    {
+      color.SetRGB24(r, g, b);
+    }
+
+    writable[i] = ((color.bits & mask_and) == mask_and);
+    values[i] = color.bits | mask_or;
+  }
+
+  if (start_y == end_y)
+  {
+    u16* row_ptr = GetPixelPtr(0, static_cast<u32>(start_y));
+    if constexpr (!dithering_enable)
+    {
+      if (writable[0])
+        std::fill(row_ptr + start_x, row_ptr + end_x + 1, values[0]);
+    }
+    else
+    {
+      for (s32 x = start_x; x <= end_x; x++)
+      {
+        const u32 index = static_cast<u32>(x - start_x) & 3u;
+        if (writable[index])
+          row_ptr[x] = values[index];
+      }
+    }
+  }
+  else
+  {
+    for (s32 y = start_y; y <= end_y; y++)
+    {
+      const u32 index = static_cast<u32>(y - start_y) & 3u;
+      if (writable[index])
+        SetPixel(static_cast<u32>(start_x), static_cast<u32>(y), values[index]);
+    }
+  }
+}
+
 GPU_SW::DrawLineFunction GPU_SW::GetDrawLineFunction(bool shading_enable, bool transparency_enable,
                                                      bool dithering_enable)
 {
@@ -76,6 +76,10 @@ protected:
   void DrawRectangle(s32 origin_x, s32 origin_y, u32 width, u32 height, u8 r, u8 g, u8 b, u8 origin_texcoord_x,
                      u8 origin_texcoord_y);
 
+  template<bool raw_texture_enable>
+  void DrawTexturedRectangleSpans(s32 origin_x, s32 origin_y, s32 start_x, s32 start_y, s32 end_x, s32 end_y, u8 r,
+                                  u8 g, u8 b, u8 origin_texcoord_x, u8 origin_texcoord_y);
+
   using DrawRectangleFunction = void (GPU_SW::*)(s32 origin_x, s32 origin_y, u32 width, u32 height, u8 r, u8 g, u8 b,
                                                  u8 origin_texcoord_x, u8 origin_texcoord_y);
   DrawRectangleFunction GetDrawRectangleFunction(bool texture_enable, bool raw_texture_enable,
@@ -84,11 +88,16 @@ protected:
   template<bool shading_enable, bool transparency_enable, bool dithering_enable>
   void DrawLine(const SWVertex* p0, const SWVertex* p1);
 
+  template<bool dithering_enable>
+  void DrawAxisAlignedLine(s32 x0, s32 y0, s32 x1, s32 y1, u8 r, u8 g, u8 b);
+
   using DrawLineFunction = void (GPU_SW::*)(const SWVertex* p0, const SWVertex* p1);
   DrawLineFunction GetDrawLineFunction(bool shading_enable, bool transparency_enable, bool dithering_enable);
 
-  std::vector<u32> m_display_texture_buffer;
   std::unique_ptr<HostDisplayTexture> m_display_texture;
 
+  // Kept across frames, so that interlaced scanout only needs to convert the lines for the current field.
+  alignas(32) std::array<u32, VRAM_WIDTH * VRAM_HEIGHT> m_display_texture_buffer;
+
   std::array<u16, VRAM_WIDTH * VRAM_HEIGHT> m_vram;
 };
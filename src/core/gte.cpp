@@ -38,6 +38,90 @@ static inline constexpr u32 CountLeadingBits(u32 value)
   return count;
 }
 
+// Helpers for the batched three-vertex instructions, which accumulate FLAG bits in a mask instead of setting them one
+// field at a time. The component index selects the bit for MAC1-3/IR1-3/R,G,B.
+static constexpr s64 MAC123_MIN = -(INT64_C(1) << 43);
+static constexpr s64 MAC123_MAX = (INT64_C(1) << 43) - 1;
+static constexpr u32 FLAG_MAC_OVERFLOW_BIT = 30;
+static constexpr u32 FLAG_MAC_UNDERFLOW_BIT = 27;
+static constexpr u32 FLAG_IR_SATURATED_BIT = 24;
+static constexpr u32 FLAG_COLOR_SATURATED_BIT = 21;
+
+static ALWAYS_INLINE u32 GetMACFlags(s64 value, u32 component)
+{
+  if (value > MAC123_MAX)
+    return 1u << (FLAG_MAC_OVERFLOW_BIT - component);
+  else if (value < MAC123_MIN)
+    return 1u << (FLAG_MAC_UNDERFLOW_BIT - component);
+  return 0;
+}
+
+static ALWAYS_INLINE s64 CheckAndSignExtendMAC(s64 value, u32 component, u32& flags)
+{
+  flags |= GetMACFlags(value, component);
+  return SignExtendN<44>(value);
+}
+
+static ALWAYS_INLINE s32 SaturateIR(s32 value, s32 min_value, u32 component, u32& flags)
+{
+  if (value < min_value)
+  {
+    flags |= 1u << (FLAG_IR_SATURATED_BIT - component);
+    return min_value;
+  }
+  else if (value > 0x7FFF)
+  {
+    flags |= 1u << (FLAG_IR_SATURATED_BIT - component);
+    return 0x7FFF;
+  }
+  return value;
+}
+
+// Copies a matrix out of the register file, so that the compiler doesn't have to assume that results stored through
+// pointers overwrite it.
+static ALWAYS_INLINE void LoadMatrix(const s16 in[3][3], s32 out[3][3])
+{
+  for (u32 i = 0; i < 3; i++)
+  {
+    for (u32 j = 0; j < 3; j++)
+      out[i][j] = in[i][j];
+  }
+}
+
+// (T * 1000h + M * V) for three vertices, with the same intermediate overflow checks as the translated MulMatVec().
+static ALWAYS_INLINE void MulMatVecTriple(const s32 M[3][3], const s32 T[3], const s32 V[3][3], s64 out[3][3],
+                                          u32& flags)
+{
+  // With the translation in -40000000h..3FFFFFFFh, neither the partial sums nor the result can leave the 44-bit range,
+  // so the checks can be skipped. Games don't come anywhere near that.
+  const auto InSafeRange = [](s32 value) {
+    return (static_cast<u32>(value) + (UINT32_C(1) << 30)) < (UINT32_C(1) << 31);
+  };
+  if (InSafeRange(T[0]) && InSafeRange(T[1]) && InSafeRange(T[2]))
+  {
+    for (u32 i = 0; i < 3; i++)
+    {
+      for (u32 v = 0; v < 3; v++)
+      {
+        out[i][v] = (s64(T[i]) << 12) + (s64(M[i][0]) * s64(V[0][v])) + (s64(M[i][1]) * s64(V[1][v])) +
+                    (s64(M[i][2]) * s64(V[2][v]));
+      }
+    }
+
+    return;
+  }
+
+  for (u32 i = 0; i < 3; i++)
+  {
+    for (u32 v = 0; v < 3; v++)
+    {
+      s64 sum = CheckAndSignExtendMAC((s64(T[i]) << 12) + (s64(M[i][0]) * s64(V[0][v])), i, flags);
+      sum = CheckAndSignExtendMAC(sum + (s64(M[i][1]) * s64(V[1][v])), i, flags);
+      out[i][v] = sum + (s64(M[i][2]) * s64(V[2][v]));
+    }
+  }
+}
+
 namespace GTE {
 
 Core::Core() = default;
@@ -279,6 +363,46 @@ void Core::ExecuteInstruction(Instruction inst)
   }
 }
 
+void Core::ExecuteTripleInstructionReference(Instruction inst)
+{
+  const u8 shift = inst.GetShift();
+  const bool lm = inst.lm;
+  m_regs.FLAG.Clear();
+
+  switch (inst.command)
+  {
+    case 0x16: // NCDT
+      NCDS(m_regs.V0, shift, lm);
+      NCDS(m_regs.V1, shift, lm);
+      NCDS(m_regs.V2, shift, lm);
+      break;
+
+    case 0x20: // NCT
+      NCS(m_regs.V0, shift, lm);
+      NCS(m_regs.V1, shift, lm);
+      NCS(m_regs.V2, shift, lm);
+      break;
+
+    case 0x30: // RTPT
+      RTPS(m_regs.V0, shift, lm, false);
+      RTPS(m_regs.V1, shift, lm, false);
+      RTPS(m_regs.V2, shift, lm, true);
+      break;
+
+    case 0x3F: // NCCT
+      NCCS(m_regs.V0, shift, lm);
+      NCCS(m_regs.V1, shift, lm);
+      NCCS(m_regs.V2, shift, lm);
+      break;
+
+    default:
+      Panic("Not a three-vertex command");
+      break;
+  }
+
+  m_regs.FLAG.UpdateError();
+}
+
 void Core::SetOTZ(s32 value)
 {
   if (value < 0)
@@ -552,7 +676,7 @@ void Core::Execute_OP(Instruction inst)
   m_regs.FLAG.UpdateError();
 }
 
-void Core::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
+ALWAYS_INLINE void Core::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
 {
 #define dot3(i)                                                                                                        \
   SignExtendMACResult<i + 1>(                                                                                          \
@@ -607,20 +731,96 @@ void Core::Execute_RTPS(Instruction inst)
   m_regs.FLAG.UpdateError();
 }
 
+ALWAYS_INLINE void Core::RTPT(u8 shift, bool lm)
+{
+  const s32 ir_min = lm ? 0 : IR123_MIN_VALUE;
+  const s32 V[3][3] = {{m_regs.V0[0], m_regs.V1[0], m_regs.V2[0]},
+                       {m_regs.V0[1], m_regs.V1[1], m_regs.V2[1]},
+                       {m_regs.V0[2], m_regs.V1[2], m_regs.V2[2]}};
+  const s32 TR[3] = {m_regs.TR[0], m_regs.TR[1], m_regs.TR[2]};
+  s32 RT[3][3];
+  LoadMatrix(m_regs.RT, RT);
+
+  // [MAC1,MAC2,MAC3] = (TR*1000h + RT*V) SAR (sf*12), for all three vertices
+  u32 flags = 0;
+  s64 product[3][3];
+  s32 MAC[3][3];
+  s32 IR[3][3];
+  MulMatVecTriple(RT, TR, V, product, flags);
+  for (u32 i = 0; i < 3; i++)
+  {
+    for (u32 v = 0; v < 3; v++)
+    {
+      flags |= GetMACFlags(product[i][v], i);
+      MAC[i][v] = static_cast<s32>(product[i][v] >> shift);
+    }
+  }
+
+  // See RTPS() for the IR3 saturation quirk.
+  for (u32 v = 0; v < 3; v++)
+  {
+    IR[0][v] = SaturateIR(MAC[0][v], ir_min, 0, flags);
+    IR[1][v] = SaturateIR(MAC[1][v], ir_min, 1, flags);
+    SaturateIR(static_cast<s32>(product[2][v] >> 12), IR123_MIN_VALUE, 2, flags);
+    IR[2][v] = std::clamp(MAC[2][v], ir_min, IR123_MAX_VALUE);
+  }
+
+  // The perspective divide depends on the SZ FIFO, so it's done one vertex at a time.
+  for (u32 v = 0; v < 3; v++)
+  {
+    PushSZ(static_cast<s32>(product[2][v] >> 12));
+
+    const s64 result = static_cast<s64>(ZeroExtend64(UNRDivide(m_regs.H, m_regs.SZ3)));
+    const s64 Sx = s64(result) * s64(IR[0][v]) + s64(m_regs.OFX);
+    const s64 Sy = s64(result) * s64(IR[1][v]) + s64(m_regs.OFY);
+    CheckMACOverflow<0>(Sx);
+    CheckMACOverflow<0>(Sy);
+    PushSXY(s32(Sx >> 16), s32(Sy >> 16));
+
+    if (v == 2)
+    {
+      const s64 Sz = s64(result) * s64(m_regs.DQA) + s64(m_regs.DQB);
+      TruncateAndSetMAC<0>(Sz, 0);
+      TruncateAndSetIR<0>(s32(Sz >> 12), true);
+    }
+  }
+
+  SetMACAndIRTriple(MAC, IR);
+  m_regs.FLAG.bits |= flags;
+}
+
 void Core::Execute_RTPT(Instruction inst)
 {
   m_regs.FLAG.Clear();
+  RTPT(inst.GetShift(), inst.lm);
+  m_regs.FLAG.UpdateError();
+}
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  RTPS(m_regs.V0, shift, lm, false);
-  RTPS(m_regs.V1, shift, lm, false);
-  RTPS(m_regs.V2, shift, lm, true);
+template<bool sf, bool lm>
+void Core::Execute_RTPS()
+{
+  m_regs.FLAG.Clear();
+  RTPS(m_regs.V0, sf ? 12 : 0, lm, true);
+  m_regs.FLAG.UpdateError();
+}
 
+template<bool sf, bool lm>
+void Core::Execute_RTPT()
+{
+  m_regs.FLAG.Clear();
+  RTPT(sf ? 12 : 0, lm);
   m_regs.FLAG.UpdateError();
 }
 
+template void Core::Execute_RTPS<false, false>();
+template void Core::Execute_RTPS<false, true>();
+template void Core::Execute_RTPS<true, false>();
+template void Core::Execute_RTPS<true, true>();
+template void Core::Execute_RTPT<false, false>();
+template void Core::Execute_RTPT<false, true>();
+template void Core::Execute_RTPT<true, false>();
+template void Core::Execute_RTPT<true, true>();
+
 void Core::Execute_NCLIP(Instruction inst)
 {
   // MAC0 =   SX0*SY1 + SX1*SY2 + SX2*SY0 - SX0*SY2 - SX1*SY0 - SX2*SY1
@@ -692,17 +892,96 @@ void Core::Execute_NCS(Instruction inst)
   m_regs.FLAG.UpdateError();
 }
 
+void Core::LightVerticesTriple(u8 shift, bool lm, s32 MAC[3][3], s32 IR[3][3], u32& flags)
+{
+  const s32 ir_min = lm ? 0 : IR123_MIN_VALUE;
+  const s32 V[3][3] = {{m_regs.V0[0], m_regs.V1[0], m_regs.V2[0]},
+                       {m_regs.V0[1], m_regs.V1[1], m_regs.V2[1]},
+                       {m_regs.V0[2], m_regs.V1[2], m_regs.V2[2]}};
+  const s32 BK[3] = {m_regs.BK[0], m_regs.BK[1], m_regs.BK[2]};
+  s32 LLM[3][3], LCM[3][3];
+  LoadMatrix(m_regs.LLM, LLM);
+  LoadMatrix(m_regs.LCM, LCM);
+
+  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (LLM*V) SAR (sf*12)
+  // Three 16x16-bit products can't exceed 44 bits, so there's no MAC overflow to check for here.
+  u32 local_flags = 0;
+  s32 light_IR[3][3];
+  for (u32 i = 0; i < 3; i++)
+  {
+    for (u32 v = 0; v < 3; v++)
+    {
+      const s64 product =
+        (s64(LLM[i][0]) * s64(V[0][v])) + (s64(LLM[i][1]) * s64(V[1][v])) + (s64(LLM[i][2]) * s64(V[2][v]));
+      light_IR[i][v] = SaturateIR(static_cast<s32>(product >> shift), ir_min, i, local_flags);
+    }
+  }
+
+  // [IR1,IR2,IR3] = [MAC1,MAC2,MAC3] = (BK*1000h + LCM*IR) SAR (sf*12)
+  s64 product[3][3];
+  MulMatVecTriple(LCM, BK, light_IR, product, local_flags);
+  for (u32 i = 0; i < 3; i++)
+  {
+    for (u32 v = 0; v < 3; v++)
+    {
+      local_flags |= GetMACFlags(product[i][v], i);
+      MAC[i][v] = static_cast<s32>(product[i][v] >> shift);
+      IR[i][v] = SaturateIR(MAC[i][v], ir_min, i, local_flags);
+    }
+  }
+
+  flags |= local_flags;
+}
+
+void Core::PushRGBTriple(const s32 MAC[3][3], u32& flags)
+{
+  // Color FIFO = [MAC1/16,MAC2/16,MAC3/16,CODE]. All three entries are replaced.
+  const u32 c = ZeroExtend32(m_regs.RGBC[3]) << 24;
+  u32 local_flags = 0;
+  u32 colors[3];
+  for (u32 v = 0; v < 3; v++)
+  {
+    u32 rgb = c;
+    for (u32 i = 0; i < 3; i++)
+    {
+      // Note: SHR 4 used instead of /16 as the results are different.
+      const s32 value = MAC[i][v] >> 4;
+      const s32 clamped = std::clamp<s32>(value, 0x00, 0xFF);
+      local_flags |= static_cast<u32>(clamped != value) << (FLAG_COLOR_SATURATED_BIT - i);
+      rgb |= static_cast<u32>(clamped) << (i * 8);
+    }
+
+    colors[v] = rgb;
+  }
+
+  m_regs.dr32[20] = colors[0];
+  m_regs.dr32[21] = colors[1];
+  m_regs.dr32[22] = colors[2];
+  flags |= local_flags;
+}
+
+void Core::SetMACAndIRTriple(const s32 MAC[3][3], const s32 IR[3][3])
+{
+  // Only the last vertex's results are left in the registers.
+  for (u32 i = 0; i < 3; i++)
+  {
+    m_regs.dr32[25 + i] = static_cast<u32>(MAC[i][2]);
+    m_regs.dr32[9 + i] = static_cast<u32>(IR[i][2]);
+  }
+}
+
 void Core::Execute_NCT(Instruction inst)
 {
   m_regs.FLAG.Clear();
 
-  const u8 shift = inst.GetShift();
-  const bool lm = inst.lm;
-
-  NCS(m_regs.V0, shift, lm);
-  NCS(m_regs.V1, shift, lm);
-  NCS(m_regs.V2, shift, lm);
+  u32 flags = 0;
+  s32 MAC[3][3];
+  s32 IR[3][3];
+  LightVerticesTriple(inst.GetShift(), inst.lm, MAC, IR, flags);
+  PushRGBTriple(MAC, flags);
+  SetMACAndIRTriple(MAC, IR);
 
+  m_regs.FLAG.bits |= flags;
   m_regs.FLAG.UpdateError();
 }
 
@@ -739,11 +1018,28 @@ void Core::Execute_NCCT(Instruction inst)
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
+  const s32 ir_min = lm ? 0 : IR123_MIN_VALUE;
+
+  u32 flags = 0;
+  s32 MAC[3][3];
+  s32 IR[3][3];
+  LightVerticesTriple(shift, lm, MAC, IR, flags);
+
+  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4 SAR (sf*12), which can't overflow.
+  for (u32 i = 0; i < 3; i++)
+  {
+    const s32 color = s32(ZeroExtend32(m_regs.RGBC[i]));
+    for (u32 v = 0; v < 3; v++)
+    {
+      MAC[i][v] = static_cast<s32>((s64(color * IR[i][v]) << 4) >> shift);
+      IR[i][v] = SaturateIR(MAC[i][v], ir_min, i, flags);
+    }
+  }
 
-  NCCS(m_regs.V0, shift, lm);
-  NCCS(m_regs.V1, shift, lm);
-  NCCS(m_regs.V2, shift, lm);
+  PushRGBTriple(MAC, flags);
+  SetMACAndIRTriple(MAC, IR);
 
+  m_regs.FLAG.bits |= flags;
   m_regs.FLAG.UpdateError();
 }
 
@@ -783,11 +1079,35 @@ void Core::Execute_NCDT(Instruction inst)
 
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
+  const s32 ir_min = lm ? 0 : IR123_MIN_VALUE;
+
+  u32 flags = 0;
+  s32 MAC[3][3];
+  s32 IR[3][3];
+  LightVerticesTriple(shift, lm, MAC, IR, flags);
+
+  for (u32 i = 0; i < 3; i++)
+  {
+    const s32 color = s32(ZeroExtend32(m_regs.RGBC[i]));
+    const s64 far_color = s64(m_regs.FC[i]) << 12;
+    for (u32 v = 0; v < 3; v++)
+    {
+      // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
+      const s32 in_MAC = (color * IR[i][v]) << 4;
+
+      // [MAC1,MAC2,MAC3] = MAC+(FC-MAC)*IR0, see InterpolateColor(). Only the first step can overflow.
+      const s64 diff = far_color - in_MAC;
+      flags |= GetMACFlags(diff, i);
+      const s32 diff_IR = SaturateIR(static_cast<s32>(diff >> shift), IR123_MIN_VALUE, i, flags);
+      MAC[i][v] = static_cast<s32>((s64(diff_IR * s32(m_regs.IR0)) + in_MAC) >> shift);
+      IR[i][v] = SaturateIR(MAC[i][v], ir_min, i, flags);
+    }
+  }
 
-  NCDS(m_regs.V0, shift, lm);
-  NCDS(m_regs.V1, shift, lm);
-  NCDS(m_regs.V2, shift, lm);
+  PushRGBTriple(MAC, flags);
+  SetMACAndIRTriple(MAC, IR);
 
+  m_regs.FLAG.bits |= flags;
   m_regs.FLAG.UpdateError();
 }
 
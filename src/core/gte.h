@@ -7,7 +7,8 @@ class Core;
 
 namespace Recompiler {
 class CodeGenerator;
-}
+class Thunks;
+} // namespace Recompiler
 } // namespace CPU
 
 namespace GTE {
@@ -17,6 +18,7 @@ class Core
 public:
   friend CPU::Core;
   friend CPU::Recompiler::CodeGenerator;
+  friend CPU::Recompiler::Thunks;
 
   Core();
   ~Core();
@@ -31,6 +33,10 @@ public:
 
   void ExecuteInstruction(Instruction inst);
 
+  /// Runs RTPT, NCT, NCCT or NCDT one vertex at a time through the single-vertex functions. The batched versions which
+  /// ExecuteInstruction() uses must match it exactly.
+  void ExecuteTripleInstructionReference(Instruction inst);
+
 private:
   static constexpr s64 MAC0_MIN_VALUE = -(INT64_C(1) << 31);
   static constexpr s64 MAC0_MAX_VALUE = (INT64_C(1) << 31) - 1;
@@ -78,7 +84,14 @@ private:
   // Interpolate colour, or as in nocash "MAC+(FC-MAC)*IR0".
   void InterpolateColor(s64 in_MAC1, s64 in_MAC2, s64 in_MAC3, u8 shift, bool lm);
 
+  // RTPT, NCT, NCCT and NCDT transform their three vertices together rather than going through the single-vertex
+  // functions below. Values are laid out [component][vertex], and FLAG bits are accumulated into a mask.
+  void LightVerticesTriple(u8 shift, bool lm, s32 MAC[3][3], s32 IR[3][3], u32& flags);
+  void PushRGBTriple(const s32 MAC[3][3], u32& flags);
+  void SetMACAndIRTriple(const s32 MAC[3][3], const s32 IR[3][3]);
+
   void RTPS(const s16 V[3], u8 shift, bool lm, bool last);
+  void RTPT(u8 shift, bool lm);
   void NCS(const s16 V[3], u8 shift, bool lm);
   void NCCS(const s16 V[3], u8 shift, bool lm);
   void NCDS(const s16 V[3], u8 shift, bool lm);
@@ -89,6 +102,13 @@ private:
   void Execute_OP(Instruction inst);
   void Execute_RTPS(Instruction inst);
   void Execute_RTPT(Instruction inst);
+
+  // Variants of the hot commands with sf/lm fixed, called directly from recompiled code.
+  template<bool sf, bool lm>
+  void Execute_RTPS();
+  template<bool sf, bool lm>
+  void Execute_RTPT();
+
   void Execute_NCLIP(Instruction inst);
   void Execute_AVSZ3(Instruction inst);
   void Execute_AVSZ4(Instruction inst);
@@ -71,6 +71,8 @@ public:
   // Helper function for computing the draw rectangle in a larger window.
   static std::tuple<int, int, int, int> CalculateDrawRect(int window_width, int window_height, float display_ratio);
 
+  static std::unique_ptr<HostDisplay> CreateNullDisplay();
+
 protected:
   void* m_display_texture_handle = nullptr;
   s32 m_display_offset_x = 0;
@@ -58,6 +58,7 @@ HostInterface::HostInterface()
   m_game_list = std::make_unique<GameList>();
   m_game_list->SetCacheFilename(GetGameListCacheFileName());
   m_game_list->SetDatabaseFilename(GetGameListDatabaseFileName());
+  m_game_list->SetCompiledDatabaseFilename(GetGameListCompiledDatabaseFileName());
   m_last_throttle_time = Common::Timer::GetValue();
 }
 
@@ -427,6 +428,21 @@ bool HostInterface::SaveState(const char* filename)
   return result;
 }
 
+bool HostInterface::StartGPUDump(u32 num_frames)
+{
+  const std::string& code = m_system->GetRunningCode();
+  const std::string filename =
+    GetUserDirectoryRelativePath("dump/%s_%u.psxgpu", code.empty() ? "gpu" : code.c_str(), m_system->GetFrameNumber());
+  if (!m_system->GetGPU()->StartDump(filename.c_str(), num_frames))
+  {
+    ReportFormattedError("Failed to start GPU dump to %s.", filename.c_str());
+    return false;
+  }
+
+  AddFormattedOSDMessage(2.0f, "Dumping %u frames of GPU commands to %s...", num_frames, filename.c_str());
+  return true;
+}
+
 void HostInterface::UpdateSpeedLimiterState()
 {
   m_speed_limiter_enabled = m_settings.speed_limiter_enabled && !m_speed_limiter_temp_disabled;
@@ -519,6 +535,11 @@ std::string HostInterface::GetGameListDatabaseFileName() const
   return GetUserDirectoryRelativePath("cache/redump.dat");
 }
 
+std::string HostInterface::GetGameListCompiledDatabaseFileName() const
+{
+  return GetUserDirectoryRelativePath("cache/redump.db");
+}
+
 std::string HostInterface::GetGameSaveStateFileName(const char* game_code, s32 slot)
 {
   if (slot < 0)
@@ -566,6 +587,14 @@ void HostInterface::SetDefaultSettings()
   m_settings.audio_backend = AudioBackend::Default;
   m_settings.audio_sync_enabled = true;
 
+  m_settings.cdrom_read_thread = false;
+  m_settings.cdrom_load_image_to_ram = false;
+  m_settings.cdrom_load_image_compressed = true;
+  m_settings.cdrom_chd_cache_hunks = 16;
+  m_settings.cdrom_chd_decompression_threads = 1;
+
+  m_settings.mdec_use_thread = false;
+
   m_settings.bios_path = GetUserDirectoryRelativePath("bios/scph1001.bin");
   m_settings.bios_patch_tty_enable = false;
   m_settings.bios_patch_fast_boot = false;
@@ -588,6 +617,7 @@ void HostInterface::UpdateSettings(const std::function<void()>& apply_callback)
   const bool old_audio_sync_enabled = m_settings.audio_sync_enabled;
   const bool old_speed_limiter_enabled = m_settings.speed_limiter_enabled;
   const bool old_display_linear_filtering = m_settings.display_linear_filtering;
+  const bool old_mdec_use_thread = m_settings.mdec_use_thread;
 
   apply_callback();
 
@@ -609,6 +639,9 @@ void HostInterface::UpdateSettings(const std::function<void()>& apply_callback)
 
   if (m_settings.display_linear_filtering != old_display_linear_filtering)
     m_display->SetDisplayLinearFiltering(m_settings.display_linear_filtering);
+
+  if (m_settings.mdec_use_thread != old_mdec_use_thread && m_system)
+    m_system->UpdateMDECSettings();
 }
 
 void HostInterface::ToggleSoftwareRendering()
@@ -62,6 +62,9 @@ public:
   bool LoadState(const char* filename);
   bool SaveState(const char* filename);
 
+  /// Writes the GPU command stream for the next num_frames frames to the dump directory, for use with gpu-replay.
+  bool StartGPUDump(u32 num_frames);
+
   /// Returns the base user directory path.
   const std::string& GetUserDirectory() const { return m_user_directory; }
 
@@ -107,6 +110,9 @@ protected:
   /// Returns the path of the game database cache file.
   std::string GetGameListDatabaseFileName() const;
 
+  /// Returns the path of the game database compiled from the Redump.org database.
+  std::string GetGameListCompiledDatabaseFileName() const;
+
   /// Returns the path to a save state file. Specifying an index of -1 is the "resume" save state.
   std::string GetGameSaveStateFileName(const char* game_code, s32 slot);
 
@@ -1,15 +1,31 @@
 #include "mdec.h"
+#include "common/cpu_detect.h"
 #include "common/log.h"
 #include "common/state_wrapper.h"
 #include "dma.h"
 #include "interrupt_controller.h"
 #include "system.h"
 #include <imgui.h>
+#if defined(CPU_X64)
+#include <immintrin.h>
+#elif defined(CPU_AARCH64)
+#include <arm_neon.h>
+#endif
 Log_SetChannel(MDEC);
 
+// GCC/Clang need the target ISA specified for functions using intrinsics beyond the baseline.
+#if defined(CPU_X64) && !defined(_MSC_VER)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
 MDEC::MDEC() = default;
 
-MDEC::~MDEC() = default;
+MDEC::~MDEC()
+{
+  StopDecodeThread();
+}
 
 void MDEC::Initialize(System* system, DMA* dma)
 {
@@ -17,6 +33,7 @@ void MDEC::Initialize(System* system, DMA* dma)
   m_dma = dma;
   m_block_copy_out_event = system->CreateTimingEvent("MDEC Block Copy Out", TICKS_PER_BLOCK, TICKS_PER_BLOCK,
                                                      std::bind(&MDEC::CopyOutBlock, this), false);
+  UpdateSettings();
 }
 
 void MDEC::Reset()
@@ -26,6 +43,8 @@ void MDEC::Reset()
 
 bool MDEC::DoState(StateWrapper& sw)
 {
+  WaitForDecodeThread();
+
   sw.Do(&m_status.bits);
   sw.Do(&m_enable_dma_in);
   sw.Do(&m_enable_dma_out);
@@ -40,7 +59,8 @@ bool MDEC::DoState(StateWrapper& sw)
   sw.Do(&m_current_block);
   sw.Do(&m_current_coefficient);
   sw.Do(&m_current_q_scale);
-  sw.Do(&m_block_rgb);
+  sw.Do(&m_block_out);
+  sw.Do(&m_block_out_size);
 
   bool block_copy_out_pending = HasPendingBlockCopyOut();
   sw.Do(&block_copy_out_pending);
@@ -50,6 +70,18 @@ bool MDEC::DoState(StateWrapper& sw)
   return !sw.HasError();
 }
 
+void MDEC::UpdateSettings()
+{
+  const bool use_decode_thread = m_system->GetSettings().mdec_use_thread;
+  if (use_decode_thread == m_decode_thread.joinable())
+    return;
+
+  if (use_decode_thread)
+    StartDecodeThread();
+  else
+    StopDecodeThread();
+}
+
 u32 MDEC::ReadRegister(u32 offset)
 {
   switch (offset)
@@ -128,7 +160,7 @@ void MDEC::DMAWrite(const u32* words, u32 word_count)
 {
   do
   {
-    const u32 halfwords_to_write = std::min(word_count * 2, m_data_in_fifo.GetSpace() & ~u32(2));
+    const u32 halfwords_to_write = std::min(word_count * 2, m_data_in_fifo.GetSpace() & ~u32(1));
     m_data_in_fifo.PushRange(reinterpret_cast<const u16*>(words), halfwords_to_write);
     words += halfwords_to_write / 2;
     word_count -= halfwords_to_write / 2;
@@ -143,6 +175,8 @@ bool MDEC::HasPendingBlockCopyOut() const
 
 void MDEC::SoftReset()
 {
+  WaitForDecodeThread();
+
   m_status.bits = 0;
   m_enable_dma_in = false;
   m_enable_dma_out = false;
@@ -358,11 +392,8 @@ bool MDEC::DecodeMonoMacroblock()
   if (!rl_decode_block(m_blocks[0].data(), m_iq_y.data()))
     return false;
 
-  IDCT(m_blocks[0].data());
-
-  y_to_mono(m_blocks[0]);
-
   ScheduleBlockCopyOut(TICKS_PER_BLOCK);
+  ConvertDecodedMacroblock();
 
   m_total_blocks_decoded++;
   return true;
@@ -386,20 +417,14 @@ bool MDEC::DecodeColoredMacroblock()
   {
     if (!rl_decode_block(m_blocks[m_current_block].data(), (m_current_block >= 2) ? m_iq_y.data() : m_iq_uv.data()))
       return false;
-
-    IDCT(m_blocks[m_current_block].data());
   }
 
   // done decoding
   m_current_block = 0;
   Log_DebugPrintf("Decoded colored macroblock, %u words remaining", m_remaining_halfwords / 2);
 
-  yuv_to_rgb(0, 0, m_blocks[0], m_blocks[1], m_blocks[2]);
-  yuv_to_rgb(8, 0, m_blocks[0], m_blocks[1], m_blocks[3]);
-  yuv_to_rgb(0, 8, m_blocks[0], m_blocks[1], m_blocks[4]);
-  yuv_to_rgb(8, 8, m_blocks[0], m_blocks[1], m_blocks[5]);
-
   ScheduleBlockCopyOut(TICKS_PER_BLOCK);
+  ConvertDecodedMacroblock();
 
   m_total_blocks_decoded += 4;
   return true;
@@ -420,110 +445,110 @@ void MDEC::CopyOutBlock()
 
   Log_DebugPrintf("Copying out block");
 
-  switch (m_status.data_output_depth)
+  WaitForDecodeThread();
+  m_data_out_fifo.PushRange(m_block_out.data(), m_block_out_size);
+
+  // if we've copied out all blocks, command is complete
+  if (m_remaining_halfwords == 0)
+    EndCommand();
+  else
+    ExecutePendingCommand();
+}
+
+void MDEC::ConvertDecodedMacroblock()
+{
+  if (!m_decode_thread.joinable())
   {
-    case DataOutputDepth_4Bit:
-    {
-      const u32* in_ptr = m_block_rgb.data();
-      for (u32 i = 0; i < (64 / 8); i++)
-      {
-        u32 value = *(in_ptr++) >> 4;
-        value |= (*(in_ptr++) >> 4) << 4;
-        value |= (*(in_ptr++) >> 4) << 8;
-        value |= (*(in_ptr++) >> 4) << 12;
-        value |= (*(in_ptr++) >> 4) << 16;
-        value |= (*(in_ptr++) >> 4) << 20;
-        value |= (*(in_ptr++) >> 4) << 24;
-        value |= (*(in_ptr++) >> 4) << 28;
-        m_data_out_fifo.Push(value);
-      }
-    }
-    break;
+    ConvertMacroblock(m_status.bits);
+    return;
+  }
 
-    case DataOutputDepth_8Bit:
-    {
-      const u32* in_ptr = m_block_rgb.data();
-      for (u32 i = 0; i < (64 / 4); i++)
-      {
-        u32 value = *in_ptr++;
-        value |= *in_ptr++ << 8;
-        value |= *in_ptr++ << 16;
-        value |= *in_ptr++ << 24;
-        m_data_out_fifo.Push(value);
-      }
-    }
-    break;
+  // The output format is passed by value, since the status register keeps changing while the job runs.
+  m_decode_job_status_bits = m_status.bits;
+  {
+    std::unique_lock<std::mutex> lock(m_decode_mutex);
+    m_decode_job_pending.store(true);
+  }
+  m_decode_cv.notify_one();
+}
 
-    case DataOutputDepth_24Bit:
+void MDEC::ConvertMacroblock(u32 status_bits)
+{
+  const StatusRegister status{status_bits};
+  if (status.data_output_depth <= DataOutputDepth_8Bit)
+  {
+    IDCT(m_scale_table.data(), m_blocks[0].data());
+    y_to_mono(status);
+  }
+  else
+  {
+    for (std::array<s16, 64>& blk : m_blocks)
+      IDCT(m_scale_table.data(), blk.data());
+
+    yuv_to_rgb(status);
+  }
+}
+
+void MDEC::StartDecodeThread()
+{
+  Log_InfoPrintf("Starting MDEC decode thread");
+  m_decode_thread_shutdown = false;
+  m_decode_thread = std::thread(&MDEC::DecodeThreadEntryPoint, this);
+}
+
+void MDEC::StopDecodeThread()
+{
+  if (!m_decode_thread.joinable())
+    return;
+
+  WaitForDecodeThread();
+  {
+    std::unique_lock<std::mutex> lock(m_decode_mutex);
+    m_decode_thread_shutdown = true;
+  }
+  m_decode_cv.notify_one();
+  m_decode_thread.join();
+  Log_InfoPrintf("Stopped MDEC decode thread");
+}
+
+void MDEC::WaitForDecodeThread()
+{
+  // Converting a macroblock only takes a few microseconds, so spin for a while first. The thread can still be held up
+  // by the OS, in which case sleep rather than keeping a second core busy.
+  for (u32 i = 0; i < DECODE_THREAD_SPIN_COUNT && m_decode_job_pending.load(); i++)
+    std::this_thread::yield();
+
+  if (m_decode_job_pending.load())
+  {
+    std::unique_lock<std::mutex> lock(m_decode_mutex);
+    m_decode_done_cv.wait(lock, [this]() { return !m_decode_job_pending.load(); });
+  }
+}
+
+void MDEC::DecodeThreadEntryPoint()
+{
+  for (;;)
+  {
+    // Macroblocks arrive every few microseconds while a movie is playing, and waking a sleeping thread would take
+    // longer than that, so spin for a while before going to sleep.
+    for (u32 i = 0; i < DECODE_THREAD_SPIN_COUNT && !m_decode_job_pending.load(); i++)
+      std::this_thread::yield();
+
+    if (!m_decode_job_pending.load())
     {
-      // pack tightly
-      u32 index = 0;
-      u32 state = 0;
-      u32 rgb = 0;
-      while (index < m_block_rgb.size())
-      {
-        switch (state)
-        {
-          case 0:
-            rgb = m_block_rgb[index++]; // RGB-
-            state = 1;
-            break;
-          case 1:
-            rgb |= (m_block_rgb[index] & 0xFF) << 24; // RGBR
-            m_data_out_fifo.Push(rgb);
-            rgb = m_block_rgb[index] >> 8; // GB--
-            index++;
-            state = 2;
-            break;
-          case 2:
-            rgb |= m_block_rgb[index] << 16; // GBRG
-            m_data_out_fifo.Push(rgb);
-            rgb = m_block_rgb[index] >> 16; // B---
-            index++;
-            state = 3;
-            break;
-          case 3:
-            rgb |= m_block_rgb[index] << 8; // BRGB
-            m_data_out_fifo.Push(rgb);
-            index++;
-            state = 0;
-            break;
-        }
-      }
-      break;
+      std::unique_lock<std::mutex> lock(m_decode_mutex);
+      m_decode_cv.wait(lock, [this]() { return m_decode_job_pending.load() || m_decode_thread_shutdown; });
+      if (!m_decode_job_pending.load())
+        break;
     }
 
-    case DataOutputDepth_15Bit:
+    ConvertMacroblock(m_decode_job_status_bits);
     {
-      const u16 a = ZeroExtend16(m_status.data_output_bit15.GetValue());
-      for (u32 i = 0; i < static_cast<u32>(m_block_rgb.size());)
-      {
-        u32 color = m_block_rgb[i++];
-        u16 r = Truncate16((color >> 3) & 0x1Fu);
-        u16 g = Truncate16((color >> 11) & 0x1Fu);
-        u16 b = Truncate16((color >> 19) & 0x1Fu);
-        const u16 color15a = r | (g << 5) | (b << 10) | (a << 15);
-
-        color = m_block_rgb[i++];
-        r = Truncate16((color >> 3) & 0x1Fu);
-        g = Truncate16((color >> 11) & 0x1Fu);
-        b = Truncate16((color >> 19) & 0x1Fu);
-        const u16 color15b = r | (g << 5) | (b << 10) | (a << 15);
-
-        m_data_out_fifo.Push(ZeroExtend32(color15a) | (ZeroExtend32(color15b) << 16));
-      }
+      std::unique_lock<std::mutex> lock(m_decode_mutex);
+      m_decode_job_pending.store(false);
     }
-    break;
-
-    default:
-      break;
+    m_decode_done_cv.notify_one();
   }
-
-  // if we've copied out all blocks, command is complete
-  if (m_remaining_halfwords == 0)
-    EndCommand();
-  else
-    ExecutePendingCommand();
 }
 
 static constexpr std::array<u8, 64> zigzag = {{0,  1,  5,  6,  14, 15, 27, 28, 2,  4,  7,  13, 16, 26, 29, 42,
@@ -603,7 +628,227 @@ bool MDEC::rl_decode_block(s16* blk, const u8* qt)
   return false;
 }
 
-void MDEC::IDCT(s16* blk)
+#if defined(CPU_X64) || defined(CPU_AARCH64)
+
+namespace {
+
+// Both passes of the IDCT have the form out[r][x] = sum(in[u][r] * scale[u][x]). The first pass produces the
+// intermediate result transposed, which lets the second pass use the same form and produce rows of the output.
+#if defined(CPU_X64)
+// Coefficients (2k, r) and (2k + 1, r) packed into one word, for multiply-adding with a pair of scale table rows.
+ALWAYS_INLINE static s32 GetIDCTInputPair(const s16* in, u32 k, u32 r)
+{
+  return static_cast<s32>(ZeroExtend32(static_cast<u16>(in[(k * 2) * 8 + r])) |
+                          (ZeroExtend32(static_cast<u16>(in[(k * 2 + 1) * 8 + r])) << 16));
+}
+
+struct IDCTScaleRowsSSE2
+{
+  // Rows 2k and 2k+1 of the scale table interleaved, for multiply-adding pairs of rows.
+  __m128i lo[4];
+  __m128i hi[4];
+};
+
+static void LoadIDCTScaleRows(const s16* scale, IDCTScaleRowsSSE2* rows)
+{
+  for (u32 k = 0; k < 4; k++)
+  {
+    const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scale[(k * 2) * 8]));
+    const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scale[(k * 2 + 1) * 8]));
+    rows->lo[k] = _mm_unpacklo_epi16(row0, row1);
+    rows->hi[k] = _mm_unpackhi_epi16(row0, row1);
+  }
+}
+
+static void IDCTMultiply(const s16* in, const IDCTScaleRowsSSE2& rows, s32* out)
+{
+  for (u32 r = 0; r < 8; r++)
+  {
+    __m128i sum_lo = _mm_setzero_si128();
+    __m128i sum_hi = _mm_setzero_si128();
+    for (u32 k = 0; k < 4; k++)
+    {
+      const __m128i in_pair = _mm_set1_epi32(GetIDCTInputPair(in, k, r));
+      sum_lo = _mm_add_epi32(sum_lo, _mm_madd_epi16(rows.lo[k], in_pair));
+      sum_hi = _mm_add_epi32(sum_hi, _mm_madd_epi16(rows.hi[k], in_pair));
+    }
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(&out[r * 8]), sum_lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(&out[r * 8 + 4]), sum_hi);
+  }
+}
+
+struct IDCTScaleRowsAVX2
+{
+  // As for SSE2, with both halves of the interleaved rows in one register, so each row of the output is one sum.
+  __m256i rows[4];
+};
+
+TARGET_AVX2 static void LoadIDCTScaleRows(const s16* scale, IDCTScaleRowsAVX2* rows)
+{
+  for (u32 k = 0; k < 4; k++)
+  {
+    const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scale[(k * 2) * 8]));
+    const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scale[(k * 2 + 1) * 8]));
+    const __m128i lo = _mm_unpacklo_epi16(row0, row1);
+    const __m128i hi = _mm_unpackhi_epi16(row0, row1);
+    rows->rows[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+  }
+}
+
+TARGET_AVX2 static void IDCTMultiply(const s16* in, const IDCTScaleRowsAVX2& rows, s32* out)
+{
+  for (u32 r = 0; r < 8; r++)
+  {
+    __m256i sum = _mm256_setzero_si256();
+    for (u32 k = 0; k < 4; k++)
+    {
+      const __m256i in_pair = _mm256_set1_epi32(GetIDCTInputPair(in, k, r));
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(rows.rows[k], in_pair));
+    }
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(&out[r * 8]), sum);
+  }
+}
+#elif defined(CPU_AARCH64)
+struct IDCTScaleRowsNEON
+{
+  int16x8_t rows[8];
+};
+
+static void LoadIDCTScaleRows(const s16* scale, IDCTScaleRowsNEON* rows)
+{
+  for (u32 u = 0; u < 8; u++)
+    rows->rows[u] = vld1q_s16(&scale[u * 8]);
+}
+
+static void IDCTMultiply(const s16* in, const IDCTScaleRowsNEON& rows, s32* out)
+{
+  for (u32 r = 0; r < 8; r++)
+  {
+    int32x4_t sum_lo = vdupq_n_s32(0);
+    int32x4_t sum_hi = vdupq_n_s32(0);
+    for (u32 u = 0; u < 8; u++)
+    {
+      sum_lo = vmlal_n_s16(sum_lo, vget_low_s16(rows.rows[u]), in[u * 8 + r]);
+      sum_hi = vmlal_n_s16(sum_hi, vget_high_s16(rows.rows[u]), in[u * 8 + r]);
+    }
+
+    vst1q_s32(&out[r * 8], sum_lo);
+    vst1q_s32(&out[r * 8 + 4], sum_hi);
+  }
+}
+#endif
+
+template<typename ScaleRows>
+ALWAYS_INLINE static void IDCTWithScaleRows(const s16* scale_table, s16* blk)
+{
+  ScaleRows scale_rows;
+  LoadIDCTScaleRows(scale_table, &scale_rows);
+
+  // The intermediate values are up to 29 bits, so the second pass would need 44-bit sums. Only bits 31-40 of those
+  // sums are used though, so the intermediate values are split into 16-bit pieces which are multiplied separately,
+  // and recombined without losing those bits.
+  alignas(32) std::array<s32, 64> temp;
+  IDCTMultiply(blk, scale_rows, temp.data());
+
+  alignas(32) std::array<s16, 64> temp_hi;
+  alignas(32) std::array<s16, 64> temp_mid;
+  alignas(32) std::array<s16, 64> temp_lo;
+  for (u32 i = 0; i < 64; i++)
+  {
+    temp_hi[i] = static_cast<s16>(temp[i] >> 16);
+    temp_mid[i] = static_cast<s16>((temp[i] >> 8) & 0xFF);
+    temp_lo[i] = static_cast<s16>(temp[i] & 0xFF);
+  }
+
+  alignas(32) std::array<s32, 64> sum_hi;
+  alignas(32) std::array<s32, 64> sum_mid;
+  alignas(32) std::array<s32, 64> sum_lo;
+  IDCTMultiply(temp_hi.data(), scale_rows, sum_hi.data());
+  IDCTMultiply(temp_mid.data(), scale_rows, sum_mid.data());
+  IDCTMultiply(temp_lo.data(), scale_rows, sum_lo.data());
+
+  for (u32 i = 0; i < 64; i++)
+  {
+    // sum >> 31, from sum = (hi << 16) + (mid << 8) + lo.
+    const s32 sum_shifted = (sum_hi[i] + ((sum_mid[i] + (sum_lo[i] >> 8)) >> 8)) >> 15;
+    blk[i] =
+      static_cast<s16>(std::clamp<s32>(SignExtendN<9, s32>((sum_shifted >> 1) + (sum_shifted & 1)), -128, 127));
+  }
+}
+
+} // namespace
+
+using IDCTFunction = void (*)(const s16* scale_table, s16* blk);
+
+#if defined(CPU_X64)
+
+static void IDCT_SSE2(const s16* scale_table, s16* blk)
+{
+  IDCTWithScaleRows<IDCTScaleRowsSSE2>(scale_table, blk);
+}
+
+TARGET_AVX2 static void IDCT_AVX2(const s16* scale_table, s16* blk)
+{
+  IDCTWithScaleRows<IDCTScaleRowsAVX2>(scale_table, blk);
+}
+
+static IDCTFunction SelectIDCTFunction()
+{
+  return CPUDetect::HostSupportsAVX2() ? IDCT_AVX2 : IDCT_SSE2;
+}
+
+std::vector<MDEC::IDCTImplementation> MDEC::GetSupportedIDCTImplementations()
+{
+  std::vector<IDCTImplementation> implementations = {{"SSE2", IDCT_SSE2}};
+  if (CPUDetect::HostSupportsAVX2())
+    implementations.push_back({"AVX2", IDCT_AVX2});
+
+  return implementations;
+}
+
+#elif defined(CPU_AARCH64)
+
+static void IDCT_NEON(const s16* scale_table, s16* blk)
+{
+  IDCTWithScaleRows<IDCTScaleRowsNEON>(scale_table, blk);
+}
+
+static IDCTFunction SelectIDCTFunction()
+{
+  return IDCT_NEON;
+}
+
+std::vector<MDEC::IDCTImplementation> MDEC::GetSupportedIDCTImplementations()
+{
+  return {{"NEON", IDCT_NEON}};
+}
+
+#endif
+
+static const IDCTFunction s_idct_function = SelectIDCTFunction();
+
+void MDEC::IDCT(const s16* scale_table, s16* blk)
+{
+  s_idct_function(scale_table, blk);
+}
+
+#else
+
+void MDEC::IDCT(const s16* scale_table, s16* blk)
+{
+  IDCTReference(scale_table, blk);
+}
+
+std::vector<MDEC::IDCTImplementation> MDEC::GetSupportedIDCTImplementations()
+{
+  return {};
+}
+
+#endif
+
+void MDEC::IDCTReference(const s16* scale_table, s16* blk)
 {
   std::array<s64, 64> temp_buffer;
   for (u32 x = 0; x < 8; x++)
@@ -612,7 +857,7 @@ void MDEC::IDCT(s16* blk)
     {
       s64 sum = 0;
       for (u32 u = 0; u < 8; u++)
-        sum += s32(blk[u * 8 + x]) * s32(m_scale_table[u * 8 + y]);
+        sum += s32(blk[u * 8 + x]) * s32(scale_table[u * 8 + y]);
       temp_buffer[x + y * 8] = sum;
     }
   }
@@ -622,7 +867,7 @@ void MDEC::IDCT(s16* blk)
     {
       s64 sum = 0;
       for (u32 u = 0; u < 8; u++)
-        sum += s64(temp_buffer[u + y * 8]) * s32(m_scale_table[u * 8 + x]);
+        sum += s64(temp_buffer[u + y * 8]) * s32(scale_table[u * 8 + x]);
 
       blk[x + y * 8] =
         static_cast<s16>(std::clamp<s32>(SignExtendN<9, s32>((sum >> 32) + ((sum >> 31) & 1)), -128, 127));
@@ -630,46 +875,157 @@ void MDEC::IDCT(s16* blk)
   }
 }
 
-void MDEC::yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                      const std::array<s16, 64>& Yblk)
+void MDEC::yuv_to_rgb(const StatusRegister& status)
 {
-  for (u32 y = 0; y < 8; y++)
+  // The colour difference terms are shared by each 2x2 group of pixels, so compute them once per macroblock. These
+  // constants give the same results as truncating 1.402 * Cr, -0.3437 * Cb - 0.7143 * Cr and 1.772 * Cb in floats.
+  const auto TruncatingShift = [](s32 value, u32 shift) {
+    return static_cast<s16>((value < 0) ? -((-value) >> shift) : (value >> shift));
+  };
+
+  alignas(16) std::array<s16, 64> r_terms;
+  alignas(16) std::array<s16, 64> g_terms;
+  alignas(16) std::array<s16, 64> b_terms;
+  for (u32 i = 0; i < 64; i++)
   {
-    for (u32 x = 0; x < 8; x++)
+    const s32 Cr = m_blocks[0][i];
+    const s32 Cb = m_blocks[1][i];
+    r_terms[i] = TruncatingShift(Cr * 22970, 14);
+    g_terms[i] = TruncatingShift(-(Cb * 360396) - (Cr * 748997), 20);
+    b_terms[i] = TruncatingShift(Cb * 29032, 14);
+  }
+
+  const bool output_15bit = (status.data_output_depth == DataOutputDepth_15Bit);
+  const u8 bias = status.data_output_signed ? 0x00 : 0x80;
+  const u16 bit15 = status.data_output_bit15 ? 0x8000 : 0x0000;
+  u8* out_ptr = reinterpret_cast<u8*>(m_block_out.data());
+
+#if defined(CPU_X64)
+  const __m128i bias_vec = _mm_set1_epi16(bias);
+  const __m128i bit15_vec = _mm_set1_epi16(static_cast<s16>(bit15));
+  const auto ConvertChannel = [&bias_vec](__m128i luma, const s16* terms) {
+    const __m128i t = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(terms));
+    const __m128i value = _mm_add_epi16(luma, _mm_unpacklo_epi16(t, t));
+    const __m128i clamped = _mm_max_epi16(_mm_min_epi16(value, _mm_set1_epi16(127)), _mm_set1_epi16(-128));
+    return _mm_and_si128(_mm_xor_si128(clamped, bias_vec), _mm_set1_epi16(0xFF));
+  };
+#elif defined(CPU_AARCH64)
+  const uint8x8_t bias_vec = vdup_n_u8(bias);
+  const uint16x8_t bit15_vec = vdupq_n_u16(bit15);
+  const auto ConvertChannel = [&bias_vec](int16x8_t luma, const s16* terms) {
+    const int16x4_t t = vld1_s16(terms);
+    const int16x8_t value = vaddq_s16(luma, vcombine_s16(vzip1_s16(t, t), vzip2_s16(t, t)));
+    return veor_u8(vreinterpret_u8_s8(vqmovn_s16(value)), bias_vec);
+  };
+#endif
+
+  // Each iteration converts a row of eight pixels from one of the luma blocks, packing it straight to the output.
+  for (u32 y = 0; y < 16; y++)
+  {
+    for (u32 x = 0; x < 16; x += 8)
     {
-      s16 R = Crblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
-      s16 B = Cbblk[((x + xx) / 2) + ((y + yy) / 2) * 8];
-      s16 G = static_cast<s16>((-0.3437f * static_cast<float>(B)) + (-0.7143f * static_cast<float>(R)));
-
-      R = static_cast<s16>(1.402f * static_cast<float>(R));
-      B = static_cast<s16>(1.772f * static_cast<float>(B));
-
-      s16 Y = Yblk[x + y * 8];
-      R = static_cast<s16>(std::clamp(static_cast<int>(Y) + R, -128, 127));
-      G = static_cast<s16>(std::clamp(static_cast<int>(Y) + G, -128, 127));
-      B = static_cast<s16>(std::clamp(static_cast<int>(Y) + B, -128, 127));
-
-      // TODO: Signed output
-      R += 128;
-      G += 128;
-      B += 128;
-
-      m_block_rgb[(x + xx) + ((y + yy) * 16)] = ZeroExtend32(static_cast<u16>(R)) |
-                                                (ZeroExtend32(static_cast<u16>(G)) << 8) |
-                                                (ZeroExtend32(static_cast<u16>(B)) << 16);
+      const s16* Y = &m_blocks[2 + ((y / 8) * 2) + (x / 8)][(y % 8) * 8];
+      const u32 chroma_index = ((y / 2) * 8) + (x / 2);
+      u8* row_out = out_ptr + ((x + y * 16) * (output_15bit ? 2 : 3));
+
+#if defined(CPU_X64)
+      const __m128i luma = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Y));
+      const __m128i R = ConvertChannel(luma, &r_terms[chroma_index]);
+      const __m128i G = ConvertChannel(luma, &g_terms[chroma_index]);
+      const __m128i B = ConvertChannel(luma, &b_terms[chroma_index]);
+      if (output_15bit)
+      {
+        const __m128i RG = _mm_or_si128(_mm_srli_epi16(R, 3), _mm_slli_epi16(_mm_srli_epi16(G, 3), 5));
+        const __m128i B1 = _mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(B, 3), 10), bit15_vec);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row_out), _mm_or_si128(RG, B1));
+      }
+      else
+      {
+        // No byte shuffles in SSE2, so interleave the channels through the stack.
+        alignas(16) u8 rgb[3][16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(rgb[0]), _mm_packus_epi16(R, R));
+        _mm_store_si128(reinterpret_cast<__m128i*>(rgb[1]), _mm_packus_epi16(G, G));
+        _mm_store_si128(reinterpret_cast<__m128i*>(rgb[2]), _mm_packus_epi16(B, B));
+        for (u32 i = 0; i < 8; i++)
+        {
+          row_out[i * 3 + 0] = rgb[0][i];
+          row_out[i * 3 + 1] = rgb[1][i];
+          row_out[i * 3 + 2] = rgb[2][i];
+        }
+      }
+#elif defined(CPU_AARCH64)
+      const int16x8_t luma = vld1q_s16(Y);
+      const uint8x8_t R = ConvertChannel(luma, &r_terms[chroma_index]);
+      const uint8x8_t G = ConvertChannel(luma, &g_terms[chroma_index]);
+      const uint8x8_t B = ConvertChannel(luma, &b_terms[chroma_index]);
+      if (output_15bit)
+      {
+        const uint16x8_t RG = vorrq_u16(vshrq_n_u16(vmovl_u8(R), 3), vshlq_n_u16(vshrq_n_u16(vmovl_u8(G), 3), 5));
+        const uint16x8_t B1 = vorrq_u16(vshlq_n_u16(vshrq_n_u16(vmovl_u8(B), 3), 10), bit15_vec);
+        vst1q_u16(reinterpret_cast<u16*>(row_out), vorrq_u16(RG, B1));
+      }
+      else
+      {
+        const uint8x8x3_t rgb = {{R, G, B}};
+        vst3_u8(row_out, rgb);
+      }
+#else
+      for (u32 i = 0; i < 8; i++)
+      {
+        const u32 c = chroma_index + (i / 2);
+        const u8 R = static_cast<u8>(static_cast<u8>(std::clamp<s32>(Y[i] + r_terms[c], -128, 127)) ^ bias);
+        const u8 G = static_cast<u8>(static_cast<u8>(std::clamp<s32>(Y[i] + g_terms[c], -128, 127)) ^ bias);
+        const u8 B = static_cast<u8>(static_cast<u8>(std::clamp<s32>(Y[i] + b_terms[c], -128, 127)) ^ bias);
+        if (output_15bit)
+        {
+          const u16 color15 = static_cast<u16>((R >> 3) | ((G >> 3) << 5) | ((B >> 3) << 10) | bit15);
+          std::memcpy(row_out + (i * 2), &color15, sizeof(color15));
+        }
+        else
+        {
+          row_out[i * 3 + 0] = R;
+          row_out[i * 3 + 1] = G;
+          row_out[i * 3 + 2] = B;
+        }
+      }
+#endif
     }
   }
+
+  m_block_out_size = output_15bit ? (256 / 2) : (256 - (256 / 4));
 }
 
-void MDEC::y_to_mono(const std::array<s16, 64>& Yblk)
+void MDEC::y_to_mono(const StatusRegister& status)
 {
-  for (u32 i = 0; i < 64; i++)
+  const u8 bias = status.data_output_signed ? 0x00 : 0x80;
+  const auto ToOutputByte = [bias](s16 Y) {
+    return static_cast<u8>(static_cast<u8>(std::clamp<s16>(SignExtendN<10, s16>(Y), -128, 127)) ^ bias);
+  };
+
+  const s16* Yblk = m_blocks[0].data();
+  if (status.data_output_depth == DataOutputDepth_4Bit)
   {
-    s16 Y = Yblk[i];
-    Y = SignExtendN<10, s16>(Y);
-    Y = std::clamp<s16>(Y, -128, 127);
-    Y += 128;
-    m_block_rgb[i] = static_cast<u32>(Y) & 0xFF;
+    for (u32 i = 0; i < (64 / 8); i++)
+    {
+      u32 value = 0;
+      for (u32 j = 0; j < 8; j++)
+        value |= ZeroExtend32(ToOutputByte(*(Yblk++)) >> 4) << (j * 4);
+      m_block_out[i] = value;
+    }
+
+    m_block_out_size = 64 / 8;
+  }
+  else
+  {
+    for (u32 i = 0; i < (64 / 4); i++)
+    {
+      u32 value = 0;
+      for (u32 j = 0; j < 4; j++)
+        value |= ZeroExtend32(ToOutputByte(*(Yblk++))) << (j * 8);
+      m_block_out[i] = value;
+    }
+
+    m_block_out_size = 64 / 4;
   }
 }
 
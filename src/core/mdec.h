@@ -3,7 +3,12 @@
 #include "common/fifo_queue.h"
 #include "types.h"
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 class StateWrapper;
 
@@ -20,6 +25,7 @@ public:
   void Initialize(System* system, DMA* dma);
   void Reset();
   bool DoState(StateWrapper& sw);
+  void UpdateSettings();
 
   // I/O
   u32 ReadRegister(u32 offset);
@@ -30,12 +36,33 @@ public:
 
   void DrawDebugStateWindow();
 
+  /// Runs the IDCT on a block of coefficients in place, with the given 8x8 scale table.
+  static void IDCT(const s16* scale_table, s16* blk);
+
+  /// Direct implementation of IDCT(), used on hosts without SIMD support. The vectorised versions must match it
+  /// exactly.
+  static void IDCTReference(const s16* scale_table, s16* blk);
+
+  struct IDCTImplementation
+  {
+    const char* name;
+    void (*function)(const s16* scale_table, s16* blk);
+  };
+
+  /// Returns each of the vectorised IDCTs which the host can run, whether or not IDCT() picks it, so that they can all be
+  /// checked against IDCTReference().
+  static std::vector<IDCTImplementation> GetSupportedIDCTImplementations();
+
 private:
   static constexpr u32 DATA_IN_FIFO_SIZE = 256 * 4;
   static constexpr u32 DATA_OUT_FIFO_SIZE = 192 * 4;
   static constexpr u32 NUM_BLOCKS = 6;
   static constexpr TickCount TICKS_PER_BLOCK = 256;
 
+  // Number of times the decode thread yields while waiting for the next macroblock, and the emulation thread yields
+  // while waiting for a macroblock to be converted, before they go to sleep.
+  static constexpr u32 DECODE_THREAD_SPIN_COUNT = 1000;
+
   enum DataOutputDepth : u8
   {
     DataOutputDepth_4Bit = 0,
@@ -107,12 +134,22 @@ private:
   void ScheduleBlockCopyOut(TickCount ticks);
   void CopyOutBlock();
 
+  /// Runs the IDCT and output conversion for the macroblock which was just decoded. The result is only needed by
+  /// CopyOutBlock(), so when the decode thread is enabled this runs there while the CPU continues.
+  void ConvertDecodedMacroblock();
+  void ConvertMacroblock(u32 status_bits);
+
+  void StartDecodeThread();
+  void StopDecodeThread();
+  void WaitForDecodeThread();
+  void DecodeThreadEntryPoint();
+
   // from nocash spec
   bool rl_decode_block(s16* blk, const u8* qt);
-  void IDCT(s16* blk);
-  void yuv_to_rgb(u32 xx, u32 yy, const std::array<s16, 64>& Crblk, const std::array<s16, 64>& Cbblk,
-                  const std::array<s16, 64>& Yblk);
-  void y_to_mono(const std::array<s16, 64>& Yblk);
+
+  /// Convert the decoded blocks to the output depth in status, packing the result into m_block_out.
+  void yuv_to_rgb(const StatusRegister& status);
+  void y_to_mono(const StatusRegister& status);
 
   System* m_system = nullptr;
   DMA* m_dma = nullptr;
@@ -138,8 +175,19 @@ private:
   u32 m_current_coefficient = 64; // k (in block)
   u16 m_current_q_scale = 0;
 
-  std::array<u32, 256> m_block_rgb{};
+  // output words for the last decoded macroblock, released to the FIFO by the copy out event
+  std::array<u32, 192> m_block_out{};
+  u32 m_block_out_size = 0;
   std::unique_ptr<TimingEvent> m_block_copy_out_event;
 
+  // While a job is pending, the decode thread owns m_blocks and m_block_out.
+  std::thread m_decode_thread;
+  std::mutex m_decode_mutex;
+  std::condition_variable m_decode_cv;
+  std::condition_variable m_decode_done_cv;
+  std::atomic_bool m_decode_job_pending{false};
+  u32 m_decode_job_status_bits = 0;
+  bool m_decode_thread_shutdown = false;
+
   u32 m_total_blocks_decoded = 0;
 };
@@ -5,6 +5,7 @@
 #include "common/state_wrapper.h"
 #include "host_interface.h"
 #include "system.h"
+#include <algorithm>
 #include <cstdio>
 Log_SetChannel(MemoryCard);
 
@@ -13,7 +14,20 @@ MemoryCard::MemoryCard(System* system) : m_system(system)
   m_FLAG.no_write_yet = true;
 }
 
-MemoryCard::~MemoryCard() = default;
+MemoryCard::~MemoryCard()
+{
+  if (!m_save_thread.joinable())
+    return;
+
+  // the worker saves anything outstanding before it exits
+  {
+    std::unique_lock<std::mutex> lock(m_save_mutex);
+    m_save_thread_shutdown = true;
+    m_save_cv.notify_all();
+  }
+
+  m_save_thread.join();
+}
 
 void MemoryCard::Reset()
 {
@@ -22,6 +36,9 @@ void MemoryCard::Reset()
 
 bool MemoryCard::DoState(StateWrapper& sw)
 {
+  // make sure the file is up to date before the card contents change underneath it
+  Flush();
+
   sw.Do(&m_state);
   sw.Do(&m_address);
   sw.Do(&m_sector_offset);
@@ -30,6 +47,13 @@ bool MemoryCard::DoState(StateWrapper& sw)
   sw.Do(&m_data);
   sw.Do(&m_changed);
 
+  if (sw.IsReading())
+  {
+    // the next save has to write the whole card from the state, not just the sectors which change
+    std::unique_lock<std::mutex> lock(m_save_mutex);
+    m_save_data_valid = false;
+  }
+
   return !sw.HasError();
 }
 
@@ -157,7 +181,7 @@ bool MemoryCard::Transfer(const u8 data_in, u8* data_out)
         if (m_changed)
         {
           m_changed = false;
-          SaveToFile();
+          QueueSave(ZeroExtend32(m_address));
         }
       }
     }
@@ -342,11 +366,9 @@ bool MemoryCard::LoadFromFile()
   return true;
 }
 
-bool MemoryCard::SaveToFile()
+bool MemoryCard::SaveToFile(const u8* data, u32 changed_sectors)
 {
-  if (m_filename.empty())
-    return false;
-
+  // atomic update writes to a temporary file and renames it over the card, so a crash can't leave it half-written
   std::unique_ptr<ByteStream> stream =
     FileSystem::OpenFile(m_filename.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_WRITE |
                                                BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_STREAMED);
@@ -356,14 +378,93 @@ bool MemoryCard::SaveToFile()
     return false;
   }
 
-  if (!stream->Write2(m_data.data(), SECTOR_SIZE * NUM_SECTORS) || !stream->Commit())
+  if (!stream->Write2(data, SECTOR_SIZE * NUM_SECTORS) || !stream->Commit())
   {
     Log_ErrorPrintf("Failed to write sectors to '%s'", m_filename.c_str());
     stream->Discard();
     return false;
   }
 
-  Log_InfoPrintf("Saved memory card to '%s'", m_filename.c_str());
+  Log_InfoPrintf("Saved memory card to '%s' (%u sectors changed)", m_filename.c_str(), changed_sectors);
   m_system->GetHostInterface()->AddOSDMessage(SmallString::FromFormat("Saved memory card to '%s'", m_filename.c_str()));
   return true;
 }
+
+void MemoryCard::QueueSave(u32 sector)
+{
+  if (m_filename.empty())
+    return;
+
+  std::unique_lock<std::mutex> lock(m_save_mutex);
+  if (m_save_data_valid)
+  {
+    std::copy_n(GetSectorPtr(sector), SECTOR_SIZE, &m_save_data[sector * SECTOR_SIZE]);
+  }
+  else
+  {
+    m_save_data = m_data;
+    m_save_data_valid = true;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (m_dirty_sectors.none())
+    m_first_write_time = now;
+  m_last_write_time = now;
+  m_dirty_sectors.set(sector);
+
+  if (!m_save_thread.joinable())
+    m_save_thread = std::thread(&MemoryCard::SaveThreadEntryPoint, this);
+  else
+    m_save_cv.notify_all();
+}
+
+void MemoryCard::Flush()
+{
+  std::unique_lock<std::mutex> lock(m_save_mutex);
+  if (m_dirty_sectors.none() && !m_saving)
+    return;
+
+  m_save_now = true;
+  m_save_cv.notify_all();
+  m_save_cv.wait(lock, [this]() { return m_dirty_sectors.none() && !m_saving; });
+  m_save_now = false;
+}
+
+void MemoryCard::SaveThreadEntryPoint()
+{
+  std::unique_ptr<std::array<u8, DATA_SIZE>> data = std::make_unique<std::array<u8, DATA_SIZE>>();
+
+  std::unique_lock<std::mutex> lock(m_save_mutex);
+  for (;;)
+  {
+    if (m_dirty_sectors.none())
+    {
+      if (m_save_thread_shutdown)
+        break;
+
+      m_save_cv.wait(lock);
+      continue;
+    }
+
+    // games usually write several sectors for one save, so wait for them to finish before writing
+    const auto save_time = std::min(m_last_write_time + SAVE_DELAY, m_first_write_time + MAX_SAVE_DELAY);
+    if (!m_save_now && !m_save_thread_shutdown && std::chrono::steady_clock::now() < save_time)
+    {
+      m_save_cv.wait_until(lock, save_time);
+      continue;
+    }
+
+    const u32 changed_sectors = static_cast<u32>(m_dirty_sectors.count());
+    *data = m_save_data;
+    m_dirty_sectors.reset();
+    m_save_now = false;
+    m_saving = true;
+    lock.unlock();
+
+    SaveToFile(data->data(), changed_sectors);
+
+    lock.lock();
+    m_saving = false;
+    m_save_cv.notify_all();
+  }
+}
@@ -2,9 +2,14 @@
 #include "common/bitfield.h"
 #include "controller.h"
 #include <array>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 
 class System;
 
@@ -32,7 +37,14 @@ public:
 
   void Format();
 
+  /// Writes out any changes which haven't been saved yet, waiting for them to reach the disk.
+  void Flush();
+
 private:
+  // Writes are saved once the game stops writing for SAVE_DELAY_MS, or MAX_SAVE_DELAY_MS after the first change.
+  static constexpr std::chrono::milliseconds SAVE_DELAY{1000};
+  static constexpr std::chrono::milliseconds MAX_SAVE_DELAY{5000};
+
   union FLAG
   {
     u8 bits;
@@ -76,7 +88,10 @@ private:
   u8* GetSectorPtr(u32 sector);
 
   bool LoadFromFile();
-  bool SaveToFile();
+  bool SaveToFile(const u8* data, u32 changed_sectors);
+
+  void QueueSave(u32 sector);
+  void SaveThreadEntryPoint();
 
   System* m_system;
 
@@ -90,4 +105,18 @@ private:
   std::array<u8, DATA_SIZE> m_data{};
 
   std::string m_filename;
+
+  // Saving happens on a worker thread, so the emulation thread never waits for the disk. Changed sectors are copied
+  // to m_save_data as they're written, and the worker writes out the whole card.
+  std::thread m_save_thread;
+  std::mutex m_save_mutex;
+  std::condition_variable m_save_cv;
+  std::array<u8, DATA_SIZE> m_save_data{};
+  std::bitset<NUM_SECTORS> m_dirty_sectors;
+  std::chrono::steady_clock::time_point m_first_write_time;
+  std::chrono::steady_clock::time_point m_last_write_time;
+  bool m_save_data_valid = false;
+  bool m_save_now = false;
+  bool m_saving = false;
+  bool m_save_thread_shutdown = false;
 };
@@ -0,0 +1,73 @@
+#include "null_host_display.h"
+
+NullHostDisplayTexture::NullHostDisplayTexture(u32 width, u32 height) : m_width(width), m_height(height) {}
+
+NullHostDisplayTexture::~NullHostDisplayTexture() = default;
+
+void* NullHostDisplayTexture::GetHandle() const
+{
+  return nullptr;
+}
+
+u32 NullHostDisplayTexture::GetWidth() const
+{
+  return m_width;
+}
+
+u32 NullHostDisplayTexture::GetHeight() const
+{
+  return m_height;
+}
+
+NullHostDisplay::NullHostDisplay() = default;
+
+NullHostDisplay::~NullHostDisplay() = default;
+
+HostDisplay::RenderAPI NullHostDisplay::GetRenderAPI() const
+{
+  return RenderAPI::None;
+}
+
+void* NullHostDisplay::GetRenderDevice() const
+{
+  return nullptr;
+}
+
+void* NullHostDisplay::GetRenderContext() const
+{
+  return nullptr;
+}
+
+void* NullHostDisplay::GetRenderWindow() const
+{
+  return nullptr;
+}
+
+void NullHostDisplay::ChangeRenderWindow(void* new_window) {}
+
+std::unique_ptr<HostDisplayTexture> NullHostDisplay::CreateTexture(u32 width, u32 height, const void* data,
+                                                                   u32 data_stride, bool dynamic)
+{
+  return std::make_unique<NullHostDisplayTexture>(width, height);
+}
+
+void NullHostDisplay::UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y, u32 width, u32 height,
+                                    const void* data, u32 data_stride)
+{
+}
+
+void NullHostDisplay::Render() {}
+
+void NullHostDisplay::SetVSync(bool enabled) {}
+
+std::tuple<u32, u32> NullHostDisplay::GetWindowSize() const
+{
+  return std::make_tuple(0u, 0u);
+}
+
+void NullHostDisplay::WindowResized() {}
+
+std::unique_ptr<HostDisplay> HostDisplay::CreateNullDisplay()
+{
+  return std::make_unique<NullHostDisplay>();
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "host_display.h"
+
+class NullHostDisplayTexture final : public HostDisplayTexture
+{
+public:
+  NullHostDisplayTexture(u32 width, u32 height);
+  ~NullHostDisplayTexture() override;
+
+  void* GetHandle() const override;
+  u32 GetWidth() const override;
+  u32 GetHeight() const override;
+
+private:
+  u32 m_width;
+  u32 m_height;
+};
+
+// Display which discards everything, for running the system without a frontend.
+class NullHostDisplay final : public HostDisplay
+{
+public:
+  NullHostDisplay();
+  ~NullHostDisplay() override;
+
+  RenderAPI GetRenderAPI() const override;
+  void* GetRenderDevice() const override;
+  void* GetRenderContext() const override;
+  void* GetRenderWindow() const override;
+
+  void ChangeRenderWindow(void* new_window) override;
+
+  std::unique_ptr<HostDisplayTexture> CreateTexture(u32 width, u32 height, const void* data, u32 data_stride,
+                                                    bool dynamic) override;
+  void UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y, u32 width, u32 height, const void* data,
+                     u32 data_stride) override;
+
+  void Render() override;
+
+  void SetVSync(bool enabled) override;
+
+  std::tuple<u32, u32> GetWindowSize() const override;
+  void WindowResized() override;
+};
@@ -31,6 +31,14 @@ void Settings::Load(SettingsInterface& si)
     ParseAudioBackend(si.GetStringValue("Audio", "Backend", "Default").c_str()).value_or(AudioBackend::Default);
   audio_sync_enabled = si.GetBoolValue("Audio", "Sync", true);
 
+  cdrom_read_thread = si.GetBoolValue("CDROM", "ReadThread", false);
+  cdrom_load_image_to_ram = si.GetBoolValue("CDROM", "LoadImageToRAM", false);
+  cdrom_load_image_compressed = si.GetBoolValue("CDROM", "LoadImageCompressed", true);
+  cdrom_chd_cache_hunks = static_cast<u32>(si.GetIntValue("CDROM", "CHDCacheHunks", 16));
+  cdrom_chd_decompression_threads = static_cast<u32>(si.GetIntValue("CDROM", "CHDDecompressionThreads", 1));
+
+  mdec_use_thread = si.GetBoolValue("MDEC", "UseThread", false);
+
   bios_path = si.GetStringValue("BIOS", "Path", "scph1001.bin");
   bios_patch_tty_enable = si.GetBoolValue("BIOS", "PatchTTYEnable", true);
   bios_patch_fast_boot = si.GetBoolValue("BIOS", "PatchFastBoot", false);
@@ -67,6 +75,14 @@ void Settings::Save(SettingsInterface& si) const
   si.SetStringValue("Audio", "Backend", GetAudioBackendName(audio_backend));
   si.SetBoolValue("Audio", "Sync", audio_sync_enabled);
 
+  si.SetBoolValue("CDROM", "ReadThread", cdrom_read_thread);
+  si.SetBoolValue("CDROM", "LoadImageToRAM", cdrom_load_image_to_ram);
+  si.SetBoolValue("CDROM", "LoadImageCompressed", cdrom_load_image_compressed);
+  si.SetIntValue("CDROM", "CHDCacheHunks", static_cast<long>(cdrom_chd_cache_hunks));
+  si.SetIntValue("CDROM", "CHDDecompressionThreads", static_cast<long>(cdrom_chd_decompression_threads));
+
+  si.SetBoolValue("MDEC", "UseThread", mdec_use_thread);
+
   si.SetStringValue("BIOS", "Path", bios_path.c_str());
   si.SetBoolValue("BIOS", "PatchTTYEnable", bios_patch_tty_enable);
   si.SetBoolValue("BIOS", "PatchFastBoot", bios_patch_fast_boot);
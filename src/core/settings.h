@@ -52,6 +52,14 @@ struct Settings
   AudioBackend audio_backend = AudioBackend::Default;
   bool audio_sync_enabled = true;
 
+  bool cdrom_read_thread = false;
+  bool cdrom_load_image_to_ram = false;
+  bool cdrom_load_image_compressed = true;
+  u32 cdrom_chd_cache_hunks = 16;
+  u32 cdrom_chd_decompression_threads = 1;
+
+  bool mdec_use_thread = false;
+
   struct DebugSettings
   {
     bool show_vram = false;
@@ -1,20 +1,124 @@
 #include "spu.h"
 #include "common/audio_stream.h"
+#include "common/cpu_detect.h"
 #include "common/log.h"
 #include "common/state_wrapper.h"
+#include "common/timer.h"
 #include "dma.h"
 #include "host_interface.h"
 #include "interrupt_controller.h"
 #include "system.h"
+#include <cinttypes>
 #include <imgui.h>
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#elif defined(CPU_AARCH64)
+#include <arm_neon.h>
+#endif
 Log_SetChannel(SPU);
 
 // TODO:
-//   - Reverb
 //   - Noise
 //   - Volume Sweep
 //   - Pulse Modulation
 
+static constexpr std::array<s32, 0x200> s_gauss_table = {{
+  -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
+  -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, //
+  0x0001, 0x0001, 0x0001, 0x0002, 0x0002, 0x0002, 0x0003, 0x0003, //
+  0x0003, 0x0004, 0x0004, 0x0005, 0x0005, 0x0006, 0x0007, 0x0007, //
+  0x0008, 0x0009, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, //
+  0x000F, 0x0010, 0x0011, 0x0012, 0x0013, 0x0015, 0x0016, 0x0018, // entry
+  0x0019, 0x001B, 0x001C, 0x001E, 0x0020, 0x0021, 0x0023, 0x0025, // 000..07F
+  0x0027, 0x0029, 0x002C, 0x002E, 0x0030, 0x0033, 0x0035, 0x0038, //
+  0x003A, 0x003D, 0x0040, 0x0043, 0x0046, 0x0049, 0x004D, 0x0050, //
+  0x0054, 0x0057, 0x005B, 0x005F, 0x0063, 0x0067, 0x006B, 0x006F, //
+  0x0074, 0x0078, 0x007D, 0x0082, 0x0087, 0x008C, 0x0091, 0x0096, //
+  0x009C, 0x00A1, 0x00A7, 0x00AD, 0x00B3, 0x00BA, 0x00C0, 0x00C7, //
+  0x00CD, 0x00D4, 0x00DB, 0x00E3, 0x00EA, 0x00F2, 0x00FA, 0x0101, //
+  0x010A, 0x0112, 0x011B, 0x0123, 0x012C, 0x0135, 0x013F, 0x0148, //
+  0x0152, 0x015C, 0x0166, 0x0171, 0x017B, 0x0186, 0x0191, 0x019C, //
+  0x01A8, 0x01B4, 0x01C0, 0x01CC, 0x01D9, 0x01E5, 0x01F2, 0x0200, //
+  0x020D, 0x021B, 0x0229, 0x0237, 0x0246, 0x0255, 0x0264, 0x0273, //
+  0x0283, 0x0293, 0x02A3, 0x02B4, 0x02C4, 0x02D6, 0x02E7, 0x02F9, //
+  0x030B, 0x031D, 0x0330, 0x0343, 0x0356, 0x036A, 0x037E, 0x0392, //
+  0x03A7, 0x03BC, 0x03D1, 0x03E7, 0x03FC, 0x0413, 0x042A, 0x0441, //
+  0x0458, 0x0470, 0x0488, 0x04A0, 0x04B9, 0x04D2, 0x04EC, 0x0506, //
+  0x0520, 0x053B, 0x0556, 0x0572, 0x058E, 0x05AA, 0x05C7, 0x05E4, // entry
+  0x0601, 0x061F, 0x063E, 0x065C, 0x067C, 0x069B, 0x06BB, 0x06DC, // 080..0FF
+  0x06FD, 0x071E, 0x0740, 0x0762, 0x0784, 0x07A7, 0x07CB, 0x07EF, //
+  0x0813, 0x0838, 0x085D, 0x0883, 0x08A9, 0x08D0, 0x08F7, 0x091E, //
+  0x0946, 0x096F, 0x0998, 0x09C1, 0x09EB, 0x0A16, 0x0A40, 0x0A6C, //
+  0x0A98, 0x0AC4, 0x0AF1, 0x0B1E, 0x0B4C, 0x0B7A, 0x0BA9, 0x0BD8, //
+  0x0C07, 0x0C38, 0x0C68, 0x0C99, 0x0CCB, 0x0CFD, 0x0D30, 0x0D63, //
+  0x0D97, 0x0DCB, 0x0E00, 0x0E35, 0x0E6B, 0x0EA1, 0x0ED7, 0x0F0F, //
+  0x0F46, 0x0F7F, 0x0FB7, 0x0FF1, 0x102A, 0x1065, 0x109F, 0x10DB, //
+  0x1116, 0x1153, 0x118F, 0x11CD, 0x120B, 0x1249, 0x1288, 0x12C7, //
+  0x1307, 0x1347, 0x1388, 0x13C9, 0x140B, 0x144D, 0x1490, 0x14D4, //
+  0x1517, 0x155C, 0x15A0, 0x15E6, 0x162C, 0x1672, 0x16B9, 0x1700, //
+  0x1747, 0x1790, 0x17D8, 0x1821, 0x186B, 0x18B5, 0x1900, 0x194B, //
+  0x1996, 0x19E2, 0x1A2E, 0x1A7B, 0x1AC8, 0x1B16, 0x1B64, 0x1BB3, //
+  0x1C02, 0x1C51, 0x1CA1, 0x1CF1, 0x1D42, 0x1D93, 0x1DE5, 0x1E37, //
+  0x1E89, 0x1EDC, 0x1F2F, 0x1F82, 0x1FD6, 0x202A, 0x207F, 0x20D4, //
+  0x2129, 0x217F, 0x21D5, 0x222C, 0x2282, 0x22DA, 0x2331, 0x2389, // entry
+  0x23E1, 0x2439, 0x2492, 0x24EB, 0x2545, 0x259E, 0x25F8, 0x2653, // 100..17F
+  0x26AD, 0x2708, 0x2763, 0x27BE, 0x281A, 0x2876, 0x28D2, 0x292E, //
+  0x298B, 0x29E7, 0x2A44, 0x2AA1, 0x2AFF, 0x2B5C, 0x2BBA, 0x2C18, //
+  0x2C76, 0x2CD4, 0x2D33, 0x2D91, 0x2DF0, 0x2E4F, 0x2EAE, 0x2F0D, //
+  0x2F6C, 0x2FCC, 0x302B, 0x308B, 0x30EA, 0x314A, 0x31AA, 0x3209, //
+  0x3269, 0x32C9, 0x3329, 0x3389, 0x33E9, 0x3449, 0x34A9, 0x3509, //
+  0x3569, 0x35C9, 0x3629, 0x3689, 0x36E8, 0x3748, 0x37A8, 0x3807, //
+  0x3867, 0x38C6, 0x3926, 0x3985, 0x39E4, 0x3A43, 0x3AA2, 0x3B00, //
+  0x3B5F, 0x3BBD, 0x3C1B, 0x3C79, 0x3CD7, 0x3D35, 0x3D92, 0x3DEF, //
+  0x3E4C, 0x3EA9, 0x3F05, 0x3F62, 0x3FBD, 0x4019, 0x4074, 0x40D0, //
+  0x412A, 0x4185, 0x41DF, 0x4239, 0x4292, 0x42EB, 0x4344, 0x439C, //
+  0x43F4, 0x444C, 0x44A3, 0x44FA, 0x4550, 0x45A6, 0x45FC, 0x4651, //
+  0x46A6, 0x46FA, 0x474E, 0x47A1, 0x47F4, 0x4846, 0x4898, 0x48E9, //
+  0x493A, 0x498A, 0x49D9, 0x4A29, 0x4A77, 0x4AC5, 0x4B13, 0x4B5F, //
+  0x4BAC, 0x4BF7, 0x4C42, 0x4C8D, 0x4CD7, 0x4D20, 0x4D68, 0x4DB0, //
+  0x4DF7, 0x4E3E, 0x4E84, 0x4EC9, 0x4F0E, 0x4F52, 0x4F95, 0x4FD7, // entry
+  0x5019, 0x505A, 0x509A, 0x50DA, 0x5118, 0x5156, 0x5194, 0x51D0, // 180..1FF
+  0x520C, 0x5247, 0x5281, 0x52BA, 0x52F3, 0x532A, 0x5361, 0x5397, //
+  0x53CC, 0x5401, 0x5434, 0x5467, 0x5499, 0x54CA, 0x54FA, 0x5529, //
+  0x5558, 0x5585, 0x55B2, 0x55DE, 0x5609, 0x5632, 0x565B, 0x5684, //
+  0x56AB, 0x56D1, 0x56F6, 0x571B, 0x573E, 0x5761, 0x5782, 0x57A3, //
+  0x57C3, 0x57E2, 0x57FF, 0x581C, 0x5838, 0x5853, 0x586D, 0x5886, //
+  0x589E, 0x58B5, 0x58CB, 0x58E0, 0x58F4, 0x5907, 0x5919, 0x592A, //
+  0x593A, 0x5949, 0x5958, 0x5965, 0x5971, 0x597C, 0x5986, 0x598F, //
+  0x5997, 0x599E, 0x59A4, 0x59A9, 0x59AD, 0x59B0, 0x59B2, 0x59B3  //
+}};
+
+// The four gaussian interpolation weights for each interpolation index, in the order of the samples they apply to.
+using GaussTaps = std::array<s16, 4>;
+static constexpr std::array<GaussTaps, 0x100> MakeGaussTapsTable()
+{
+  std::array<GaussTaps, 0x100> table = {};
+  for (u32 i = 0; i < 0x100; i++)
+  {
+    table[i][0] = static_cast<s16>(s_gauss_table[0x0FF - i]);
+    table[i][1] = static_cast<s16>(s_gauss_table[0x1FF - i]);
+    table[i][2] = static_cast<s16>(s_gauss_table[0x100 + i]);
+    table[i][3] = static_cast<s16>(s_gauss_table[0x000 + i]);
+  }
+  return table;
+}
+alignas(8) static constexpr std::array<GaussTaps, 0x100> s_gauss_taps_table = MakeGaussTapsTable();
+
+// Even taps of the 39-tap half-band filter, used for both directions of the 44.1KHz <-> 22.05KHz conversion. The odd
+// taps are all zero other than the centre tap, which is 0x4000.
+alignas(16) static constexpr std::array<s16, 40> s_reverb_downsample_coefficients = {{
+  -0x0001, 0x0000,  0x0002, 0x0000, -0x000A, 0x0000, 0x0023, 0x0000, -0x0067, 0x0000, //
+  0x010A,  0x0000,  -0x0268, 0x0000, 0x0534, 0x0000, -0x0B90, 0x0000, 0x2806, 0x4000, //
+  0x2806,  0x0000,  -0x0B90, 0x0000, 0x0534, 0x0000, -0x0268, 0x0000, 0x010A, 0x0000, //
+  -0x0067, 0x0000,  0x0023,  0x0000, -0x000A, 0x0000, 0x0002, 0x0000, -0x0001, 0x0000 //
+}};
+alignas(16) static constexpr std::array<s16, 24> s_reverb_upsample_coefficients = {{
+  -0x0001, 0x0002, -0x000A, 0x0023, -0x0067, 0x010A, -0x0268, 0x0534, -0x0B90, 0x2806, //
+  0x2806, -0x0B90, 0x0534, -0x0268, 0x010A, -0x0067, 0x0023, -0x000A, 0x0002, -0x0001, //
+  0x0000, 0x0000,  0x0000, 0x0000                                                      //
+}};
+
 SPU::SPU() = default;
 
 SPU::~SPU() = default;
@@ -48,6 +152,18 @@ void SPU::Reset()
   m_pitch_modulation_enable_register = 0;
   m_ticks_carry = 0;
 
+  std::fill_n(m_reverb_registers.rev, NUM_REVERB_REGS, u16(0));
+  m_reverb_output_volume_left = 0;
+  m_reverb_output_volume_right = 0;
+  m_reverb_base_address = 0;
+  m_reverb_current_address = 0;
+  for (u32 i = 0; i < 2; i++)
+  {
+    m_reverb_downsample_history[i].fill(s16(0));
+    m_reverb_upsample_history[i].fill(s16(0));
+  }
+  m_reverb_resample_phase = false;
+
   for (u32 i = 0; i < NUM_VOICES; i++)
   {
     Voice& v = m_voices[i];
@@ -67,6 +183,9 @@ void SPU::Reset()
   }
 
   m_ram.fill(0);
+  InvalidateADPCMCache();
+  m_adpcm_cache_hits = 0;
+  m_adpcm_cache_misses = 0;
   UpdateEventInterval();
 }
 
@@ -89,6 +208,17 @@ bool SPU::DoState(StateWrapper& sw)
   sw.Do(&m_reverb_on_register);
   sw.Do(&m_noise_mode_register);
   sw.Do(&m_ticks_carry);
+  sw.DoArray(m_reverb_registers.rev, NUM_REVERB_REGS);
+  sw.Do(&m_reverb_output_volume_left);
+  sw.Do(&m_reverb_output_volume_right);
+  sw.Do(&m_reverb_base_address);
+  sw.Do(&m_reverb_current_address);
+  for (u32 i = 0; i < 2; i++)
+  {
+    sw.Do(&m_reverb_downsample_history[i]);
+    sw.Do(&m_reverb_upsample_history[i]);
+  }
+  sw.Do(&m_reverb_resample_phase);
   for (u32 i = 0; i < NUM_VOICES; i++)
   {
     Voice& v = m_voices[i];
@@ -109,10 +239,15 @@ bool SPU::DoState(StateWrapper& sw)
   }
 
   sw.DoBytes(m_ram.data(), RAM_SIZE);
+  if (sw.IsReading())
+    InvalidateADPCMCache();
 
   if (sw.IsReading())
   {
     m_system->GetHostInterface()->GetAudioStream()->EmptyBuffers();
+
+    // Don't catch up with ticks from before the state was loaded.
+    m_sample_event->Deactivate();
     UpdateEventInterval();
   }
 
@@ -124,6 +259,9 @@ u16 SPU::ReadRegister(u32 offset)
   if (offset < (0x1F801D80 - SPU_BASE))
     return ReadVoiceRegister(offset);
 
+  if (offset >= (0x1F801DC0 - SPU_BASE) && offset < (0x1F801E00 - SPU_BASE))
+    return m_reverb_registers.rev[(offset - (0x1F801DC0 - SPU_BASE)) / 2];
+
   switch (offset)
   {
     case 0x1F801D80 - SPU_BASE:
@@ -132,6 +270,12 @@ u16 SPU::ReadRegister(u32 offset)
     case 0x1F801D82 - SPU_BASE:
       return m_main_volume_right.bits;
 
+    case 0x1F801D84 - SPU_BASE:
+      return static_cast<u16>(m_reverb_output_volume_left);
+
+    case 0x1F801D86 - SPU_BASE:
+      return static_cast<u16>(m_reverb_output_volume_right);
+
     case 0x1F801D88 - SPU_BASE:
       return Truncate16(m_key_on_register);
 
@@ -162,6 +306,9 @@ u16 SPU::ReadRegister(u32 offset)
     case 0x1F801D9A - SPU_BASE:
       return Truncate16(m_reverb_on_register >> 16);
 
+    case 0x1F801DA2 - SPU_BASE:
+      return m_reverb_base_address;
+
     case 0x1F801DA4 - SPU_BASE:
       Log_DebugPrintf("SPU IRQ address -> 0x%04X", ZeroExtend32(m_irq_address));
       return m_irq_address;
@@ -207,6 +354,15 @@ void SPU::WriteRegister(u32 offset, u16 value)
     return;
   }
 
+  if (offset >= (0x1F801DC0 - SPU_BASE) && offset < (0x1F801E00 - SPU_BASE))
+  {
+    const u32 reg = (offset - (0x1F801DC0 - SPU_BASE)) / 2;
+    Log_DebugPrintf("SPU reverb register %u <- 0x%04X", reg, ZeroExtend32(value));
+    m_sample_event->InvokeEarly();
+    m_reverb_registers.rev[reg] = value;
+    return;
+  }
+
   switch (offset)
   {
     case 0x1F801D80 - SPU_BASE:
@@ -225,6 +381,22 @@ void SPU::WriteRegister(u32 offset, u16 value)
       return;
     }
 
+    case 0x1F801D84 - SPU_BASE:
+    {
+      Log_DebugPrintf("SPU reverb output volume left <- 0x%04X", ZeroExtend32(value));
+      m_sample_event->InvokeEarly();
+      m_reverb_output_volume_left = static_cast<s16>(value);
+      return;
+    }
+
+    case 0x1F801D86 - SPU_BASE:
+    {
+      Log_DebugPrintf("SPU reverb output volume right <- 0x%04X", ZeroExtend32(value));
+      m_sample_event->InvokeEarly();
+      m_reverb_output_volume_right = static_cast<s16>(value);
+      return;
+    }
+
     case 0x1F801D88 - SPU_BASE:
     {
       Log_DebugPrintf("SPU key on low <- 0x%04X", ZeroExtend32(value));
@@ -241,6 +413,8 @@ void SPU::WriteRegister(u32 offset, u16 value)
         }
         bits >>= 1;
       }
+
+      InvalidateIRQPrediction();
     }
     break;
 
@@ -260,6 +434,8 @@ void SPU::WriteRegister(u32 offset, u16 value)
         }
         bits >>= 1;
       }
+
+      InvalidateIRQPrediction();
     }
     break;
 
@@ -306,6 +482,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
       m_sample_event->InvokeEarly();
       m_pitch_modulation_enable_register = (m_pitch_modulation_enable_register & 0xFFFF0000) | ZeroExtend32(value);
       Log_DebugPrintf("SPU pitch modulation enable register <- 0x%08X", m_pitch_modulation_enable_register);
+      InvalidateIRQPrediction();
     }
     break;
 
@@ -315,6 +492,7 @@ void SPU::WriteRegister(u32 offset, u16 value)
       m_pitch_modulation_enable_register =
         (m_pitch_modulation_enable_register & 0x0000FFFF) | (ZeroExtend32(value) << 16);
       Log_DebugPrintf("SPU pitch modulation enable register <- 0x%08X", m_pitch_modulation_enable_register);
+      InvalidateIRQPrediction();
     }
     break;
 
@@ -350,11 +528,21 @@ void SPU::WriteRegister(u32 offset, u16 value)
     }
     break;
 
+    case 0x1F801DA2 - SPU_BASE:
+    {
+      Log_DebugPrintf("SPU reverb base address <- 0x%04X", ZeroExtend32(value));
+      m_sample_event->InvokeEarly();
+      m_reverb_base_address = value;
+      m_reverb_current_address = ZeroExtend32(value) << 3;
+      return;
+    }
+
     case 0x1F801DA4 - SPU_BASE:
     {
       Log_DebugPrintf("SPU IRQ address register <- 0x%04X", ZeroExtend32(value));
       m_sample_event->InvokeEarly();
       m_irq_address = value;
+      InvalidateIRQPrediction();
       return;
     }
 
@@ -370,7 +558,9 @@ void SPU::WriteRegister(u32 offset, u16 value)
     {
       Log_TracePrintf("SPU transfer data register <- 0x%04X (RAM offset 0x%08X)", ZeroExtend32(value),
                       m_transfer_address);
+      m_sample_event->InvokeEarly();
       RAMTransferWrite(value);
+      InvalidateIRQPrediction();
       return;
     }
 
@@ -475,6 +665,8 @@ void SPU::WriteVoiceRegister(u32 offset, u16 value)
     {
       Log_DebugPrintf("SPU voice %u ADPCM sample rate <- 0x%04X", voice_index, value);
       voice.regs.adpcm_sample_rate = value;
+      if (voice.IsOn())
+        InvalidateIRQPrediction();
     }
     break;
 
@@ -510,6 +702,8 @@ void SPU::WriteVoiceRegister(u32 offset, u16 value)
     {
       Log_DebugPrintf("SPU voice %u ADPCM repeat address <- 0x%04X", voice_index, value);
       voice.regs.adpcm_repeat_address = value;
+      if (voice.IsOn())
+        InvalidateIRQPrediction();
     }
     break;
 
@@ -524,6 +718,9 @@ void SPU::WriteVoiceRegister(u32 offset, u16 value)
 
 void SPU::DMARead(u32* words, u32 word_count)
 {
+  // The capture buffers have to be up to date.
+  m_sample_event->InvokeEarly();
+
   // test for wrap-around
   if ((m_transfer_address & ~RAM_MASK) != ((m_transfer_address + (word_count * sizeof(u32))) & ~RAM_MASK))
   {
@@ -544,6 +741,9 @@ void SPU::DMARead(u32* words, u32 word_count)
 
 void SPU::DMAWrite(const u32* words, u32 word_count)
 {
+  // Voices have to finish reading the old data first.
+  m_sample_event->InvokeEarly();
+
   // test for wrap-around
   if ((m_transfer_address & ~RAM_MASK) != ((m_transfer_address + (word_count * sizeof(u32))) & ~RAM_MASK))
   {
@@ -559,8 +759,12 @@ void SPU::DMAWrite(const u32* words, u32 word_count)
   {
     DebugAssert(m_transfer_control.mode == 2);
     std::memcpy(&m_ram[m_transfer_address], words, sizeof(u32) * word_count);
+    MarkRAMDirty(m_transfer_address, sizeof(u32) * word_count);
     m_transfer_address = (m_transfer_address + (sizeof(u32) * word_count)) & RAM_MASK;
   }
+
+  // The loop flags of blocks the voices are going to play may have changed.
+  InvalidateIRQPrediction();
 }
 
 void SPU::UpdateDMARequest()
@@ -589,6 +793,7 @@ void SPU::RAMTransferWrite(u16 value)
   DebugAssert(m_transfer_control.mode == 2);
 
   std::memcpy(&m_ram[m_transfer_address], &value, sizeof(value));
+  MarkRAMDirty(m_transfer_address, sizeof(value));
   m_transfer_address = (m_transfer_address + sizeof(value)) & RAM_MASK;
   CheckRAMIRQ(m_transfer_address);
 }
@@ -611,6 +816,7 @@ void SPU::WriteToCaptureBuffer(u32 index, s16 value)
   const u32 ram_address = (index * CAPTURE_BUFFER_SIZE_PER_CHANNEL) | ZeroExtend16(m_capture_buffer_position);
   // Log_DebugPrintf("write to capture buffer %u (0x%08X) <- 0x%04X", index, ram_address, u16(value));
   std::memcpy(&m_ram[ram_address], &value, sizeof(value));
+  MarkRAMDirty(ram_address, sizeof(value));
   CheckRAMIRQ(ram_address);
 }
 
@@ -621,75 +827,396 @@ void SPU::IncrementCaptureBufferPosition()
   m_SPUSTAT.second_half_capture_buffer = m_capture_buffer_position >= (CAPTURE_BUFFER_SIZE_PER_CHANNEL / 2);
 }
 
-void SPU::Execute(TickCount ticks)
+bool SPU::CanMixVoicesInBlocks() const
 {
-  DebugAssert(m_SPUCNT.enable || m_SPUCNT.cd_audio_enable);
+  // Voices playing from the capture buffers have to see the samples written by earlier frames.
+  static constexpr u16 capture_buffer_end = (CAPTURE_BUFFER_SIZE_PER_CHANNEL * 4) >> VOICE_ADDRESS_SHIFT;
+  for (const Voice& voice : m_voices)
+  {
+    if (voice.IsOn() &&
+        (voice.current_address < capture_buffer_end || voice.regs.adpcm_repeat_address < capture_buffer_end))
+    {
+      return false;
+    }
+  }
 
-  u32 remaining_frames = static_cast<u32>((ticks + m_ticks_carry) / SYSCLK_TICKS_PER_SPU_TICK);
-  m_ticks_carry = (ticks + m_ticks_carry) % SYSCLK_TICKS_PER_SPU_TICK;
+  return true;
+}
 
-  while (remaining_frames > 0)
+u32 SPU::ReverbMemoryAddress(u32 address, s32 byte_offset) const
+{
+  // Accesses wrap around within the work area, which extends from the base address to the end of RAM.
+  const u32 base = ZeroExtend32(m_reverb_base_address) << 3;
+  const s32 size = static_cast<s32>(RAM_SIZE - base);
+  s32 offset = static_cast<s32>(m_reverb_current_address) - static_cast<s32>(base) + static_cast<s32>(address << 3) +
+               byte_offset;
+  offset %= size;
+  if (offset < 0)
+    offset += size;
+
+  return (base + static_cast<u32>(offset)) & (RAM_MASK & ~u32(1));
+}
+
+s16 SPU::ReverbRead(u16 address, s32 byte_offset /* = 0 */) const
+{
+  s16 value;
+  std::memcpy(&value, &m_ram[ReverbMemoryAddress(address, byte_offset)], sizeof(value));
+  return value;
+}
+
+void SPU::ReverbWrite(u16 address, s32 value)
+{
+  if (!m_SPUCNT.reverb_master_enable)
+    return;
+
+  const s16 clamped_value = Clamp16(value);
+  const u32 ram_address = ReverbMemoryAddress(address, 0);
+  std::memcpy(&m_ram[ram_address], &clamped_value, sizeof(clamped_value));
+  MarkRAMDirty(ram_address, sizeof(clamped_value));
+}
+
+s32 SPU::ReverbFIR(const s16* samples, const s16* coefficients, u32 num_padded_taps)
+{
+  DebugAssert((num_padded_taps % 8) == 0);
+
+#if defined(CPU_X64)
+  __m128i sum = _mm_setzero_si128();
+  for (u32 i = 0; i < num_padded_taps; i += 8)
   {
-    AudioStream* const output_stream = m_system->GetHostInterface()->GetAudioStream();
-    s16* output_frame;
-    u32 output_frame_space;
-    output_stream->BeginWrite(&output_frame, &output_frame_space);
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&samples[i])),
+                                            _mm_load_si128(reinterpret_cast<const __m128i*>(&coefficients[i]))));
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+#elif defined(CPU_AARCH64)
+  int32x4_t sum = vdupq_n_s32(0);
+  for (u32 i = 0; i < num_padded_taps; i += 8)
+  {
+    const int16x8_t s = vld1q_s16(&samples[i]);
+    const int16x8_t c = vld1q_s16(&coefficients[i]);
+    sum = vmlal_s16(sum, vget_low_s16(s), vget_low_s16(c));
+    sum = vmlal_high_s16(sum, s, c);
+  }
+  return vaddvq_s32(sum);
+#else
+  s32 sum = 0;
+  for (u32 i = 0; i < num_padded_taps; i++)
+    sum += s32(samples[i]) * s32(coefficients[i]);
+  return sum;
+#endif
+}
 
-    const u32 frames_in_this_batch = std::min(remaining_frames, output_frame_space);
-    for (u32 i = 0; i < frames_in_this_batch; i++)
+void SPU::ReverbStep(const s32 input[2], s32 output[2])
+{
+  const ReverbRegisters& rr = m_reverb_registers;
+  const s32 vIIR = rr.reflection_volume1;
+  const s32 vWALL = rr.reflection_volume2;
+
+  s32 in[2];
+  for (u32 lr = 0; lr < 2; lr++)
+    in[lr] = ApplyVolume(input[lr], rr.input_volume[lr]);
+
+  const auto Reflect = [this, vIIR, vWALL](u16 dst_address, u16 src_address, s32 value) {
+    const s32 previous = ReverbRead(dst_address, -2);
+    const s32 reflected = Clamp16(value + ((s32(ReverbRead(src_address)) * vWALL) >> 15) - previous);
+    ReverbWrite(dst_address, ((reflected * vIIR) >> 15) + previous);
+  };
+  for (u32 lr = 0; lr < 2; lr++)
+  {
+    Reflect(rr.same_side_reflection_address1[lr], rr.same_side_reflection_address2[lr], in[lr]);
+    Reflect(rr.different_side_reflection_address1[lr], rr.different_side_reflection_address2[lr ^ 1], in[lr]);
+  }
+
+  for (u32 lr = 0; lr < 2; lr++)
+  {
+    s32 out = ApplyVolume(ReverbRead(rr.comb_address1[lr]), rr.comb_volume[0]) +
+              ApplyVolume(ReverbRead(rr.comb_address2[lr]), rr.comb_volume[1]) +
+              ApplyVolume(ReverbRead(rr.comb_address3[lr]), rr.comb_volume[2]) +
+              ApplyVolume(ReverbRead(rr.comb_address4[lr]), rr.comb_volume[3]);
+    out = Clamp16(out);
+
+    const u16 apf_addresses[2] = {rr.apf_address1[lr], rr.apf_address2[lr]};
+    for (u32 i = 0; i < 2; i++)
     {
-      s32 left_sum = 0;
-      s32 right_sum = 0;
-      if (m_SPUCNT.enable)
+      const s32 delayed = ReverbRead(apf_addresses[i], -static_cast<s32>(ZeroExtend32(rr.apf_offset[i]) << 3));
+      out = Clamp16(out - ApplyVolume(delayed, rr.apf_volume[i]));
+      ReverbWrite(apf_addresses[i], out);
+      out = Clamp16(ApplyVolume(out, rr.apf_volume[i]) + delayed);
+    }
+
+    output[lr] = out;
+  }
+
+  m_reverb_current_address =
+    std::max<u32>(ZeroExtend32(m_reverb_base_address) << 3, (m_reverb_current_address + 2) & (RAM_MASK & ~u32(1)));
+}
+
+void SPU::ProcessReverb(const s32* left_in, const s32* right_in, u32 num_frames, s32* left_out, s32* right_out)
+{
+  static_assert(s_reverb_downsample_coefficients.size() == REVERB_DOWNSAMPLE_PADDED_TAPS);
+  static_assert(s_reverb_upsample_coefficients.size() == REVERB_UPSAMPLE_PADDED_TAPS);
+  static constexpr u32 DOWNSAMPLE_HISTORY = REVERB_DOWNSAMPLE_TAPS - 1;
+  static constexpr u32 UPSAMPLE_HISTORY = REVERB_UPSAMPLE_TAPS - 1;
+  static constexpr u32 MAX_STEPS = (MIX_BLOCK_FRAMES + 1) / 2;
+
+  const Common::Timer::Value start_time = Common::Timer::GetValue();
+
+  // The history from the previous block is placed before the new samples, so that each filter window is contiguous.
+  // The padding at the end is only ever multiplied by zero coefficients.
+  alignas(16) std::array<
+    std::array<s16, DOWNSAMPLE_HISTORY + MIX_BLOCK_FRAMES + (REVERB_DOWNSAMPLE_PADDED_TAPS - REVERB_DOWNSAMPLE_TAPS)>, 2>
+    input = {};
+  alignas(16) std::array<
+    std::array<s16, UPSAMPLE_HISTORY + MAX_STEPS + (REVERB_UPSAMPLE_PADDED_TAPS - REVERB_UPSAMPLE_TAPS)>, 2>
+    output = {};
+  const s32* const in[2] = {left_in, right_in};
+  for (u32 lr = 0; lr < 2; lr++)
+  {
+    std::copy(m_reverb_downsample_history[lr].begin(), m_reverb_downsample_history[lr].end(), input[lr].begin());
+    for (u32 i = 0; i < num_frames; i++)
+      input[lr][DOWNSAMPLE_HISTORY + i] = Clamp16(in[lr][i]);
+    std::copy(m_reverb_upsample_history[lr].begin(), m_reverb_upsample_history[lr].end(), output[lr].begin());
+  }
+
+  // The reverb unit steps every second frame. On the frames in between, only the centre tap of the upsampling filter
+  // is non-zero, so the output is the delayed sample.
+  u32 num_steps = 0;
+  bool step_frame = m_reverb_resample_phase;
+  for (u32 i = 0; i < num_frames; i++)
+  {
+    s32 out[2];
+    if (step_frame)
+    {
+      s32 downsampled[2];
+      for (u32 lr = 0; lr < 2; lr++)
+        downsampled[lr] = Clamp16(ReverbFIR(&input[lr][i], s_reverb_downsample_coefficients.data(),
+                                            REVERB_DOWNSAMPLE_PADDED_TAPS) >> 15);
+
+      s32 stepped[2];
+      ReverbStep(downsampled, stepped);
+      for (u32 lr = 0; lr < 2; lr++)
       {
-        for (u32 voice = 0; voice < NUM_VOICES; voice++)
+        output[lr][UPSAMPLE_HISTORY + num_steps] = static_cast<s16>(stepped[lr]);
+        out[lr] = Clamp16(ReverbFIR(&output[lr][num_steps], s_reverb_upsample_coefficients.data(),
+                                    REVERB_UPSAMPLE_PADDED_TAPS) >> 14);
+      }
+
+      num_steps++;
+    }
+    else
+    {
+      for (u32 lr = 0; lr < 2; lr++)
+        out[lr] = output[lr][UPSAMPLE_HISTORY / 2 + num_steps];
+    }
+
+    left_out[i] = ApplyVolume(out[0], m_reverb_output_volume_left);
+    right_out[i] = ApplyVolume(out[1], m_reverb_output_volume_right);
+    step_frame = !step_frame;
+  }
+
+  m_reverb_resample_phase = step_frame;
+  for (u32 lr = 0; lr < 2; lr++)
+  {
+    std::copy_n(&input[lr][num_frames], DOWNSAMPLE_HISTORY, m_reverb_downsample_history[lr].begin());
+    std::copy_n(&output[lr][num_steps], UPSAMPLE_HISTORY, m_reverb_upsample_history[lr].begin());
+  }
+
+  // The cost is reported once per second of output.
+  m_reverb_time += Common::Timer::GetValue() - start_time;
+  m_reverb_time_frames += num_frames;
+  if (m_reverb_time_frames >= SAMPLE_RATE)
+  {
+    m_reverb_time_per_frame =
+      Common::Timer::ConvertValueToNanoseconds(m_reverb_time) / static_cast<double>(m_reverb_time_frames);
+    m_reverb_time = 0;
+    m_reverb_time_frames = 0;
+  }
+}
+
+void SPU::GenerateFrames(s16* output_frames, u32 num_frames)
+{
+  DebugAssert(num_frames <= MIX_BLOCK_FRAMES);
+
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> left_sum = {};
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> right_sum = {};
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> reverb_left_sum = {};
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> reverb_right_sum = {};
+  std::array<std::array<s32, MIX_BLOCK_FRAMES>, 2> capture_amplitudes;
+  if (m_SPUCNT.enable)
+  {
+    if (CanMixVoicesInBlocks())
+    {
+      // The previous voice's output is kept around for pitch modulation.
+      alignas(16) std::array<std::array<s32, MIX_BLOCK_FRAMES>, 2> voice_amplitudes;
+      for (u32 voice = 0; voice < NUM_VOICES; voice++)
+      {
+        s32* amplitudes = voice_amplitudes[voice % 2].data();
+        const s32* modulator_amplitudes =
+          IsPitchModulationEnabled(voice) ? voice_amplitudes[(voice - 1) % 2].data() : nullptr;
+        if (m_SPUCNT.irq9_enable && GetVoiceFramesUntilIRQ(voice, num_frames) <= num_frames)
         {
-          const auto [left, right] = SampleVoice(voice);
-          left_sum += left;
-          right_sum += right;
+          // This voice reaches the IRQ address during the block, so it is stepped a frame at a time to raise the IRQ
+          // as the block is decoded. The other voices aren't affected.
+          const bool reverb = IsVoiceReverbEnabled(voice);
+          for (u32 i = 0; i < num_frames; i++)
+          {
+            const auto [left, right] = SampleVoice(voice, modulator_amplitudes ? modulator_amplitudes[i] : 0);
+            amplitudes[i] = m_voices[voice].last_amplitude;
+            left_sum[i] += left;
+            right_sum[i] += right;
+            if (reverb)
+            {
+              reverb_left_sum[i] += left;
+              reverb_right_sum[i] += right;
+            }
+          }
         }
-
-        if (!m_SPUCNT.mute_n)
+        else
         {
-          left_sum = 0;
-          right_sum = 0;
+          SampleVoiceBlock(voice, num_frames, modulator_amplitudes, amplitudes, left_sum.data(), right_sum.data(),
+                           reverb_left_sum.data(), reverb_right_sum.data());
         }
-      }
 
-      // Mix in CD audio.
-      s16 cd_audio_left;
-      s16 cd_audio_right;
-      if (!m_cd_audio_buffer.IsEmpty())
+        if (voice == 1 || voice == 3)
+          std::copy_n(amplitudes, num_frames, capture_amplitudes[voice / 2].begin());
+      }
+    }
+    else
+    {
+      for (u32 i = 0; i < num_frames; i++)
       {
-        cd_audio_left = m_cd_audio_buffer.Pop();
-        cd_audio_right = m_cd_audio_buffer.Pop();
-        if (m_SPUCNT.cd_audio_enable)
+        for (u32 voice = 0; voice < NUM_VOICES; voice++)
         {
-          left_sum += ApplyVolume(s32(cd_audio_left), m_cd_audio_volume_left);
-          right_sum += ApplyVolume(s32(cd_audio_right), m_cd_audio_volume_right);
+          const auto [left, right] =
+            SampleVoice(voice, (voice > 0) ? m_voices[voice - 1].last_amplitude : 0);
+          left_sum[i] += left;
+          right_sum[i] += right;
+          if (IsVoiceReverbEnabled(voice))
+          {
+            reverb_left_sum[i] += left;
+            reverb_right_sum[i] += right;
+          }
         }
+
+        capture_amplitudes[0][i] = m_voices[1].last_amplitude;
+        capture_amplitudes[1][i] = m_voices[3].last_amplitude;
       }
-      else
+    }
+  }
+  else
+  {
+    capture_amplitudes[0].fill(m_voices[1].last_amplitude);
+    capture_amplitudes[1].fill(m_voices[3].last_amplitude);
+  }
+
+  // CD audio is needed up front, since it can feed the reverb unit.
+  std::array<std::array<s16, MIX_BLOCK_FRAMES>, 2> cd_audio;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> cd_audio_left_sum = {};
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> cd_audio_right_sum = {};
+  {
+    // frames are interleaved, and only wrap around the end of the buffer on a frame boundary
+    const u32 cd_audio_frames = std::min(num_frames, m_cd_audio_buffer.GetSize() / 2);
+    const s16* spans[2];
+    u32 span_sizes[2];
+    m_cd_audio_buffer.PeekSpans(cd_audio_frames * 2, &spans[0], &span_sizes[0], &spans[1], &span_sizes[1]);
+    u32 frame = 0;
+    for (u32 span = 0; span < 2; span++)
+    {
+      for (u32 i = 0; i < span_sizes[span]; i += 2, frame++)
       {
-        cd_audio_left = 0;
-        cd_audio_right = 0;
+        cd_audio[0][frame] = spans[span][i];
+        cd_audio[1][frame] = spans[span][i + 1];
       }
+    }
+    m_cd_audio_buffer.Remove(cd_audio_frames * 2);
 
-      // Apply main volume before clamping.
-      *(output_frame++) = Clamp16(ApplyVolume(left_sum, m_main_volume_left.GetVolume()));
-      *(output_frame++) = Clamp16(ApplyVolume(right_sum, m_main_volume_right.GetVolume()));
+    std::fill(cd_audio[0].begin() + cd_audio_frames, cd_audio[0].begin() + num_frames, s16(0));
+    std::fill(cd_audio[1].begin() + cd_audio_frames, cd_audio[1].begin() + num_frames, s16(0));
+    if (m_SPUCNT.cd_audio_enable)
+    {
+      for (u32 i = 0; i < cd_audio_frames; i++)
+      {
+        cd_audio_left_sum[i] = ApplyVolume(s32(cd_audio[0][i]), m_cd_audio_volume_left);
+        cd_audio_right_sum[i] = ApplyVolume(s32(cd_audio[1][i]), m_cd_audio_volume_right);
+      }
+    }
+  }
+
+  // With the work area write-protected and the output silent, the reverb unit has no visible effect.
+  if (m_SPUCNT.enable && (m_SPUCNT.reverb_master_enable || m_reverb_output_volume_left != 0 ||
+                          m_reverb_output_volume_right != 0))
+  {
+    if (m_SPUCNT.cd_audio_reverb)
+    {
+      for (u32 i = 0; i < num_frames; i++)
+      {
+        reverb_left_sum[i] += cd_audio_left_sum[i];
+        reverb_right_sum[i] += cd_audio_right_sum[i];
+      }
+    }
+
+    alignas(16) std::array<s32, MIX_BLOCK_FRAMES> reverb_left_out;
+    alignas(16) std::array<s32, MIX_BLOCK_FRAMES> reverb_right_out;
+    ProcessReverb(reverb_left_sum.data(), reverb_right_sum.data(), num_frames, reverb_left_out.data(),
+                  reverb_right_out.data());
+    for (u32 i = 0; i < num_frames; i++)
+    {
+      left_sum[i] += reverb_left_out[i];
+      right_sum[i] += reverb_right_out[i];
+    }
+  }
+
+  // Muting doesn't apply to CD audio.
+  if (m_SPUCNT.enable && !m_SPUCNT.mute_n)
+  {
+    left_sum.fill(0);
+    right_sum.fill(0);
+  }
+
+  for (u32 i = 0; i < num_frames; i++)
+  {
+    // Apply main volume before clamping.
+    *(output_frames++) = Clamp16(ApplyVolume(left_sum[i] + cd_audio_left_sum[i], m_main_volume_left.GetVolume()));
+    *(output_frames++) = Clamp16(ApplyVolume(right_sum[i] + cd_audio_right_sum[i], m_main_volume_right.GetVolume()));
+
+    // Write to capture buffers.
+    WriteToCaptureBuffer(0, cd_audio[0][i]);
+    WriteToCaptureBuffer(1, cd_audio[1][i]);
+    WriteToCaptureBuffer(2, Clamp16(capture_amplitudes[0][i]));
+    WriteToCaptureBuffer(3, Clamp16(capture_amplitudes[1][i]));
+    IncrementCaptureBufferPosition();
+  }
+}
+
+void SPU::Execute(TickCount ticks)
+{
+  DebugAssert(m_SPUCNT.enable || m_SPUCNT.cd_audio_enable);
+
+  u32 remaining_frames = static_cast<u32>((ticks + m_ticks_carry) / SYSCLK_TICKS_PER_SPU_TICK);
+  m_ticks_carry = (ticks + m_ticks_carry) % SYSCLK_TICKS_PER_SPU_TICK;
+
+  while (remaining_frames > 0)
+  {
+    AudioStream* const output_stream = m_system->GetHostInterface()->GetAudioStream();
+    s16* output_frame;
+    u32 output_frame_space;
+    output_stream->BeginWrite(&output_frame, &output_frame_space);
 
-      // Write to capture buffers.
-      WriteToCaptureBuffer(0, cd_audio_left);
-      WriteToCaptureBuffer(1, cd_audio_right);
-      WriteToCaptureBuffer(2, Clamp16(m_voices[1].last_amplitude));
-      WriteToCaptureBuffer(3, Clamp16(m_voices[3].last_amplitude));
-      IncrementCaptureBufferPosition();
+    const u32 frames_in_this_batch = std::min(remaining_frames, output_frame_space);
+    for (u32 i = 0; i < frames_in_this_batch;)
+    {
+      const u32 frames_in_this_block = std::min(frames_in_this_batch - i, MIX_BLOCK_FRAMES);
+      GenerateFrames(output_frame, frames_in_this_block);
+      output_frame += frames_in_this_block * 2;
+      i += frames_in_this_block;
     }
 
     output_stream->EndWrite(frames_in_this_batch);
     remaining_frames -= frames_in_this_batch;
   }
+
+  ScheduleSampleEvent();
 }
 
 void SPU::UpdateEventInterval()
@@ -700,21 +1227,110 @@ void SPU::UpdateEventInterval()
     return;
   }
 
-  // Don't generate more than the audio buffer since in a single slice, otherwise we'll both overflow the buffers when
-  // we do write it, and the audio thread will underflow since it won't have enough data it the game isn't messing with
-  // the SPU state.
-  const u32 max_slice_frames = m_system->GetHostInterface()->GetAudioStream()->GetBufferSize();
+  // Ensure all pending ticks have been executed, since we won't get them back after rescheduling. Execute() schedules
+  // the next run once it has caught up.
+  if (m_sample_event->IsActive())
+    m_sample_event->InvokeEarly(true);
+  else
+    ScheduleSampleEvent();
+}
 
-  // TODO: Make this predict how long until the interrupt will be hit instead...
-  const u32 interval = m_SPUCNT.irq9_enable ? 1 : max_slice_frames;
-  const TickCount interval_ticks = static_cast<TickCount>(interval) * SYSCLK_TICKS_PER_SPU_TICK;
-  if (m_sample_event->IsActive() && m_sample_event->GetInterval() == interval_ticks)
-    return;
+void SPU::ScheduleSampleEvent()
+{
+  // Everything which observes the SPU catches up first, and the audio stream is fed by the flush at the end of every
+  // frame, so the event only has to fire when the IRQ could be raised. Otherwise it is a backstop which stops a single
+  // catch-up from generating more than the stream's buffers can hold, since the writes past that would block or drop
+  // audio partway through.
+  const AudioStream* output_stream = m_system->GetHostInterface()->GetAudioStream();
+  u32 frames = output_stream->GetBufferSize() * output_stream->GetBufferCount();
+  if (m_SPUCNT.irq9_enable)
+    frames = GetFramesUntilIRQ(frames);
+
+  const TickCount ticks = static_cast<TickCount>(frames * SYSCLK_TICKS_PER_SPU_TICK) - m_ticks_carry;
+  m_sample_event->SetInterval(ticks);
+  m_sample_event->Schedule(ticks);
+}
+
+u32 SPU::GetFramesUntilIRQ(u32 max_frames) const
+{
+  const u32 irq_address = (ZeroExtend32(m_irq_address) * 8) & RAM_MASK;
+  u32 frames = max_frames;
+
+  // The capture buffers are written every frame, at the same position in each of the four buffers.
+  if (irq_address < (CAPTURE_BUFFER_SIZE_PER_CHANNEL * 4))
+  {
+    const u32 distance = ((irq_address % CAPTURE_BUFFER_SIZE_PER_CHANNEL) - ZeroExtend32(m_capture_buffer_position)) %
+                         CAPTURE_BUFFER_SIZE_PER_CHANNEL;
+    frames = std::min<u32>(frames, distance / sizeof(s16) + 1);
+  }
+
+  for (u32 i = 0; i < NUM_VOICES && frames > 1; i++)
+    frames = std::min(frames, GetVoiceFramesUntilIRQ(i, frames));
+
+  return std::max<u32>(frames, 1);
+}
+
+u32 SPU::GetVoiceFramesUntilIRQ(u32 voice_index, u32 max_frames) const
+{
+  const Voice& voice = m_voices[voice_index];
+  if (!voice.IsOn())
+    return max_frames + 1;
+
+  // Voices check both halves of a block when it is decoded, at the start of the frame where they reach it. The path
+  // through the blocks doesn't depend on the pitch, so pitch modulated voices are assumed to play at the maximum rate.
+  static constexpr u32 block_length = ZeroExtend32(NUM_SAMPLES_PER_ADPCM_BLOCK) << 12;
+  const u32 irq_address = (ZeroExtend32(m_irq_address) * 8) & RAM_MASK;
+  const auto BlockHitsIRQ = [irq_address](u16 address) {
+    const u32 ram_address = (ZeroExtend32(address) * 8) & RAM_MASK;
+    return (ram_address == irq_address || ((ram_address + 8) & RAM_MASK) == irq_address);
+  };
+
+  const u32 step = IsPitchModulationEnabled(voice_index) ? 0x4000u : ZeroExtend32(GetVoicePitchStep(voice_index, 0));
+  u16 address = voice.current_address;
+  u32 counter = voice.counter.bits & 0x1FFFF;
+  ADPCMFlags flags = voice.current_block_flags;
+  u16 repeat_address = voice.regs.adpcm_repeat_address;
+  bool decoded = voice.has_samples;
+  for (u32 frame = 1; frame <= max_frames;)
+  {
+    if (!decoded)
+    {
+      if (BlockHitsIRQ(address))
+        return frame;
 
-  // Ensure all pending ticks have been executed, since we won't get them back after rescheduling.
-  m_sample_event->InvokeEarly(true);
-  m_sample_event->SetInterval(interval_ticks);
-  m_sample_event->Schedule(interval_ticks - m_ticks_carry);
+      flags.bits = m_ram[((ZeroExtend32(address) * 8) + 1) & RAM_MASK];
+      if (flags.loop_start)
+        repeat_address = address;
+    }
+
+    if (step == 0)
+      break;
+
+    const u32 frames_in_block = (block_length - counter + step - 1) / step;
+    counter = counter + frames_in_block * step - block_length;
+    frame += frames_in_block;
+    decoded = false;
+
+    if (flags.loop_end)
+    {
+      if (!flags.loop_repeat)
+        break;
+
+      address = repeat_address;
+    }
+    else
+    {
+      address += 2;
+    }
+  }
+
+  return max_frames + 1;
+}
+
+void SPU::InvalidateIRQPrediction()
+{
+  if (m_SPUCNT.irq9_enable)
+    UpdateEventInterval();
 }
 
 void SPU::GeneratePendingSamples()
@@ -871,6 +1487,15 @@ void SPU::Voice::DecodeBlock(const ADPCMBlock& block)
   current_block_flags.bits = block.flags.bits;
 }
 
+void SPU::Voice::LoadCachedBlock(const ADPCMCacheEntry& entry)
+{
+  std::copy(current_block_samples.end() - previous_block_last_samples.size(), current_block_samples.end(),
+            previous_block_last_samples.begin());
+  current_block_samples = entry.samples;
+  adpcm_last_samples = entry.last_samples_out;
+  current_block_flags.bits = entry.flags.bits;
+}
+
 s16 SPU::Voice::SampleBlock(s32 index) const
 {
   if (index < 0)
@@ -884,88 +1509,19 @@ s16 SPU::Voice::SampleBlock(s32 index) const
 
 s16 SPU::Voice::Interpolate() const
 {
-  static constexpr std::array<s32, 0x200> gauss = {{
-    -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
-    -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, //
-    0x0001, 0x0001, 0x0001, 0x0002, 0x0002, 0x0002, 0x0003, 0x0003, //
-    0x0003, 0x0004, 0x0004, 0x0005, 0x0005, 0x0006, 0x0007, 0x0007, //
-    0x0008, 0x0009, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, //
-    0x000F, 0x0010, 0x0011, 0x0012, 0x0013, 0x0015, 0x0016, 0x0018, // entry
-    0x0019, 0x001B, 0x001C, 0x001E, 0x0020, 0x0021, 0x0023, 0x0025, // 000..07F
-    0x0027, 0x0029, 0x002C, 0x002E, 0x0030, 0x0033, 0x0035, 0x0038, //
-    0x003A, 0x003D, 0x0040, 0x0043, 0x0046, 0x0049, 0x004D, 0x0050, //
-    0x0054, 0x0057, 0x005B, 0x005F, 0x0063, 0x0067, 0x006B, 0x006F, //
-    0x0074, 0x0078, 0x007D, 0x0082, 0x0087, 0x008C, 0x0091, 0x0096, //
-    0x009C, 0x00A1, 0x00A7, 0x00AD, 0x00B3, 0x00BA, 0x00C0, 0x00C7, //
-    0x00CD, 0x00D4, 0x00DB, 0x00E3, 0x00EA, 0x00F2, 0x00FA, 0x0101, //
-    0x010A, 0x0112, 0x011B, 0x0123, 0x012C, 0x0135, 0x013F, 0x0148, //
-    0x0152, 0x015C, 0x0166, 0x0171, 0x017B, 0x0186, 0x0191, 0x019C, //
-    0x01A8, 0x01B4, 0x01C0, 0x01CC, 0x01D9, 0x01E5, 0x01F2, 0x0200, //
-    0x020D, 0x021B, 0x0229, 0x0237, 0x0246, 0x0255, 0x0264, 0x0273, //
-    0x0283, 0x0293, 0x02A3, 0x02B4, 0x02C4, 0x02D6, 0x02E7, 0x02F9, //
-    0x030B, 0x031D, 0x0330, 0x0343, 0x0356, 0x036A, 0x037E, 0x0392, //
-    0x03A7, 0x03BC, 0x03D1, 0x03E7, 0x03FC, 0x0413, 0x042A, 0x0441, //
-    0x0458, 0x0470, 0x0488, 0x04A0, 0x04B9, 0x04D2, 0x04EC, 0x0506, //
-    0x0520, 0x053B, 0x0556, 0x0572, 0x058E, 0x05AA, 0x05C7, 0x05E4, // entry
-    0x0601, 0x061F, 0x063E, 0x065C, 0x067C, 0x069B, 0x06BB, 0x06DC, // 080..0FF
-    0x06FD, 0x071E, 0x0740, 0x0762, 0x0784, 0x07A7, 0x07CB, 0x07EF, //
-    0x0813, 0x0838, 0x085D, 0x0883, 0x08A9, 0x08D0, 0x08F7, 0x091E, //
-    0x0946, 0x096F, 0x0998, 0x09C1, 0x09EB, 0x0A16, 0x0A40, 0x0A6C, //
-    0x0A98, 0x0AC4, 0x0AF1, 0x0B1E, 0x0B4C, 0x0B7A, 0x0BA9, 0x0BD8, //
-    0x0C07, 0x0C38, 0x0C68, 0x0C99, 0x0CCB, 0x0CFD, 0x0D30, 0x0D63, //
-    0x0D97, 0x0DCB, 0x0E00, 0x0E35, 0x0E6B, 0x0EA1, 0x0ED7, 0x0F0F, //
-    0x0F46, 0x0F7F, 0x0FB7, 0x0FF1, 0x102A, 0x1065, 0x109F, 0x10DB, //
-    0x1116, 0x1153, 0x118F, 0x11CD, 0x120B, 0x1249, 0x1288, 0x12C7, //
-    0x1307, 0x1347, 0x1388, 0x13C9, 0x140B, 0x144D, 0x1490, 0x14D4, //
-    0x1517, 0x155C, 0x15A0, 0x15E6, 0x162C, 0x1672, 0x16B9, 0x1700, //
-    0x1747, 0x1790, 0x17D8, 0x1821, 0x186B, 0x18B5, 0x1900, 0x194B, //
-    0x1996, 0x19E2, 0x1A2E, 0x1A7B, 0x1AC8, 0x1B16, 0x1B64, 0x1BB3, //
-    0x1C02, 0x1C51, 0x1CA1, 0x1CF1, 0x1D42, 0x1D93, 0x1DE5, 0x1E37, //
-    0x1E89, 0x1EDC, 0x1F2F, 0x1F82, 0x1FD6, 0x202A, 0x207F, 0x20D4, //
-    0x2129, 0x217F, 0x21D5, 0x222C, 0x2282, 0x22DA, 0x2331, 0x2389, // entry
-    0x23E1, 0x2439, 0x2492, 0x24EB, 0x2545, 0x259E, 0x25F8, 0x2653, // 100..17F
-    0x26AD, 0x2708, 0x2763, 0x27BE, 0x281A, 0x2876, 0x28D2, 0x292E, //
-    0x298B, 0x29E7, 0x2A44, 0x2AA1, 0x2AFF, 0x2B5C, 0x2BBA, 0x2C18, //
-    0x2C76, 0x2CD4, 0x2D33, 0x2D91, 0x2DF0, 0x2E4F, 0x2EAE, 0x2F0D, //
-    0x2F6C, 0x2FCC, 0x302B, 0x308B, 0x30EA, 0x314A, 0x31AA, 0x3209, //
-    0x3269, 0x32C9, 0x3329, 0x3389, 0x33E9, 0x3449, 0x34A9, 0x3509, //
-    0x3569, 0x35C9, 0x3629, 0x3689, 0x36E8, 0x3748, 0x37A8, 0x3807, //
-    0x3867, 0x38C6, 0x3926, 0x3985, 0x39E4, 0x3A43, 0x3AA2, 0x3B00, //
-    0x3B5F, 0x3BBD, 0x3C1B, 0x3C79, 0x3CD7, 0x3D35, 0x3D92, 0x3DEF, //
-    0x3E4C, 0x3EA9, 0x3F05, 0x3F62, 0x3FBD, 0x4019, 0x4074, 0x40D0, //
-    0x412A, 0x4185, 0x41DF, 0x4239, 0x4292, 0x42EB, 0x4344, 0x439C, //
-    0x43F4, 0x444C, 0x44A3, 0x44FA, 0x4550, 0x45A6, 0x45FC, 0x4651, //
-    0x46A6, 0x46FA, 0x474E, 0x47A1, 0x47F4, 0x4846, 0x4898, 0x48E9, //
-    0x493A, 0x498A, 0x49D9, 0x4A29, 0x4A77, 0x4AC5, 0x4B13, 0x4B5F, //
-    0x4BAC, 0x4BF7, 0x4C42, 0x4C8D, 0x4CD7, 0x4D20, 0x4D68, 0x4DB0, //
-    0x4DF7, 0x4E3E, 0x4E84, 0x4EC9, 0x4F0E, 0x4F52, 0x4F95, 0x4FD7, // entry
-    0x5019, 0x505A, 0x509A, 0x50DA, 0x5118, 0x5156, 0x5194, 0x51D0, // 180..1FF
-    0x520C, 0x5247, 0x5281, 0x52BA, 0x52F3, 0x532A, 0x5361, 0x5397, //
-    0x53CC, 0x5401, 0x5434, 0x5467, 0x5499, 0x54CA, 0x54FA, 0x5529, //
-    0x5558, 0x5585, 0x55B2, 0x55DE, 0x5609, 0x5632, 0x565B, 0x5684, //
-    0x56AB, 0x56D1, 0x56F6, 0x571B, 0x573E, 0x5761, 0x5782, 0x57A3, //
-    0x57C3, 0x57E2, 0x57FF, 0x581C, 0x5838, 0x5853, 0x586D, 0x5886, //
-    0x589E, 0x58B5, 0x58CB, 0x58E0, 0x58F4, 0x5907, 0x5919, 0x592A, //
-    0x593A, 0x5949, 0x5958, 0x5965, 0x5971, 0x597C, 0x5986, 0x598F, //
-    0x5997, 0x599E, 0x59A4, 0x59A9, 0x59AD, 0x59B0, 0x59B2, 0x59B3  //
-  }};
-
   const u8 i = counter.interpolation_index;
   const s32 s = static_cast<s32>(ZeroExtend32(counter.sample_index.GetValue()));
 
-  s16 out = s16(gauss[0x0FF - i] * s32(SampleBlock(s - 3)) >> 15);
-  out += s16(gauss[0x1FF - i] * s32(SampleBlock(s - 2)) >> 15);
-  out += s16(gauss[0x100 + i] * s32(SampleBlock(s - 1)) >> 15);
-  out += s16(gauss[0x000 + i] * s32(SampleBlock(s - 0)) >> 15);
+  s16 out = s16(s_gauss_table[0x0FF - i] * s32(SampleBlock(s - 3)) >> 15);
+  out += s16(s_gauss_table[0x1FF - i] * s32(SampleBlock(s - 2)) >> 15);
+  out += s16(s_gauss_table[0x100 + i] * s32(SampleBlock(s - 1)) >> 15);
+  out += s16(s_gauss_table[0x000 + i] * s32(SampleBlock(s - 0)) >> 15);
   return out;
 }
 
 void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
 {
   u32 ram_address = (ZeroExtend32(address) * 8) & RAM_MASK;
-  CheckRAMIRQ(ram_address);
-  CheckRAMIRQ((ram_address + 8) & RAM_MASK);
 
   // fast path - no wrap-around
   if ((ram_address + sizeof(ADPCMBlock)) <= RAM_SIZE)
@@ -985,42 +1541,97 @@ void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
   }
 }
 
-std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
+void SPU::DecodeVoiceBlock(u32 voice_index)
 {
   Voice& voice = m_voices[voice_index];
-  if (!voice.IsOn())
+  const u16 address = voice.current_address;
+  const u32 ram_address = (ZeroExtend32(address) * 8) & RAM_MASK;
+  CheckRAMIRQ(ram_address);
+  CheckRAMIRQ((ram_address + 8) & RAM_MASK);
+
+  // The decoded samples only depend on the previous samples when the block uses a filter.
+  CleanRAMDirtyUnit(address);
+  CleanRAMDirtyUnit(address + 1);
+  ADPCMCacheEntry& entry = m_adpcm_cache[address % ADPCM_CACHE_SIZE];
+  if (entry.valid && entry.address == address &&
+      (entry.filter == 0 || entry.last_samples_in == voice.adpcm_last_samples))
   {
-    voice.last_amplitude = 0;
-    return {};
+    m_adpcm_cache_hits++;
+    voice.LoadCachedBlock(entry);
   }
-
-  if (!voice.has_samples)
+  else
   {
+    m_adpcm_cache_misses++;
+
     ADPCMBlock block;
-    ReadADPCMBlock(voice.current_address, &block);
+    ReadADPCMBlock(address, &block);
+    entry.last_samples_in = voice.adpcm_last_samples;
     voice.DecodeBlock(block);
-    voice.has_samples = true;
 
-    if (voice.current_block_flags.loop_start)
-    {
-      Log_TracePrintf("Voice %u loop start @ 0x%08X", voice_index, ZeroExtend32(voice.current_address));
-      voice.regs.adpcm_repeat_address = voice.current_address;
-    }
+    entry.samples = voice.current_block_samples;
+    entry.last_samples_out = voice.adpcm_last_samples;
+    entry.address = address;
+    entry.filter = block.GetFilter();
+    entry.flags.bits = voice.current_block_flags.bits;
+    entry.valid = true;
   }
 
-  // interpolate/sample and apply ADSR volume
-  const s32 amplitude = ApplyVolume(voice.Interpolate(), voice.regs.adsr_volume);
-  voice.last_amplitude = amplitude;
-  voice.TickADSR();
+  voice.has_samples = true;
 
-  // Pitch modulation
-  u16 step = voice.regs.adpcm_sample_rate;
+  if (voice.current_block_flags.loop_start)
+  {
+    Log_TracePrintf("Voice %u loop start @ 0x%08X", voice_index, ZeroExtend32(voice.current_address));
+    voice.regs.adpcm_repeat_address = voice.current_address;
+  }
+}
+
+void SPU::MarkRAMDirty(u32 ram_address, u32 size)
+{
+  const u32 first_unit = ram_address >> VOICE_ADDRESS_SHIFT;
+  const u32 last_unit = (ram_address + size - 1) >> VOICE_ADDRESS_SHIFT;
+  for (u32 unit = first_unit; unit <= last_unit; unit++)
+    m_ram_dirty_bitmap[unit / 64] |= (UINT64_C(1) << (unit % 64));
+}
+
+void SPU::CleanRAMDirtyUnit(u16 address)
+{
+  u64& bits = m_ram_dirty_bitmap[address / 64];
+  const u64 mask = UINT64_C(1) << (address % 64);
+  if (!(bits & mask))
+    return;
+
+  // Both blocks which start in the previous unit and this one cover it.
+  bits &= ~mask;
+  for (const u16 block_address : {static_cast<u16>(address - 1), address})
+  {
+    ADPCMCacheEntry& entry = m_adpcm_cache[block_address % ADPCM_CACHE_SIZE];
+    if (entry.address == block_address)
+      entry.valid = false;
+  }
+}
+
+void SPU::InvalidateADPCMCache()
+{
+  for (ADPCMCacheEntry& entry : m_adpcm_cache)
+    entry.valid = false;
+  m_ram_dirty_bitmap.fill(0);
+}
+
+u16 SPU::GetVoicePitchStep(u32 voice_index, s32 modulator_amplitude) const
+{
+  u16 step = m_voices[voice_index].regs.adpcm_sample_rate;
   if (IsPitchModulationEnabled(voice_index))
   {
-    const u32 factor = u32(std::clamp<s32>(m_voices[voice_index - 1].last_amplitude, -0x8000, 0x7FFF) + 0x8000);
+    const u32 factor = u32(std::clamp<s32>(modulator_amplitude, -0x8000, 0x7FFF) + 0x8000);
     step = Truncate16(step * factor) >> 15;
   }
-  step = std::min<u16>(step, 0x4000);
+
+  return std::min<u16>(step, 0x4000);
+}
+
+void SPU::AdvanceVoice(u32 voice_index, u16 step)
+{
+  Voice& voice = m_voices[voice_index];
 
   // Shouldn't ever overflow because if sample_index == 27, step == 0x4000 there won't be a carry out from the
   // interpolation index. If there is a carry out, bit 12 will never be 1, so it'll never add more than 4 to
@@ -1052,6 +1663,27 @@ std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
       }
     }
   }
+}
+
+std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index, s32 modulator_amplitude)
+{
+  Voice& voice = m_voices[voice_index];
+  if (!voice.IsOn())
+  {
+    voice.last_amplitude = 0;
+    return {};
+  }
+
+  if (!voice.has_samples)
+    DecodeVoiceBlock(voice_index);
+
+  // interpolate/sample and apply ADSR volume
+  const s32 amplitude = ApplyVolume(voice.Interpolate(), voice.regs.adsr_volume);
+  voice.last_amplitude = amplitude;
+  voice.TickADSR();
+
+  // Pitch modulation uses the previous voice's output for this frame
+  AdvanceVoice(voice_index, GetVoicePitchStep(voice_index, modulator_amplitude));
 
   // apply per-channel volume
   const s32 left = ApplyVolume(amplitude, voice.regs.volume_left.GetVolume());
@@ -1059,6 +1691,162 @@ std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
   return std::make_tuple(left, right);
 }
 
+void SPU::SampleVoiceBlock(u32 voice_index, u32 num_frames, const s32* modulator_amplitudes, s32* amplitudes,
+                           s32* left_sum, s32* right_sum, s32* reverb_left_sum, s32* reverb_right_sum)
+{
+  Voice& voice = m_voices[voice_index];
+  if (!voice.IsOn())
+  {
+    voice.last_amplitude = 0;
+    std::fill_n(amplitudes, num_frames, 0);
+    return;
+  }
+
+  // All blocks the voice passes through are decoded into one buffer, so that each frame's interpolation taps are
+  // contiguous. The three samples before the first block are needed by the first few frames.
+  std::array<s16, MIX_BLOCK_SAMPLE_BUFFER_SIZE> samples;
+  alignas(16) std::array<u16, MIX_BLOCK_FRAMES> positions = {};
+  alignas(16) std::array<u8, MIX_BLOCK_FRAMES> interpolation_indices = {};
+  alignas(16) std::array<s16, MIX_BLOCK_FRAMES> adsr_volumes = {};
+  u32 block_base = 3;
+  bool first_block = true;
+  const auto CopyCurrentBlock = [&voice, &samples, &block_base, &first_block]() {
+    if (first_block)
+    {
+      std::copy(voice.previous_block_last_samples.begin(), voice.previous_block_last_samples.end(), samples.begin());
+      first_block = false;
+    }
+    else
+    {
+      block_base += NUM_SAMPLES_PER_ADPCM_BLOCK;
+      DebugAssert((block_base + NUM_SAMPLES_PER_ADPCM_BLOCK) <= MIX_BLOCK_SAMPLE_BUFFER_SIZE);
+    }
+
+    std::copy(voice.current_block_samples.begin(), voice.current_block_samples.end(), &samples[block_base]);
+  };
+  if (voice.has_samples)
+    CopyCurrentBlock();
+
+  // Stepping through the blocks has side effects, so it is done frame by frame before interpolating.
+  u32 active_frames = 0;
+  for (; active_frames < num_frames && voice.IsOn(); active_frames++)
+  {
+    if (!voice.has_samples)
+    {
+      DecodeVoiceBlock(voice_index);
+      CopyCurrentBlock();
+    }
+
+    positions[active_frames] = static_cast<u16>(block_base + voice.counter.sample_index);
+    interpolation_indices[active_frames] = voice.counter.interpolation_index;
+    adsr_volumes[active_frames] = voice.regs.adsr_volume;
+    voice.TickADSR();
+
+    AdvanceVoice(voice_index,
+                 GetVoicePitchStep(voice_index, modulator_amplitudes ? modulator_amplitudes[active_frames] : 0));
+  }
+
+  InterpolateVoiceSamples(samples.data(), positions.data(), interpolation_indices.data(), adsr_volumes.data(),
+                          active_frames, amplitudes);
+  std::fill(amplitudes + active_frames, amplitudes + num_frames, 0);
+  voice.last_amplitude = amplitudes[num_frames - 1];
+
+  // apply per-channel volume
+  const s32 volume_left = voice.regs.volume_left.GetVolume();
+  const s32 volume_right = voice.regs.volume_right.GetVolume();
+  if (IsVoiceReverbEnabled(voice_index))
+  {
+    for (u32 i = 0; i < active_frames; i++)
+    {
+      const s32 left = (amplitudes[i] * volume_left) >> 15;
+      const s32 right = (amplitudes[i] * volume_right) >> 15;
+      left_sum[i] += left;
+      right_sum[i] += right;
+      reverb_left_sum[i] += left;
+      reverb_right_sum[i] += right;
+    }
+  }
+  else
+  {
+    for (u32 i = 0; i < active_frames; i++)
+    {
+      left_sum[i] += (amplitudes[i] * volume_left) >> 15;
+      right_sum[i] += (amplitudes[i] * volume_right) >> 15;
+    }
+  }
+}
+
+void SPU::InterpolateVoiceSamples(const s16* samples, const u16* positions, const u8* interpolation_indices,
+                                  const s16* adsr_volumes, u32 count, s32* amplitudes)
+{
+  // Each weighted tap is shifted before summing, and the sum wraps to 16 bits, to match Voice::Interpolate().
+  u32 i = 0;
+#if defined(CPU_X64)
+  for (; (i + 4) <= count; i += 4)
+  {
+    __m128i products[4];
+    for (u32 j = 0; j < 4; j += 2)
+    {
+      const __m128i taps =
+        _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&samples[positions[i + j] - 3])),
+                           _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&samples[positions[i + j + 1] - 3])));
+      const __m128i weights = _mm_unpacklo_epi64(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s_gauss_taps_table[interpolation_indices[i + j]].data())),
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s_gauss_taps_table[interpolation_indices[i + j + 1]].data())));
+      const __m128i lo = _mm_mullo_epi16(taps, weights);
+      const __m128i hi = _mm_mulhi_epi16(taps, weights);
+      products[j] = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+      products[j + 1] = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+    }
+
+    // transpose and add, giving the sum for each frame
+    const __m128i sum01 = _mm_add_epi32(_mm_unpacklo_epi32(products[0], products[1]),
+                                        _mm_unpackhi_epi32(products[0], products[1]));
+    const __m128i sum23 = _mm_add_epi32(_mm_unpacklo_epi32(products[2], products[3]),
+                                        _mm_unpackhi_epi32(products[2], products[3]));
+    __m128i out = _mm_add_epi32(_mm_unpacklo_epi64(sum01, sum23), _mm_unpackhi_epi64(sum01, sum23));
+    out = _mm_srai_epi32(_mm_slli_epi32(out, 16), 16);
+
+    // both operands are 16-bit, so the high halves of the multiply-add are zero
+    const __m128i volumes = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&adsr_volumes[i])),
+                                               _mm_setzero_si128());
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&amplitudes[i]), _mm_srai_epi32(_mm_madd_epi16(out, volumes), 15));
+  }
+#elif defined(CPU_AARCH64)
+  for (; (i + 4) <= count; i += 4)
+  {
+    int32x4_t products[4];
+    for (u32 j = 0; j < 4; j++)
+    {
+      products[j] = vshrq_n_s32(vmull_s16(vld1_s16(&samples[positions[i + j] - 3]),
+                                          vld1_s16(s_gauss_taps_table[interpolation_indices[i + j]].data())),
+                                15);
+    }
+
+    const int32x4_t sum = vpaddq_s32(vpaddq_s32(products[0], products[1]), vpaddq_s32(products[2], products[3]));
+    const int16x4_t out = vmovn_s32(sum);
+    vst1q_s32(&amplitudes[i], vshrq_n_s32(vmull_s16(out, vld1_s16(&adsr_volumes[i])), 15));
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    const s16* taps = &samples[positions[i] - 3];
+    const GaussTaps& weights = s_gauss_taps_table[interpolation_indices[i]];
+    s32 out = 0;
+    for (u32 j = 0; j < 4; j++)
+      out += (s32(weights[j]) * s32(taps[j])) >> 15;
+
+    amplitudes[i] = ApplyVolume(static_cast<s16>(out), adsr_volumes[i]);
+  }
+}
+
+void SPU::AddCDAudioFrames(const s16* frames, u32 num_frames)
+{
+  EnsureCDAudioSpace(num_frames);
+  m_cd_audio_buffer.PushRange(frames, num_frames * 2);
+}
+
 void SPU::EnsureCDAudioSpace(u32 remaining_frames)
 {
   if (m_cd_audio_buffer.IsEmpty())
@@ -1066,6 +1854,11 @@ void SPU::EnsureCDAudioSpace(u32 remaining_frames)
     // we want the audio to start playing at the right point, not a few cycles early, otherwise this'll cause sync issues.
     m_sample_event->InvokeEarly();
   }
+  else if (m_cd_audio_buffer.GetSpace() < (remaining_frames * 2))
+  {
+    // The sample event doesn't run on a fixed interval, so catch up before dropping anything.
+    m_sample_event->InvokeEarly();
+  }
 
   if (m_cd_audio_buffer.GetSpace() < (remaining_frames * 2))
   {
@@ -1141,6 +1934,14 @@ void SPU::DrawDebugStateWindow()
     ImGui::SameLine(offsets[3]);
     ImGui::TextColored(m_SPUCNT.cd_audio_enable ? active_color : inactive_color, "Right Volume: %d%%",
                        ApplyVolume(100, m_cd_audio_volume_left));
+
+    const u64 adpcm_cache_lookups = m_adpcm_cache_hits + m_adpcm_cache_misses;
+    ImGui::Text("ADPCM Cache: ");
+    ImGui::SameLine(offsets[0]);
+    ImGui::Text("%" PRIu64 " hits, %" PRIu64 " misses (%.1f%% hit rate)", m_adpcm_cache_hits, m_adpcm_cache_misses,
+                (adpcm_cache_lookups > 0) ? (static_cast<double>(m_adpcm_cache_hits) * 100.0 /
+                                             static_cast<double>(adpcm_cache_lookups)) :
+                                            0.0);
   }
 
   // draw voice states
@@ -1215,6 +2016,19 @@ void SPU::DrawDebugStateWindow()
     ImGui::TextColored(m_SPUCNT.external_audio_reverb ? active_color : inactive_color, "External Audio Enable: %s",
                        m_SPUCNT.external_audio_reverb ? "Yes" : "No");
 
+    ImGui::Text("Base Address: 0x%05X (current 0x%05X)", ZeroExtend32(m_reverb_base_address) << 3,
+                m_reverb_current_address);
+    ImGui::Text("Output Volume: %d / %d", m_reverb_output_volume_left, m_reverb_output_volume_right);
+    ImGui::Text("Cost: %.1f ns/frame", m_reverb_time_per_frame);
+
+    ImGui::Text("Registers: ");
+    for (u32 i = 0; i < NUM_REVERB_REGS; i++)
+    {
+      if ((i % 8) != 0)
+        ImGui::SameLine(0.0f, 8.0f);
+      ImGui::Text("%04X", ZeroExtend32(m_reverb_registers.rev[i]));
+    }
+
     ImGui::Text("Pitch Modulation: ");
     for (u32 i = 1; i < NUM_VOICES; i++)
     {
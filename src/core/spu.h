@@ -31,13 +31,8 @@ public:
   // Render statistics debug window.
   void DrawDebugStateWindow();
 
-  // External input from CD controller.
-  void AddCDAudioSample(s16 left, s16 right)
-  {
-    m_cd_audio_buffer.Push(left);
-    m_cd_audio_buffer.Push(right);
-  }
-  void EnsureCDAudioSpace(u32 num_samples);
+  // External input from CD controller. Frames are interleaved left/right samples.
+  void AddCDAudioFrames(const s16* frames, u32 num_frames);
 
   // Executes the SPU, generating any pending samples.
   void GeneratePendingSamples();
@@ -57,6 +52,28 @@ private:
   static constexpr u32 CD_AUDIO_SAMPLE_BUFFER_SIZE = 44100 * 2;
   static constexpr u32 CAPTURE_BUFFER_SIZE_PER_CHANNEL = 0x400;
 
+  // Voices are mixed in blocks of this many frames at a time, one voice after another.
+  static constexpr u32 MIX_BLOCK_FRAMES = 64;
+
+  // Decoded samples for one voice over a mix block. The pitch step is capped at 4 samples per frame, and the block
+  // which is current at the start plus the three samples preceding it are included.
+  static constexpr u32 MIX_BLOCK_MAX_ADPCM_BLOCKS =
+    2 + (MIX_BLOCK_FRAMES * 4 + NUM_SAMPLES_PER_ADPCM_BLOCK - 1) / NUM_SAMPLES_PER_ADPCM_BLOCK;
+  static constexpr u32 MIX_BLOCK_SAMPLE_BUFFER_SIZE = 3 + MIX_BLOCK_MAX_ADPCM_BLOCKS * NUM_SAMPLES_PER_ADPCM_BLOCK;
+
+  // The reverb unit runs at half the output rate, using a 39-tap FIR filter to downsample its input and the even taps
+  // of the same filter to upsample its output. Coefficient arrays are padded to a multiple of the SIMD width.
+  static constexpr u32 NUM_REVERB_REGS = 32;
+  static constexpr u32 REVERB_DOWNSAMPLE_TAPS = 39;
+  static constexpr u32 REVERB_UPSAMPLE_TAPS = 20;
+  static constexpr u32 REVERB_DOWNSAMPLE_PADDED_TAPS = 40;
+  static constexpr u32 REVERB_UPSAMPLE_PADDED_TAPS = 24;
+
+  // Decoded blocks are cached by their address, in 8-byte units like the voice addresses. Writes to SPU RAM mark those
+  // units as dirty, and the cached blocks covering them are dropped the next time they are looked up.
+  static constexpr u32 ADPCM_CACHE_SIZE = 1024;
+  static constexpr u32 NUM_RAM_DIRTY_UNITS = RAM_SIZE >> VOICE_ADDRESS_SHIFT;
+
   enum class RAMTransferMode : u8
   {
     Stopped = 0,
@@ -214,6 +231,32 @@ private:
     Release = 4
   };
 
+  // Registers at 0x1F801DC0-0x1F801DFF, in order. Addresses are in units of 8 bytes.
+  union ReverbRegisters
+  {
+    u16 rev[NUM_REVERB_REGS];
+
+    struct
+    {
+      u16 apf_offset[2];                          // dAPF1, dAPF2
+      s16 reflection_volume1;                     // vIIR
+      s16 comb_volume[4];                         // vCOMB1-4
+      s16 reflection_volume2;                     // vWALL
+      s16 apf_volume[2];                          // vAPF1, vAPF2
+      u16 same_side_reflection_address1[2];       // mLSAME, mRSAME
+      u16 comb_address1[2];                       // mLCOMB1, mRCOMB1
+      u16 comb_address2[2];                       // mLCOMB2, mRCOMB2
+      u16 same_side_reflection_address2[2];       // dLSAME, dRSAME
+      u16 different_side_reflection_address1[2];  // mLDIFF, mRDIFF
+      u16 comb_address3[2];                       // mLCOMB3, mRCOMB3
+      u16 comb_address4[2];                       // mLCOMB4, mRCOMB4
+      u16 different_side_reflection_address2[2];  // dLDIFF, dRDIFF
+      u16 apf_address1[2];                        // mLAPF1, mRAPF1
+      u16 apf_address2[2];                        // mLAPF2, mRAPF2
+      s16 input_volume[2];                        // vLIN, vRIN
+    };
+  };
+
   struct ADSRTarget
   {
     s32 level;
@@ -223,6 +266,17 @@ private:
     bool exponential;
   };
 
+  struct ADPCMCacheEntry
+  {
+    std::array<s16, NUM_SAMPLES_PER_ADPCM_BLOCK> samples;
+    std::array<s32, 2> last_samples_in;
+    std::array<s32, 2> last_samples_out;
+    u16 address;
+    u8 filter;
+    ADPCMFlags flags;
+    bool valid;
+  };
+
   struct Voice
   {
     u16 current_address;
@@ -247,6 +301,7 @@ private:
     void KeyOff();
 
     void DecodeBlock(const ADPCMBlock& block);
+    void LoadCachedBlock(const ADPCMCacheEntry& entry);
     s16 SampleBlock(s32 index) const;
     s16 Interpolate() const;
 
@@ -283,9 +338,64 @@ private:
   void IncrementCaptureBufferPosition();
 
   void ReadADPCMBlock(u16 address, ADPCMBlock* block);
-  std::tuple<s32, s32> SampleVoice(u32 voice_index);
+  void DecodeVoiceBlock(u32 voice_index);
+
+  /// Marks a range of SPU RAM as written, so any cached blocks decoded from it are dropped.
+  void MarkRAMDirty(u32 ram_address, u32 size);
+
+  /// Drops the cached blocks covering the 8-byte unit at address if it has been written since they were decoded.
+  void CleanRAMDirtyUnit(u16 address);
+
+  void InvalidateADPCMCache();
+  u16 GetVoicePitchStep(u32 voice_index, s32 modulator_amplitude) const;
+  void AdvanceVoice(u32 voice_index, u16 step);
+  /// Generates one frame for a voice. modulator_amplitude is the previous voice's output for the frame.
+  std::tuple<s32, s32> SampleVoice(u32 voice_index, s32 modulator_amplitude);
+
+  /// Generates a block of samples for one voice, accumulating them into the mix. modulator_amplitudes holds the
+  /// previous voice's output for the block when pitch modulation is enabled.
+  void SampleVoiceBlock(u32 voice_index, u32 num_frames, const s32* modulator_amplitudes, s32* amplitudes,
+                        s32* left_sum, s32* right_sum, s32* reverb_left_sum, s32* reverb_right_sum);
+
+  /// Applies gaussian interpolation and the ADSR volume to a block of samples.
+  static void InterpolateVoiceSamples(const s16* samples, const u16* positions, const u8* interpolation_indices,
+                                      const s16* adsr_volumes, u32 count, s32* amplitudes);
+
+  /// Converts a reverb register address/offset relative to the current reverb address to a RAM address, wrapping
+  /// around within the work area.
+  u32 ReverbMemoryAddress(u32 address, s32 byte_offset) const;
+  s16 ReverbRead(u16 address, s32 byte_offset = 0) const;
+  void ReverbWrite(u16 address, s32 value);
+
+  /// Filters are applied to the oldest sample first, with the coefficients padded to the SIMD width.
+  static s32 ReverbFIR(const s16* samples, const s16* coefficients, u32 num_padded_taps);
+
+  /// Runs the reflection, comb and all-pass stages for one 22.05KHz step.
+  void ReverbStep(const s32 input[2], s32 output[2]);
+
+  /// Processes a block of reverb input at the output rate, producing the reverb output with volume applied.
+  void ProcessReverb(const s32* left_in, const s32* right_in, u32 num_frames, s32* left_out, s32* right_out);
+
+  /// Returns true if the voices can be mixed a block at a time, rather than one frame at a time.
+  bool CanMixVoicesInBlocks() const;
+  void GenerateFrames(s16* output_frames, u32 num_frames);
   void Execute(TickCount ticks);
   void UpdateEventInterval();
+  void EnsureCDAudioSpace(u32 remaining_frames);
+
+  /// Schedules the sample event for when the IRQ address could next be hit, or the audio stream's buffers would fill.
+  void ScheduleSampleEvent();
+
+  /// Returns the number of frames which need to be generated for the IRQ to be raised on the last one, or max_frames
+  /// if the IRQ address won't be reached before then.
+  u32 GetFramesUntilIRQ(u32 max_frames) const;
+
+  /// Returns the number of frames until the voice decodes a block covering the IRQ address, including the frame it
+  /// happens on, or max_frames + 1 if it doesn't within max_frames.
+  u32 GetVoiceFramesUntilIRQ(u32 voice_index, u32 max_frames) const;
+
+  /// Predicts the IRQ again after a write which could have brought it forward.
+  void InvalidateIRQPrediction();
 
   System* m_system = nullptr;
   DMA* m_dma = nullptr;
@@ -317,8 +427,29 @@ private:
 
   TickCount m_ticks_carry = 0;
 
+  ReverbRegisters m_reverb_registers{};
+  s16 m_reverb_output_volume_left = 0;
+  s16 m_reverb_output_volume_right = 0;
+  u16 m_reverb_base_address = 0;
+  u32 m_reverb_current_address = 0;
+
+  // Filter history from the previous block, and which half of the 22.05KHz step the next frame is.
+  std::array<std::array<s16, REVERB_DOWNSAMPLE_TAPS - 1>, 2> m_reverb_downsample_history{};
+  std::array<std::array<s16, REVERB_UPSAMPLE_TAPS - 1>, 2> m_reverb_upsample_history{};
+  bool m_reverb_resample_phase = false;
+
+  // Host time spent in the reverb unit, for the debug window.
+  u64 m_reverb_time = 0;
+  u32 m_reverb_time_frames = 0;
+  double m_reverb_time_per_frame = 0.0;
+
   std::array<Voice, NUM_VOICES> m_voices{};
   std::array<u8, RAM_SIZE> m_ram{};
 
+  std::array<ADPCMCacheEntry, ADPCM_CACHE_SIZE> m_adpcm_cache{};
+  std::array<u64, NUM_RAM_DIRTY_UNITS / 64> m_ram_dirty_bitmap{};
+  u64 m_adpcm_cache_hits = 0;
+  u64 m_adpcm_cache_misses = 0;
+
   InlineFIFOQueue<s16, CD_AUDIO_SAMPLE_BUFFER_SIZE> m_cd_audio_buffer;
 };
\ No newline at end of file
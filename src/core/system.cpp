@@ -88,6 +88,11 @@ void System::UpdateGPUSettings()
   m_gpu->UpdateSettings();
 }
 
+void System::UpdateMDECSettings()
+{
+  m_mdec->UpdateSettings();
+}
+
 bool System::Boot(const char* filename)
 {
   // Load CD image up and detect region.
@@ -107,7 +112,7 @@ bool System::Boot(const char* filename)
     else
     {
       Log_InfoPrintf("Loading CD image '%s'...", filename);
-      media = CDImage::Open(filename);
+      media = OpenCDImage(filename);
       if (!media)
       {
         m_host_interface->ReportFormattedError("Failed to load CD image '%s'", filename);
@@ -271,7 +276,7 @@ bool System::DoState(StateWrapper& sw)
     std::unique_ptr<CDImage> media;
     if (!media_filename.empty())
     {
-      media = CDImage::Open(media_filename.c_str());
+      media = OpenCDImage(media_filename.c_str());
       if (!media)
         Log_ErrorPrintf("Failed to open CD image from save state: '%s'", media_filename.c_str());
     }
@@ -523,7 +528,7 @@ bool System::HasMedia() const
 
 bool System::InsertMedia(const char* path)
 {
-  std::unique_ptr<CDImage> image = CDImage::Open(path);
+  std::unique_ptr<CDImage> image = OpenCDImage(path);
   if (!image)
     return false;
 
@@ -733,6 +738,26 @@ TimingEvent* System::FindActiveEvent(const char* name)
   return (iter != m_events.end()) ? *iter : nullptr;
 }
 
+std::unique_ptr<CDImage> System::OpenCDImage(const char* path)
+{
+  const Settings& settings = GetSettings();
+  CDImage::OpenOptions options;
+  options.chd_cache_hunk_count = settings.cdrom_chd_cache_hunks;
+  options.chd_decompression_thread_count = settings.cdrom_chd_decompression_threads;
+
+  std::unique_ptr<CDImage> image = CDImage::Open(path, options);
+  if (!image)
+    return image;
+
+  // Reading ahead is pointless when the whole image is in memory.
+  if (settings.cdrom_load_image_to_ram)
+    image = CDImage::CreatePreloadImage(std::move(image), settings.cdrom_load_image_compressed);
+  else if (settings.cdrom_read_thread)
+    image = CDImage::CreatePrefetchImage(std::move(image));
+
+  return image;
+}
+
 void System::UpdateRunningGame(const char* path, CDImage* image)
 {
   m_running_game_path.clear();
@@ -754,13 +779,16 @@ void System::UpdateRunningGame(const char* path, CDImage* image)
       if (image)
         m_running_game_code = GameList::GetGameCodeForImage(image);
 
-      const GameListDatabaseEntry* db_entry =
-        (!m_running_game_code.empty()) ? m_host_interface->GetGameList()->GetDatabaseEntryForCode(m_running_game_code) :
-                                         nullptr;
-      if (db_entry)
-        m_running_game_title = db_entry->title;
+      GameListDatabaseEntry db_entry;
+      if (!m_running_game_code.empty() &&
+          m_host_interface->GetGameList()->GetDatabaseEntryForCode(m_running_game_code, &db_entry))
+      {
+        m_running_game_title = db_entry.title;
+      }
       else
+      {
         m_running_game_title = GameList::GetTitleForPath(path);
+      }
     }
   }
 
@@ -79,6 +79,7 @@ public:
 
   /// Updates GPU settings, without recreating the renderer.
   void UpdateGPUSettings();
+  void UpdateMDECSettings();
 
   void RunFrame();
 
@@ -139,6 +140,9 @@ private:
       callback(ev);
   }
 
+  // Opens a disc image, wrapping it for reading ahead if enabled.
+  std::unique_ptr<CDImage> OpenCDImage(const char* path);
+
   void UpdateRunningGame(const char* path, CDImage* image);
 
   HostInterface* m_host_interface;
@@ -0,0 +1,57 @@
+#include "vram_tile_map.h"
+#include <algorithm>
+
+Common::Rectangle<u32> VRAMTileMap::GetTransferBounds(u32 x, u32 y, u32 width, u32 height)
+{
+  Common::Rectangle<u32> out_rc = Common::Rectangle<u32>::FromExtents(x, y, width, height);
+  if (out_rc.right > VRAM_WIDTH)
+  {
+    out_rc.left = 0;
+    out_rc.right = VRAM_WIDTH;
+  }
+  if (out_rc.bottom > VRAM_HEIGHT)
+  {
+    out_rc.top = 0;
+    out_rc.bottom = VRAM_HEIGHT;
+  }
+  return out_rc;
+}
+
+void VRAMTileMap::Set(Common::Rectangle<u32> rc)
+{
+  if (!ClampToVRAM(rc))
+    return;
+
+  const RowMask column_mask = GetColumnMask(rc);
+  for (u32 row = rc.top / TILE_HEIGHT; row <= (rc.bottom - 1) / TILE_HEIGHT; row++)
+    m_rows[row] |= column_mask;
+}
+
+bool VRAMTileMap::Intersects(Common::Rectangle<u32> rc) const
+{
+  if (!ClampToVRAM(rc))
+    return false;
+
+  const RowMask column_mask = GetColumnMask(rc);
+  for (u32 row = rc.top / TILE_HEIGHT; row <= (rc.bottom - 1) / TILE_HEIGHT; row++)
+  {
+    if (m_rows[row] & column_mask)
+      return true;
+  }
+
+  return false;
+}
+
+bool VRAMTileMap::ClampToVRAM(Common::Rectangle<u32>& rc)
+{
+  rc.right = std::min<u32>(rc.right, VRAM_WIDTH);
+  rc.bottom = std::min<u32>(rc.bottom, VRAM_HEIGHT);
+  return (rc.left < rc.right && rc.top < rc.bottom);
+}
+
+VRAMTileMap::RowMask VRAMTileMap::GetColumnMask(const Common::Rectangle<u32>& rc)
+{
+  const u32 first_col = rc.left / TILE_WIDTH;
+  const u32 last_col = (rc.right - 1) / TILE_WIDTH;
+  return static_cast<RowMask>(((2u << last_col) - 1) & ~((1u << first_col) - 1));
+}
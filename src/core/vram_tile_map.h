@@ -0,0 +1,91 @@
+#pragma once
+#include "common/rectangle.h"
+#include "types.h"
+#include <array>
+
+/// Tracks which parts of VRAM have been modified, at the granularity of 64x32 tiles.
+class VRAMTileMap
+{
+public:
+  enum : u32
+  {
+    VRAM_WIDTH = 1024,
+    VRAM_HEIGHT = 512,
+    TILE_WIDTH = 64,
+    TILE_HEIGHT = 32,
+    NUM_TILES_X = VRAM_WIDTH / TILE_WIDTH,
+    NUM_TILES_Y = VRAM_HEIGHT / TILE_HEIGHT
+  };
+
+  /// Computes the area affected by a VRAM transfer. A transfer which wraps around an edge of VRAM covers the whole
+  /// width or height respectively.
+  static Common::Rectangle<u32> GetTransferBounds(u32 x, u32 y, u32 width, u32 height);
+
+  void SetAll() { m_rows.fill(ALL_COLUMNS_MASK); }
+  void ClearAll() { m_rows.fill(0); }
+
+  /// Marks all tiles overlapping the rectangle. Right/bottom are exclusive, and the rectangle is clamped to VRAM.
+  void Set(Common::Rectangle<u32> rc);
+
+  /// Returns true if any tile overlapping the rectangle is marked.
+  bool Intersects(Common::Rectangle<u32> rc) const;
+
+  /// Unmarks all tiles overlapping the rectangle, calling the callback with each tile-aligned area which was marked.
+  /// Runs of adjacent tiles are merged into a single area, so the callback is invoked as few times as possible.
+  template<typename T>
+  void Consume(Common::Rectangle<u32> rc, const T& callback)
+  {
+    if (!ClampToVRAM(rc))
+      return;
+
+    const RowMask column_mask = GetColumnMask(rc);
+    const u32 last_row = (rc.bottom - 1) / TILE_HEIGHT;
+    for (u32 row = rc.top / TILE_HEIGHT; row <= last_row;)
+    {
+      const RowMask bits = m_rows[row] & column_mask;
+      if (bits == 0)
+      {
+        row++;
+        continue;
+      }
+
+      // rows with the same set of tiles can be copied together
+      u32 end_row = row + 1;
+      while (end_row <= last_row && (m_rows[end_row] & column_mask) == bits)
+        end_row++;
+      for (u32 i = row; i < end_row; i++)
+        m_rows[i] &= ~bits;
+
+      for (u32 start_col = 0; start_col < NUM_TILES_X;)
+      {
+        if (!(bits & (1u << start_col)))
+        {
+          start_col++;
+          continue;
+        }
+
+        u32 end_col = start_col + 1;
+        while (end_col < NUM_TILES_X && (bits & (1u << end_col)))
+          end_col++;
+
+        callback(Common::Rectangle<u32>(start_col * TILE_WIDTH, row * TILE_HEIGHT, end_col * TILE_WIDTH,
+                                        end_row * TILE_HEIGHT));
+        start_col = end_col;
+      }
+
+      row = end_row;
+    }
+  }
+
+private:
+  using RowMask = u16;
+  static constexpr RowMask ALL_COLUMNS_MASK = static_cast<RowMask>((1u << NUM_TILES_X) - 1);
+  static_assert(NUM_TILES_X <= sizeof(RowMask) * 8, "row mask holds all columns");
+
+  /// Returns false if the rectangle is empty after clamping.
+  static bool ClampToVRAM(Common::Rectangle<u32>& rc);
+
+  static RowMask GetColumnMask(const Common::Rectangle<u32>& rc);
+
+  std::array<RowMask, NUM_TILES_Y> m_rows = {};
+};
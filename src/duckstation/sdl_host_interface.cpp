@@ -1003,6 +1003,17 @@ void SDLHostInterface::DrawDebugMenu()
   ImGui::MenuItem("Show VRAM", nullptr, &debug_settings.show_vram);
   ImGui::MenuItem("Dump CPU to VRAM Copies", nullptr, &debug_settings.dump_cpu_to_vram_copies);
   ImGui::MenuItem("Dump VRAM to CPU Copies", nullptr, &debug_settings.dump_vram_to_cpu_copies);
+  if (ImGui::BeginMenu("Dump GPU Commands", !m_system->GetGPU()->IsDumping()))
+  {
+    for (const u32 num_frames : {1u, 10u, 60u, 600u})
+    {
+      char buf[16];
+      std::snprintf(buf, sizeof(buf), "%u Frames", num_frames);
+      if (ImGui::MenuItem(buf))
+        StartGPUDump(num_frames);
+    }
+    ImGui::EndMenu();
+  }
   ImGui::Separator();
 
   ImGui::MenuItem("Show CDROM State", nullptr, &debug_settings.show_cdrom_state);
@@ -1160,6 +1171,16 @@ void SDLHostInterface::DrawSettingsWindow()
         }
 
         settings_changed |= ImGui::Checkbox("Pause On Start", &m_settings.start_paused);
+
+        settings_changed |= ImGui::Checkbox("Read Ahead From Disc Image On Worker Thread", &m_settings.cdrom_read_thread);
+        settings_changed |= ImGui::Checkbox("Load Disc Image Into Memory", &m_settings.cdrom_load_image_to_ram);
+
+        if (ImGui::Checkbox("Decode Movies On Worker Thread", &m_settings.mdec_use_thread))
+        {
+          settings_changed = true;
+          if (m_system)
+            m_system->UpdateMDECSettings();
+        }
       }
 
       ImGui::NewLine();
@@ -0,0 +1,146 @@
+#include "common/audio_stream.h"
+#include "common/log.h"
+#include "common/timer.h"
+#include "core/bios.h"
+#include "core/gpu.h"
+#include "core/gpu_dump.h"
+#include "core/host_display.h"
+#include "core/host_interface.h"
+#include "core/system.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+class ReplayHostInterface final : public HostInterface
+{
+public:
+  ReplayHostInterface(bool pal_mode)
+  {
+    m_display = HostDisplay::CreateNullDisplay();
+    m_audio_stream = AudioStream::CreateNullAudioStream();
+    m_audio_stream->Reconfigure(AUDIO_SAMPLE_RATE, AUDIO_CHANNELS);
+
+    m_settings.region = pal_mode ? ConsoleRegion::PAL : ConsoleRegion::NTSC_U;
+    m_settings.gpu_renderer = GPURenderer::Software;
+    m_settings.speed_limiter_enabled = false;
+    m_settings.controller_types.fill(ControllerType::None);
+    for (std::string& path : m_settings.memory_card_paths)
+      path.clear();
+  }
+
+  std::optional<std::vector<u8>> GetBIOSImage(ConsoleRegion region) override
+  {
+    // The CPU never runs, so the BIOS contents are irrelevant.
+    return std::vector<u8>(BIOS::BIOS_SIZE, 0);
+  }
+
+  GPU* CreateGPU()
+  {
+    if (!CreateSystem() || !BootSystem(nullptr, nullptr))
+      return nullptr;
+
+    return m_system->GetGPU();
+  }
+};
+
+} // namespace
+
+static void PrintUsage(const char* progname)
+{
+  std::fprintf(stderr, "Usage: %s [-loops <count>] [-verbose] <dump file>\n", progname);
+  std::fprintf(stderr, "  -loops <count>: Replays the dump this many times, reporting the fastest run.\n");
+  std::fprintf(stderr, "  -verbose: Enables informational log messages.\n");
+}
+
+static int Run(int argc, char* argv[])
+{
+  const char* filename = nullptr;
+  u32 num_loops = 1;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++)
+  {
+#define CHECK_ARG(str) !std::strcmp(argv[i], str)
+#define CHECK_ARG_PARAM(str) (!std::strcmp(argv[i], str) && ((i + 1) < argc))
+
+    if (CHECK_ARG_PARAM("-loops"))
+      num_loops = std::max<u32>(static_cast<u32>(std::strtoul(argv[++i], nullptr, 10)), 1);
+    else if (CHECK_ARG("-verbose"))
+      verbose = true;
+    else if (argv[i][0] == '-' || filename)
+    {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    else
+      filename = argv[i];
+
+#undef CHECK_ARG
+#undef CHECK_ARG_PARAM
+  }
+
+  if (!filename)
+  {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const LOGLEVEL level = verbose ? LOGLEVEL_INFO : LOGLEVEL_WARNING;
+  Log::SetConsoleOutputParams(true, nullptr, level);
+  Log::SetFilterLevel(level);
+
+  std::unique_ptr<GPUDump::Player> player = GPUDump::Player::Open(filename);
+  if (!player)
+    return EXIT_FAILURE;
+
+  ReplayHostInterface host_interface(player->IsPALMode());
+  GPU* gpu = host_interface.CreateGPU();
+  if (!gpu)
+  {
+    std::fprintf(stderr, "Failed to create GPU\n");
+    return EXIT_FAILURE;
+  }
+
+  GPUDump::Player::Statistics stats = {};
+  double best_time = 0.0;
+  for (u32 loop = 0; loop < num_loops; loop++)
+  {
+    if (!player->LoadInitialState(gpu))
+    {
+      std::fprintf(stderr, "Failed to load initial GPU state from dump\n");
+      return EXIT_FAILURE;
+    }
+
+    Common::Timer timer;
+    player->Execute(gpu, &stats);
+    const double time = timer.GetTimeSeconds();
+    if (loop == 0 || time < best_time)
+      best_time = time;
+
+    if (num_loops > 1)
+      std::printf("Loop %u: %.2f ms\n", loop + 1, time * 1000.0);
+  }
+
+  const double per_second = (best_time > 0.0) ? (1.0 / best_time) : 0.0;
+  std::printf("Frames:      %u (%.2f fps)\n", stats.num_frames, static_cast<double>(stats.num_frames) * per_second);
+  std::printf("Time:        %.2f ms\n", best_time * 1000.0);
+  std::printf("Primitives:  %" PRIu64 " (%.0f/s)\n", stats.num_primitives,
+              static_cast<double>(stats.num_primitives) * per_second);
+  std::printf("Vertices:    %" PRIu64 " (%.0f/s)\n", stats.num_vertices,
+              static_cast<double>(stats.num_vertices) * per_second);
+  std::printf("Pixels:      %" PRIu64 " (%.0f/s, estimated)\n", stats.num_pixels,
+              static_cast<double>(stats.num_pixels) * per_second);
+  std::printf("VRAM fills:  %" PRIu64 "\n", stats.num_vram_fills);
+  std::printf("VRAM writes: %" PRIu64 "\n", stats.num_vram_writes);
+  std::printf("VRAM copies: %" PRIu64 "\n", stats.num_vram_copies);
+  std::printf("VRAM reads:  %" PRIu64 "\n", stats.num_vram_reads);
+  std::printf("VRAM hash:   %s\n", GPUDump::Player::GetVRAMHash(gpu).c_str());
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  return Run(argc, argv);
+}